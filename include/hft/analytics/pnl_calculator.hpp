@@ -88,6 +88,7 @@ public:
                      const std::string& strategy_id = "");
     void update_market_price(const core::Symbol& symbol, core::Price price);
     void update_market_prices(const std::unordered_map<core::Symbol, core::Price>& prices);
+    size_t update_market_prices(matching::TopOfBookSampler& sampler);
     Position get_position(const core::Symbol& symbol) const;
     std::unordered_map<core::Symbol, Position> get_all_positions() const;
     double get_net_position(const core::Symbol& symbol) const;
@@ -0,0 +1,143 @@
+#pragma once
+#include "hft/backtesting/tick_replay.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+namespace hft {
+namespace backtesting {
+constexpr size_t COLUMNAR_SYMBOL_LENGTH = 16;
+constexpr size_t COLUMNAR_MAX_SYMBOLS = 65536;
+struct ColumnarFileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t block_capacity;
+    uint64_t tick_count;
+    uint64_t block_count;
+    uint64_t block_size;
+    uint64_t index_offset;
+    uint64_t symbols_offset;
+    uint32_t symbol_count;
+    uint32_t time_ordered;
+    uint64_t start_time_ns;
+    uint64_t end_time_ns;
+    uint64_t reserved[2];
+};
+struct ColumnarBlockIndexEntry {
+    uint64_t min_timestamp_ns;
+    uint64_t max_timestamp_ns;
+    uint64_t offset;
+    uint32_t tick_count;
+    uint32_t reserved;
+};
+struct ColumnarTickBlock {
+    size_t count = 0;
+    uint64_t min_timestamp_ns = 0;
+    uint64_t max_timestamp_ns = 0;
+    const uint64_t* timestamp_ns = nullptr;
+    const double* bid_price = nullptr;
+    const double* ask_price = nullptr;
+    const double* last_price = nullptr;
+    const uint64_t* bid_size = nullptr;
+    const uint64_t* ask_size = nullptr;
+    const uint64_t* last_size = nullptr;
+    const uint64_t* sequence_number = nullptr;
+    const uint16_t* symbol_id = nullptr;
+};
+struct ColumnarTickRow {
+    uint64_t timestamp_ns;
+    double bid_price;
+    double ask_price;
+    double last_price;
+    uint64_t bid_size;
+    uint64_t ask_size;
+    uint64_t last_size;
+    uint64_t sequence_number;
+    uint16_t symbol_id;
+};
+class ColumnarTickWriter {
+public:
+    static constexpr uint32_t FORMAT_VERSION = 1;
+    static constexpr size_t DEFAULT_BLOCK_CAPACITY = 4096;
+    static constexpr size_t BLOCK_ALIGNMENT = 4096;
+private:
+    std::ofstream file_;
+    std::string path_;
+    ColumnarFileHeader header_;
+    std::vector<char> block_;
+    size_t block_fill_;
+    uint64_t write_offset_;
+    std::vector<ColumnarBlockIndexEntry> index_;
+    std::vector<std::string> symbols_;
+    std::unordered_map<std::string, uint16_t> symbol_ids_;
+    uint64_t last_timestamp_ns_;
+public:
+    ColumnarTickWriter();
+    ~ColumnarTickWriter();
+    ColumnarTickWriter(const ColumnarTickWriter&) = delete;
+    ColumnarTickWriter& operator=(const ColumnarTickWriter&) = delete;
+    bool open(const std::string& path, size_t block_capacity = DEFAULT_BLOCK_CAPACITY);
+    bool is_open() const { return file_.is_open(); }
+    bool intern_symbol(std::string_view symbol, uint16_t& symbol_id);
+    bool append(const ColumnarTickRow& row);
+    bool append(const HistoricalTick& tick);
+    bool close();
+    uint64_t tick_count() const { return header_.tick_count; }
+    static size_t block_size(size_t block_capacity);
+private:
+    bool flush_block();
+};
+class ColumnarTickReader {
+private:
+    int fd_;
+    const char* mapping_;
+    size_t mapping_size_;
+    const ColumnarFileHeader* header_;
+    const ColumnarBlockIndexEntry* index_;
+    std::vector<std::string> symbols_;
+public:
+    ColumnarTickReader();
+    ~ColumnarTickReader();
+    ColumnarTickReader(const ColumnarTickReader&) = delete;
+    ColumnarTickReader& operator=(const ColumnarTickReader&) = delete;
+    bool open(const std::string& path);
+    void close();
+    bool is_open() const { return mapping_ != nullptr; }
+    size_t block_count() const { return header_ ? header_->block_count : 0; }
+    uint64_t tick_count() const { return header_ ? header_->tick_count : 0; }
+    bool is_time_ordered() const { return header_ && header_->time_ordered != 0; }
+    uint64_t start_time_ns() const { return header_ ? header_->start_time_ns : 0; }
+    uint64_t end_time_ns() const { return header_ ? header_->end_time_ns : 0; }
+    const std::vector<std::string>& symbols() const { return symbols_; }
+    ColumnarTickBlock block(size_t index) const;
+    size_t find_block(uint64_t timestamp_ns) const;
+    void prefetch_block(size_t index) const;
+};
+class ColumnarMarketDataParser : public MarketDataParser {
+private:
+    ColumnarTickReader reader_;
+    std::vector<core::Symbol> symbols_;
+    ColumnarTickBlock block_;
+    size_t next_block_;
+    size_t position_;
+public:
+    ColumnarMarketDataParser();
+    bool open(const std::string& filename) override;
+    bool read_next_tick(HistoricalTick& tick) override;
+    bool read_next_snapshot(HistoricalOrderBookSnapshot& snapshot) override;
+    void close() override;
+    bool has_more_data() const override;
+    size_t get_total_records() const override;
+    bool seek(core::TimePoint time) override;
+    bool is_time_ordered() const override { return reader_.is_time_ordered(); }
+    const ColumnarTickReader& reader() const { return reader_; }
+    static bool convert(MarketDataParser& source, const std::string& columnar_file,
+                        size_t block_capacity = ColumnarTickWriter::DEFAULT_BLOCK_CAPACITY);
+private:
+    bool load_block(size_t index);
+};
+}
+}
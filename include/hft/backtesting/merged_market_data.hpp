@@ -0,0 +1,96 @@
+#pragma once
+#include "hft/backtesting/tick_replay.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+namespace hft {
+namespace backtesting {
+struct MergedReplayConfig {
+    size_t read_ahead_ticks = 1024;
+    size_t io_threads = 2;
+};
+struct MergedReplayStats {
+    std::atomic<uint64_t> blocks_loaded{0};
+    std::atomic<uint64_t> ticks_loaded{0};
+    std::atomic<uint64_t> replay_waits{0};
+    std::atomic<uint64_t> streams_exhausted{0};
+    void reset() {
+        blocks_loaded = 0;
+        ticks_loaded = 0;
+        replay_waits = 0;
+        streams_exhausted = 0;
+    }
+};
+class MergedMarketDataParser : public MarketDataParser {
+public:
+    static constexpr size_t HEAP_ARITY = 4;
+private:
+    struct Stream {
+        uint32_t index = 0;
+        std::unique_ptr<MarketDataParser> parser;
+        std::vector<HistoricalTick> front;
+        std::vector<HistoricalTick> back;
+        size_t front_count = 0;
+        size_t back_count = 0;
+        size_t position = 0;
+        bool back_final = false;
+        bool draining = false;
+        std::atomic<bool> back_ready{false};
+    };
+    struct HeapEntry {
+        int64_t timestamp_ns;
+        uint32_t stream;
+    };
+    MergedReplayConfig config_;
+    std::vector<std::unique_ptr<Stream>> streams_;
+    std::vector<HeapEntry> heap_;
+    std::vector<std::thread> io_threads_;
+    std::deque<uint32_t> fill_requests_;
+    std::mutex mutex_;
+    std::condition_variable fill_cv_;
+    std::condition_variable ready_cv_;
+    bool stopping_;
+    bool primed_;
+    size_t total_records_;
+    MergedReplayStats stats_;
+public:
+    explicit MergedMarketDataParser(const MergedReplayConfig& config = {});
+    ~MergedMarketDataParser() override;
+    MergedMarketDataParser(const MergedMarketDataParser&) = delete;
+    MergedMarketDataParser& operator=(const MergedMarketDataParser&) = delete;
+    bool open(const std::string& path) override;
+    bool add_source(std::unique_ptr<MarketDataParser> parser);
+    bool read_next_tick(HistoricalTick& tick) override;
+    bool read_next_snapshot(HistoricalOrderBookSnapshot& snapshot) override;
+    void close() override;
+    bool has_more_data() const override;
+    size_t get_total_records() const override { return total_records_; }
+    bool seek(core::TimePoint time) override;
+    bool is_time_ordered() const override;
+    size_t stream_count() const { return streams_.size(); }
+    const MergedReplayStats& get_stats() const { return stats_; }
+private:
+    bool prime();
+    void stop_io_threads();
+    void io_loop();
+    void fill_back(Stream& stream);
+    void request_fill(uint32_t index);
+    bool advance_block(Stream& stream);
+    void sift_down(size_t index);
+    void sift_up(size_t index);
+    static bool before(const HeapEntry& a, const HeapEntry& b) {
+        return a.timestamp_ns != b.timestamp_ns ? a.timestamp_ns < b.timestamp_ns : a.stream < b.stream;
+    }
+    static int64_t timestamp_ns(const HistoricalTick& tick) {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(tick.timestamp.time_since_epoch()).count();
+    }
+};
+}
+}
@@ -4,6 +4,7 @@
 #include "hft/matching/matching_engine.hpp"
 #include "hft/analytics/pnl_calculator.hpp"
 #include <string>
+#include <string_view>
 #include <vector>
 #include <memory>
 #include <fstream>
@@ -63,11 +64,23 @@ public:
     virtual void close() = 0;
     virtual bool has_more_data() const = 0;
     virtual size_t get_total_records() const = 0;
+    virtual bool seek(core::TimePoint) { return false; }
+    virtual bool is_time_ordered() const { return false; }
 };
 class CSVMarketDataParser : public MarketDataParser {
+public:
+    static constexpr size_t MAX_CSV_COLUMNS = 32;
 private:
-    std::ifstream file_;
-    std::string current_line_;
+    int fd_;
+    const char* data_;
+    size_t size_;
+    size_t end_offset_;
+    size_t offset_;
+    size_t block_offset_;
+    uint64_t block_separators_;
+    uint64_t block_newlines_;
+    std::string_view fields_[MAX_CSV_COLUMNS];
+    size_t required_columns_;
     size_t line_number_;
     core::Symbol default_symbol_;
     struct CSVFormat {
@@ -86,22 +99,24 @@ private:
     CSVFormat format_;
 public:
     explicit CSVMarketDataParser(const core::Symbol& default_symbol = "");
+    ~CSVMarketDataParser() override;
+    CSVMarketDataParser(const CSVMarketDataParser&) = delete;
+    CSVMarketDataParser& operator=(const CSVMarketDataParser&) = delete;
     void set_csv_format(const CSVFormat& format) { format_ = format; }
     bool open(const std::string& filename) override;
+    bool open_range(const std::string& filename, size_t begin_offset, size_t end_offset);
     bool read_next_tick(HistoricalTick& tick) override;
     bool read_next_snapshot(HistoricalOrderBookSnapshot& snapshot) override;
     void close() override;
     bool has_more_data() const override;
     size_t get_total_records() const override;
 private:
-    std::vector<std::string> parse_csv_line(const std::string& line);
-    core::TimePoint parse_timestamp(const std::string& timestamp_str);
+    void scan_block_at(size_t block_offset);
+    size_t split_next_line();
+    core::TimePoint parse_timestamp(std::string_view timestamp_str);
 };
 class BinaryMarketDataParser : public MarketDataParser {
-private:
-    std::ifstream file_;
-    size_t file_size_;
-    size_t current_position_;
+public:
     struct BinaryHeader {
         char magic[4] = {'H', 'F', 'T', 'D'};
         uint32_t version = 1;
@@ -111,6 +126,16 @@ private:
         char symbol[16];
         uint32_t record_size;
     };
+    struct BinaryTick {
+        uint64_t timestamp_ns;
+        double bid_price, ask_price, last_price;
+        uint64_t bid_size, ask_size, last_size;
+        uint64_t sequence_number;
+    };
+private:
+    std::ifstream file_;
+    size_t file_size_;
+    size_t current_position_;
     BinaryHeader header_;
 public:
     bool open(const std::string& filename) override;
@@ -121,6 +146,7 @@ public:
     size_t get_total_records() const override;
     static bool convert_csv_to_binary(const std::string& csv_file, const std::string& binary_file);
 };
+std::unique_ptr<MarketDataParser> create_market_data_parser(const std::string& path);
 class BacktestingStrategy {
 public:
     virtual ~BacktestingStrategy() = default;
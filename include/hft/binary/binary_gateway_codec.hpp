@@ -0,0 +1,68 @@
+#pragma once
+#include "hft/binary/binary_order_entry.hpp"
+#include "hft/fix/fix_gateway.hpp"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+namespace hft {
+namespace binary {
+struct BinaryGatewayStats {
+    std::atomic<uint64_t> messages_received{0};
+    std::atomic<uint64_t> messages_rejected{0};
+    std::atomic<uint64_t> partial_frames_buffered{0};
+    std::atomic<uint64_t> invalid_frames{0};
+    void reset() {
+        messages_received = 0;
+        messages_rejected = 0;
+        partial_frames_buffered = 0;
+        invalid_frames = 0;
+    }
+};
+class BinaryGatewayCodec : public fix::GatewayCodec {
+private:
+    class RejectCounter : public BinaryOrderHandler {
+    private:
+        BinaryOrderHandler& handler_;
+        BinaryGatewayStats& stats_;
+    public:
+        RejectCounter(BinaryOrderHandler& handler, BinaryGatewayStats& stats) : handler_(handler), stats_(stats) {}
+        void on_new_order(BinarySessionId session_id, const BinaryNewOrder& order) override {
+            handler_.on_new_order(session_id, order);
+        }
+        void on_cancel(BinarySessionId session_id, const BinaryCancel& cancel) override {
+            handler_.on_cancel(session_id, cancel);
+        }
+        void on_replace(BinarySessionId session_id, const BinaryReplace& replace) override {
+            handler_.on_replace(session_id, replace);
+        }
+        void on_reject(BinarySessionId session_id, const BinaryFrame& frame, BinaryDecodeStatus status) override {
+            stats_.messages_rejected.fetch_add(1, std::memory_order_relaxed);
+            handler_.on_reject(session_id, frame, status);
+        }
+        void on_session_closed(BinarySessionId session_id) override {
+            handler_.on_session_closed(session_id);
+        }
+    };
+    struct Connection {
+        bool open = false;
+        std::string pending;
+    };
+    RejectCounter handler_;
+    std::unique_ptr<Connection[]> connections_;
+    std::mutex connections_mutex_;
+    BinaryGatewayStats stats_;
+public:
+    explicit BinaryGatewayCodec(BinaryOrderHandler& handler);
+    BinaryGatewayCodec(const BinaryGatewayCodec&) = delete;
+    BinaryGatewayCodec& operator=(const BinaryGatewayCodec&) = delete;
+    bool ready() const override { return true; }
+    fix::FixConnectionId open_connection() override;
+    bool on_data(fix::FixConnectionId connection_id, const char* data, size_t length) override;
+    void close_connection(fix::FixConnectionId connection_id) override;
+    const BinaryGatewayStats& get_stats() const { return stats_; }
+    void reset_stats() { stats_.reset(); }
+};
+}
+}
@@ -0,0 +1,279 @@
+#pragma once
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <type_traits>
+namespace hft {
+namespace binary {
+static_assert(std::endian::native == std::endian::little, "binary order entry is little-endian on the wire");
+constexpr uint16_t BINARY_ENCODING_TYPE = 0xEB50;
+constexpr uint16_t BINARY_SCHEMA_ID = 0x4846;
+constexpr uint16_t BINARY_SCHEMA_VERSION = 1;
+constexpr int BINARY_PRICE_EXPONENT = -8;
+constexpr double BINARY_PRICE_SCALE = 1e8;
+constexpr size_t BINARY_SYMBOL_LENGTH = 8;
+constexpr size_t BINARY_MAX_MESSAGE_SIZE = 4096;
+enum class BinaryTemplateId : uint16_t {
+    NEW_ORDER = 1,
+    CANCEL = 2,
+    REPLACE = 3,
+    EXECUTION_REPORT = 4
+};
+struct BinaryFrameHeader {
+    uint32_t message_length;
+    uint16_t encoding_type;
+    uint16_t reserved;
+};
+struct BinaryMessageHeader {
+    uint16_t block_length;
+    uint16_t template_id;
+    uint16_t schema_id;
+    uint16_t version;
+};
+constexpr size_t BINARY_HEADER_SIZE = sizeof(BinaryFrameHeader) + sizeof(BinaryMessageHeader);
+struct BinaryNewOrder {
+    uint64_t cl_ord_id;
+    int64_t price;
+    uint64_t order_qty;
+    char symbol[BINARY_SYMBOL_LENGTH];
+    char side;
+    char ord_type;
+    char time_in_force;
+    uint8_t padding[5];
+};
+struct BinaryCancel {
+    uint64_t orig_cl_ord_id;
+    uint64_t cl_ord_id;
+    uint64_t order_id;
+    char symbol[BINARY_SYMBOL_LENGTH];
+    char side;
+    uint8_t padding[7];
+};
+struct BinaryReplace {
+    uint64_t orig_cl_ord_id;
+    uint64_t cl_ord_id;
+    uint64_t order_id;
+    int64_t price;
+    uint64_t order_qty;
+    char symbol[BINARY_SYMBOL_LENGTH];
+    char side;
+    char ord_type;
+    char time_in_force;
+    uint8_t padding[5];
+};
+struct BinaryExecutionReport {
+    uint64_t order_id;
+    uint64_t cl_ord_id;
+    uint64_t exec_id;
+    uint64_t transact_time;
+    int64_t price;
+    uint64_t order_qty;
+    int64_t last_px;
+    uint64_t last_qty;
+    uint64_t leaves_qty;
+    uint64_t cum_qty;
+    int64_t avg_px;
+    char symbol[BINARY_SYMBOL_LENGTH];
+    char exec_type;
+    char ord_status;
+    char side;
+    uint8_t padding[5];
+};
+template<typename Message>
+struct BinaryMessageTraits;
+template<>
+struct BinaryMessageTraits<BinaryNewOrder> {
+    static constexpr BinaryTemplateId TEMPLATE_ID = BinaryTemplateId::NEW_ORDER;
+};
+template<>
+struct BinaryMessageTraits<BinaryCancel> {
+    static constexpr BinaryTemplateId TEMPLATE_ID = BinaryTemplateId::CANCEL;
+};
+template<>
+struct BinaryMessageTraits<BinaryReplace> {
+    static constexpr BinaryTemplateId TEMPLATE_ID = BinaryTemplateId::REPLACE;
+};
+template<>
+struct BinaryMessageTraits<BinaryExecutionReport> {
+    static constexpr BinaryTemplateId TEMPLATE_ID = BinaryTemplateId::EXECUTION_REPORT;
+};
+static_assert(sizeof(BinaryFrameHeader) == 8 && sizeof(BinaryMessageHeader) == 8, "unexpected header layout");
+static_assert(sizeof(BinaryNewOrder) == 40 && sizeof(BinaryCancel) == 40, "unexpected block layout");
+static_assert(sizeof(BinaryReplace) == 56 && sizeof(BinaryExecutionReport) == 104, "unexpected block layout");
+enum class BinaryFrameStatus : uint8_t {
+    COMPLETE,
+    INCOMPLETE,
+    INVALID
+};
+enum class BinaryDecodeStatus : uint8_t {
+    OK,
+    WRONG_TEMPLATE,
+    UNKNOWN_SCHEMA,
+    SHORT_BLOCK
+};
+struct BinaryFrame {
+    BinaryFrameStatus status;
+    size_t length;
+    BinaryMessageHeader header;
+    const char* block;
+    BinaryTemplateId template_id() const { return static_cast<BinaryTemplateId>(header.template_id); }
+};
+inline int64_t to_binary_price(double price) {
+    return std::llround(price * BINARY_PRICE_SCALE);
+}
+inline double from_binary_price(int64_t price) {
+    return static_cast<double>(price) / BINARY_PRICE_SCALE;
+}
+inline bool set_binary_symbol(char (&out)[BINARY_SYMBOL_LENGTH], std::string_view symbol) {
+    if (symbol.empty() || symbol.size() > BINARY_SYMBOL_LENGTH) {
+        return false;
+    }
+    std::memset(out, 0, BINARY_SYMBOL_LENGTH);
+    std::memcpy(out, symbol.data(), symbol.size());
+    return true;
+}
+inline std::string_view binary_symbol(const char (&symbol)[BINARY_SYMBOL_LENGTH]) {
+    const void* end = std::memchr(symbol, 0, BINARY_SYMBOL_LENGTH);
+    return std::string_view(symbol, end ? static_cast<const char*>(end) - symbol : BINARY_SYMBOL_LENGTH);
+}
+inline BinaryFrame frame_binary_message(const char* data, size_t length) {
+    BinaryFrame frame{BinaryFrameStatus::INCOMPLETE, 0, {}, nullptr};
+    if (length < BINARY_HEADER_SIZE) {
+        return frame;
+    }
+    BinaryFrameHeader frame_header;
+    std::memcpy(&frame_header, data, sizeof(frame_header));
+    std::memcpy(&frame.header, data + sizeof(frame_header), sizeof(frame.header));
+    if (frame_header.encoding_type != BINARY_ENCODING_TYPE || frame_header.message_length < BINARY_HEADER_SIZE ||
+        frame_header.message_length > BINARY_MAX_MESSAGE_SIZE ||
+        frame.header.block_length > frame_header.message_length - BINARY_HEADER_SIZE) {
+        frame.status = BinaryFrameStatus::INVALID;
+        return frame;
+    }
+    if (length < frame_header.message_length) {
+        return frame;
+    }
+    frame.status = BinaryFrameStatus::COMPLETE;
+    frame.length = frame_header.message_length;
+    frame.block = data + BINARY_HEADER_SIZE;
+    return frame;
+}
+template<typename Message>
+BinaryDecodeStatus decode_binary_message(const BinaryFrame& frame, const Message*& message, Message& scratch) {
+    static_assert(std::is_trivially_copyable_v<Message>, "binary messages must be trivially copyable");
+    if (frame.header.schema_id != BINARY_SCHEMA_ID) {
+        return BinaryDecodeStatus::UNKNOWN_SCHEMA;
+    }
+    if (frame.template_id() != BinaryMessageTraits<Message>::TEMPLATE_ID) {
+        return BinaryDecodeStatus::WRONG_TEMPLATE;
+    }
+    if (frame.header.block_length < sizeof(Message)) {
+        return BinaryDecodeStatus::SHORT_BLOCK;
+    }
+    if (reinterpret_cast<uintptr_t>(frame.block) % alignof(Message) == 0) {
+        message = reinterpret_cast<const Message*>(frame.block);
+    } else {
+        std::memcpy(&scratch, frame.block, sizeof(Message));
+        message = &scratch;
+    }
+    return BinaryDecodeStatus::OK;
+}
+using BinarySessionId = uint32_t;
+class BinaryOrderHandler {
+public:
+    virtual ~BinaryOrderHandler() = default;
+    virtual void on_new_order(BinarySessionId session_id, const BinaryNewOrder& order) = 0;
+    virtual void on_cancel(BinarySessionId session_id, const BinaryCancel& cancel) = 0;
+    virtual void on_replace(BinarySessionId session_id, const BinaryReplace& replace) = 0;
+    virtual void on_reject(BinarySessionId, const BinaryFrame&, BinaryDecodeStatus) {}
+    virtual void on_session_closed(BinarySessionId) {}
+};
+struct BinaryDispatchResult {
+    size_t consumed;
+    size_t messages;
+    bool invalid;
+};
+template<typename Handler>
+BinaryFrame dispatch_binary_message(BinarySessionId session_id, const char* data, size_t length, Handler& handler) {
+    const BinaryFrame frame = frame_binary_message(data, length);
+    if (frame.status != BinaryFrameStatus::COMPLETE) {
+        return frame;
+    }
+    BinaryDecodeStatus status = BinaryDecodeStatus::WRONG_TEMPLATE;
+    switch (frame.template_id()) {
+        case BinaryTemplateId::NEW_ORDER: {
+            BinaryNewOrder scratch;
+            const BinaryNewOrder* order = nullptr;
+            status = decode_binary_message(frame, order, scratch);
+            if (status == BinaryDecodeStatus::OK) {
+                handler.on_new_order(session_id, *order);
+            }
+            break;
+        }
+        case BinaryTemplateId::CANCEL: {
+            BinaryCancel scratch;
+            const BinaryCancel* cancel = nullptr;
+            status = decode_binary_message(frame, cancel, scratch);
+            if (status == BinaryDecodeStatus::OK) {
+                handler.on_cancel(session_id, *cancel);
+            }
+            break;
+        }
+        case BinaryTemplateId::REPLACE: {
+            BinaryReplace scratch;
+            const BinaryReplace* replace = nullptr;
+            status = decode_binary_message(frame, replace, scratch);
+            if (status == BinaryDecodeStatus::OK) {
+                handler.on_replace(session_id, *replace);
+            }
+            break;
+        }
+        default:
+            break;
+    }
+    if (status != BinaryDecodeStatus::OK) {
+        handler.on_reject(session_id, frame, status);
+    }
+    return frame;
+}
+template<typename Handler>
+BinaryDispatchResult dispatch_binary_messages(BinarySessionId session_id, const char* data, size_t length,
+                                              Handler& handler) {
+    BinaryDispatchResult result{0, 0, false};
+    while (result.consumed < length) {
+        const BinaryFrame frame = dispatch_binary_message(session_id, data + result.consumed,
+                                                          length - result.consumed, handler);
+        if (frame.status != BinaryFrameStatus::COMPLETE) {
+            result.invalid = frame.status == BinaryFrameStatus::INVALID;
+            break;
+        }
+        result.consumed += frame.length;
+        ++result.messages;
+    }
+    return result;
+}
+template<typename Message>
+constexpr size_t binary_message_size() {
+    return BINARY_HEADER_SIZE + sizeof(Message);
+}
+template<typename Message>
+size_t encode_binary_message(const Message& message, char* out, size_t capacity) {
+    static_assert(std::is_trivially_copyable_v<Message>, "binary messages must be trivially copyable");
+    constexpr size_t length = binary_message_size<Message>();
+    if (capacity < length) {
+        return 0;
+    }
+    const BinaryFrameHeader frame_header{static_cast<uint32_t>(length), BINARY_ENCODING_TYPE, 0};
+    const BinaryMessageHeader header{static_cast<uint16_t>(sizeof(Message)),
+                                     static_cast<uint16_t>(BinaryMessageTraits<Message>::TEMPLATE_ID),
+                                     BINARY_SCHEMA_ID, BINARY_SCHEMA_VERSION};
+    std::memcpy(out, &frame_header, sizeof(frame_header));
+    std::memcpy(out + sizeof(frame_header), &header, sizeof(header));
+    std::memcpy(out + BINARY_HEADER_SIZE, &message, sizeof(Message));
+    return length;
+}
+}
+}
@@ -0,0 +1,49 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+namespace hft {
+namespace core {
+class MirroredRingBuffer {
+private:
+    char* data_;
+    size_t capacity_;
+    size_t mask_;
+    uint64_t read_position_;
+    uint64_t write_position_;
+public:
+    MirroredRingBuffer();
+    ~MirroredRingBuffer();
+    MirroredRingBuffer(const MirroredRingBuffer&) = delete;
+    MirroredRingBuffer& operator=(const MirroredRingBuffer&) = delete;
+    bool open(size_t capacity);
+    void close();
+    bool is_open() const { return data_ != nullptr; }
+    size_t capacity() const { return capacity_; }
+    size_t size() const { return static_cast<size_t>(write_position_ - read_position_); }
+    bool empty() const { return write_position_ == read_position_; }
+    size_t writable() const { return capacity_ - size(); }
+    const char* read_ptr() const { return data_ + (read_position_ & mask_); }
+    char* write_ptr() { return data_ + (write_position_ & mask_); }
+    void commit(size_t length) { write_position_ += length; }
+    void consume(size_t length) {
+        read_position_ += length;
+        if (read_position_ == write_position_) {
+            read_position_ = 0;
+            write_position_ = 0;
+        }
+    }
+    size_t append(const char* data, size_t length) {
+        const size_t count = std::min(length, writable());
+        std::memcpy(write_ptr(), data, count);
+        write_position_ += count;
+        return count;
+    }
+    void clear() {
+        read_position_ = 0;
+        write_position_ = 0;
+    }
+};
+}
+}
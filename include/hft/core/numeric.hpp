@@ -0,0 +1,234 @@
+#pragma once
+#include <array>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+namespace hft {
+namespace core {
+constexpr std::array<char, 200> make_digit_pairs() {
+    std::array<char, 200> pairs{};
+    for (int i = 0; i < 100; ++i) {
+        pairs[i * 2] = static_cast<char>('0' + i / 10);
+        pairs[i * 2 + 1] = static_cast<char>('0' + i % 10);
+    }
+    return pairs;
+}
+inline constexpr std::array<char, 200> DIGIT_PAIRS = make_digit_pairs();
+inline constexpr uint64_t POWERS_OF_TEN[] = {
+    1ull, 10ull, 100ull, 1000ull, 10000ull, 100000ull, 1000000ull, 10000000ull, 100000000ull,
+    1000000000ull, 10000000000ull, 100000000000ull, 1000000000000ull, 10000000000000ull,
+    100000000000000ull, 1000000000000000ull, 10000000000000000ull, 100000000000000000ull,
+    1000000000000000000ull, 10000000000000000000ull};
+inline constexpr double EXACT_POWERS_OF_TEN[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+constexpr uint64_t MAX_EXACT_MANTISSA = 1ull << 53;
+constexpr int MAX_FIXED_DECIMALS = 9;
+constexpr size_t MAX_UINT_DIGITS = 20;
+constexpr size_t MAX_DECIMAL_DIGITS = 19;
+constexpr int MAX_FIXED_LENGTH = 32;
+struct DecimalValue {
+    uint64_t mantissa;
+    uint32_t decimals;
+    bool negative;
+};
+inline uint64_t load_digit_chunk(const char* data) {
+    uint64_t chunk;
+    std::memcpy(&chunk, data, sizeof(chunk));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    chunk = __builtin_bswap64(chunk);
+#endif
+    return chunk;
+}
+inline bool is_eight_digits(uint64_t chunk) {
+    return ((chunk & 0xF0F0F0F0F0F0F0F0ull) |
+            (((chunk + 0x0606060606060606ull) & 0xF0F0F0F0F0F0F0F0ull) >> 4)) == 0x3333333333333333ull;
+}
+inline uint32_t parse_eight_digits(uint64_t chunk) {
+    chunk -= 0x3030303030303030ull;
+    chunk = chunk * 10 + (chunk >> 8);
+    chunk = (((chunk & 0x000000FF000000FFull) * 0x000F424000000064ull) +
+             (((chunk >> 16) & 0x000000FF000000FFull) * 0x0000271000000001ull)) >> 32;
+    return static_cast<uint32_t>(chunk);
+}
+inline size_t parse_digit_run(const char* data, size_t length, uint64_t& value) {
+    size_t i = 0;
+    while (length - i >= 8) {
+        const uint64_t chunk = load_digit_chunk(data + i);
+        if (!is_eight_digits(chunk)) {
+            break;
+        }
+        value = value * 100000000ull + parse_eight_digits(chunk);
+        i += 8;
+    }
+    for (; i < length; ++i) {
+        const uint32_t digit = static_cast<uint32_t>(static_cast<uint8_t>(data[i]) - '0');
+        if (digit > 9) {
+            break;
+        }
+        value = value * 10 + digit;
+    }
+    return i;
+}
+inline bool parse_uint(const char* data, size_t length, uint64_t& value) {
+    if (length == 0 || length > MAX_UINT_DIGITS) {
+        return false;
+    }
+    const size_t fast_length = length < MAX_UINT_DIGITS ? length : MAX_UINT_DIGITS - 1;
+    uint64_t result = 0;
+    if (parse_digit_run(data, fast_length, result) != fast_length) {
+        return false;
+    }
+    if (fast_length != length) {
+        const uint32_t digit = static_cast<uint32_t>(static_cast<uint8_t>(data[fast_length]) - '0');
+        if (digit > 9 || __builtin_mul_overflow(result, 10ull, &result) || __builtin_add_overflow(result, digit, &result)) {
+            return false;
+        }
+    }
+    value = result;
+    return true;
+}
+inline bool parse_int(const char* data, size_t length, int64_t& value) {
+    const bool negative = length != 0 && data[0] == '-';
+    uint64_t magnitude = 0;
+    if (!parse_uint(data + negative, length - negative, magnitude) ||
+        magnitude > static_cast<uint64_t>(INT64_MAX) + negative) {
+        return false;
+    }
+    value = negative ? static_cast<int64_t>(0 - magnitude) : static_cast<int64_t>(magnitude);
+    return true;
+}
+inline bool parse_decimal(const char* data, size_t length, DecimalValue& value) {
+    const bool negative = length != 0 && data[0] == '-';
+    const char* cursor = data + negative;
+    const char* const end = data + length;
+    uint64_t mantissa = 0;
+    const size_t integer_digits = parse_digit_run(cursor, static_cast<size_t>(end - cursor), mantissa);
+    cursor += integer_digits;
+    size_t fraction_digits = 0;
+    if (cursor != end && *cursor == '.') {
+        ++cursor;
+        fraction_digits = parse_digit_run(cursor, static_cast<size_t>(end - cursor), mantissa);
+        cursor += fraction_digits;
+    }
+    if (cursor != end || integer_digits + fraction_digits == 0 ||
+        integer_digits + fraction_digits > MAX_DECIMAL_DIGITS) {
+        return false;
+    }
+    value = DecimalValue{mantissa, static_cast<uint32_t>(fraction_digits), negative};
+    return true;
+}
+inline bool parse_fixed(const char* data, size_t length, int decimals, int64_t& scaled) {
+    DecimalValue decimal;
+    if (decimals < 0 || decimals > MAX_FIXED_DECIMALS || !parse_decimal(data, length, decimal)) {
+        return false;
+    }
+    uint64_t magnitude = decimal.mantissa;
+    if (decimal.decimals <= static_cast<uint32_t>(decimals)) {
+        if (__builtin_mul_overflow(magnitude, POWERS_OF_TEN[decimals - decimal.decimals], &magnitude)) {
+            return false;
+        }
+    } else {
+        const uint64_t divisor = POWERS_OF_TEN[decimal.decimals - decimals];
+        const uint64_t remainder = magnitude % divisor;
+        magnitude = magnitude / divisor + (remainder >= divisor - remainder);
+    }
+    if (magnitude > static_cast<uint64_t>(INT64_MAX)) {
+        return false;
+    }
+    scaled = decimal.negative ? -static_cast<int64_t>(magnitude) : static_cast<int64_t>(magnitude);
+    return true;
+}
+inline bool parse_price(const char* data, size_t length, double& value) {
+    DecimalValue decimal;
+    if (parse_decimal(data, length, decimal) && decimal.mantissa <= MAX_EXACT_MANTISSA) {
+        const double magnitude = static_cast<double>(decimal.mantissa) / EXACT_POWERS_OF_TEN[decimal.decimals];
+        value = decimal.negative ? -magnitude : magnitude;
+        return true;
+    }
+    const auto result = std::from_chars(data, data + length, value);
+    return length != 0 && result.ec == std::errc() && result.ptr == data + length;
+}
+inline uint32_t count_digits(uint64_t value) {
+    value |= 1;
+    const uint32_t bits = 64 - static_cast<uint32_t>(__builtin_clzll(value));
+    const uint32_t estimate = (bits * 1233) >> 12;
+    return estimate + (value >= POWERS_OF_TEN[estimate]);
+}
+inline char* format_digits(char* end, uint64_t value) {
+    while (value >= 100) {
+        const uint32_t pair = static_cast<uint32_t>(value % 100);
+        value /= 100;
+        end -= 2;
+        std::memcpy(end, &DIGIT_PAIRS[pair * 2], 2);
+    }
+    if (value >= 10) {
+        end -= 2;
+        std::memcpy(end, &DIGIT_PAIRS[value * 2], 2);
+    } else {
+        *--end = static_cast<char>('0' + value);
+    }
+    return end;
+}
+inline char* format_uint(char* out, uint64_t value) {
+    const uint32_t digits = count_digits(value);
+    format_digits(out + digits, value);
+    return out + digits;
+}
+inline char* format_int(char* out, int64_t value) {
+    uint64_t magnitude = static_cast<uint64_t>(value);
+    if (value < 0) {
+        *out++ = '-';
+        magnitude = 0 - magnitude;
+    }
+    return format_uint(out, magnitude);
+}
+inline char* format_scaled(char* out, int64_t scaled, int decimals) {
+    uint64_t magnitude = static_cast<uint64_t>(scaled);
+    if (scaled < 0) {
+        *out++ = '-';
+        magnitude = 0 - magnitude;
+    }
+    if (decimals <= 0) {
+        return format_uint(out, magnitude);
+    }
+    const uint64_t scale = POWERS_OF_TEN[decimals];
+    out = format_uint(out, magnitude / scale);
+    format_digits(out + decimals + 1, magnitude % scale + scale);
+    *out = '.';
+    return out + decimals + 1;
+}
+template<int Decimals>
+inline char* format_fixed(char* out, double value) {
+    static_assert(Decimals >= 0 && Decimals <= MAX_FIXED_DECIMALS, "unsupported decimal places");
+    constexpr double scale = EXACT_POWERS_OF_TEN[Decimals];
+    const double magnitude = value < 0.0 ? -value : value;
+    if (!(magnitude * scale < 9007199254740992.0)) {
+        const int length = std::snprintf(out, MAX_FIXED_LENGTH, "%.*f", Decimals, value);
+        return out + (length > 0 ? (length < MAX_FIXED_LENGTH ? length : MAX_FIXED_LENGTH - 1) : 0);
+    }
+    const int64_t scaled = static_cast<int64_t>(magnitude * scale + 0.5);
+    return format_scaled(out, value < 0.0 ? -scaled : scaled, Decimals);
+}
+inline char* format_fixed(char* out, double value, int decimals) {
+    switch (decimals) {
+        case 0: return format_fixed<0>(out, value);
+        case 1: return format_fixed<1>(out, value);
+        case 2: return format_fixed<2>(out, value);
+        case 3: return format_fixed<3>(out, value);
+        case 4: return format_fixed<4>(out, value);
+        case 5: return format_fixed<5>(out, value);
+        case 6: return format_fixed<6>(out, value);
+        case 7: return format_fixed<7>(out, value);
+        case 8: return format_fixed<8>(out, value);
+        case 9: return format_fixed<9>(out, value);
+        default: {
+            const int length = std::snprintf(out, MAX_FIXED_LENGTH, "%.*f", decimals < 0 ? 0 : decimals, value);
+            return out + (length > 0 ? (length < MAX_FIXED_LENGTH ? length : MAX_FIXED_LENGTH - 1) : 0);
+        }
+    }
+}
+}
+}
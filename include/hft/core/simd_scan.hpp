@@ -0,0 +1,139 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+namespace hft {
+namespace core {
+constexpr size_t SIMD_SCAN_BLOCK = 64;
+struct ByteMasks {
+    uint64_t first;
+    uint64_t second;
+};
+inline const char* simd_scan_backend() {
+#if defined(__AVX2__)
+    return "avx2";
+#elif defined(__SSE2__) || defined(_M_X64)
+    return "sse2";
+#elif defined(__aarch64__)
+    return "neon";
+#else
+    return "scalar";
+#endif
+}
+inline ByteMasks scan_block_scalar(const char* data, size_t length, char first, char second) {
+    ByteMasks masks{0, 0};
+    for (size_t i = 0; i < length; ++i) {
+        masks.first |= static_cast<uint64_t>(data[i] == first) << i;
+        masks.second |= static_cast<uint64_t>(data[i] == second) << i;
+    }
+    return masks;
+}
+#if defined(__aarch64__) && !defined(__AVX2__) && !defined(__SSE2__)
+inline uint64_t neon_movemask64(uint8x16_t m0, uint8x16_t m1, uint8x16_t m2, uint8x16_t m3) {
+    const uint8x16_t weights = {1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128};
+    uint8x16_t sum01 = vpaddq_u8(vandq_u8(m0, weights), vandq_u8(m1, weights));
+    uint8x16_t sum23 = vpaddq_u8(vandq_u8(m2, weights), vandq_u8(m3, weights));
+    uint8x16_t sum = vpaddq_u8(sum01, sum23);
+    sum = vpaddq_u8(sum, sum);
+    return vgetq_lane_u64(vreinterpretq_u64_u8(sum), 0);
+}
+#endif
+inline ByteMasks scan_block64(const char* data, char first, char second) {
+#if defined(__AVX2__)
+    const __m256i first_vec = _mm256_set1_epi8(first);
+    const __m256i second_vec = _mm256_set1_epi8(second);
+    const __m256i lo = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data));
+    const __m256i hi = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + 32));
+    const uint64_t first_lo = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(lo, first_vec)));
+    const uint64_t first_hi = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(hi, first_vec)));
+    const uint64_t second_lo = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(lo, second_vec)));
+    const uint64_t second_hi = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(hi, second_vec)));
+    return ByteMasks{first_lo | (first_hi << 32), second_lo | (second_hi << 32)};
+#elif defined(__SSE2__) || defined(_M_X64)
+    const __m128i first_vec = _mm_set1_epi8(first);
+    const __m128i second_vec = _mm_set1_epi8(second);
+    ByteMasks masks{0, 0};
+    for (int lane = 0; lane < 4; ++lane) {
+        const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + lane * 16));
+        masks.first |= static_cast<uint64_t>(static_cast<uint16_t>(
+            _mm_movemask_epi8(_mm_cmpeq_epi8(chunk, first_vec)))) << (lane * 16);
+        masks.second |= static_cast<uint64_t>(static_cast<uint16_t>(
+            _mm_movemask_epi8(_mm_cmpeq_epi8(chunk, second_vec)))) << (lane * 16);
+    }
+    return masks;
+#elif defined(__aarch64__)
+    const uint8x16_t first_vec = vdupq_n_u8(static_cast<uint8_t>(first));
+    const uint8x16_t second_vec = vdupq_n_u8(static_cast<uint8_t>(second));
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(data);
+    const uint8x16_t c0 = vld1q_u8(bytes);
+    const uint8x16_t c1 = vld1q_u8(bytes + 16);
+    const uint8x16_t c2 = vld1q_u8(bytes + 32);
+    const uint8x16_t c3 = vld1q_u8(bytes + 48);
+    return ByteMasks{
+        neon_movemask64(vceqq_u8(c0, first_vec), vceqq_u8(c1, first_vec),
+                        vceqq_u8(c2, first_vec), vceqq_u8(c3, first_vec)),
+        neon_movemask64(vceqq_u8(c0, second_vec), vceqq_u8(c1, second_vec),
+                        vceqq_u8(c2, second_vec), vceqq_u8(c3, second_vec))};
+#else
+    return scan_block_scalar(data, SIMD_SCAN_BLOCK, first, second);
+#endif
+}
+inline ByteMasks scan_block(const char* data, size_t length, char first, char second) {
+    return length >= SIMD_SCAN_BLOCK ? scan_block64(data, first, second)
+                                     : scan_block_scalar(data, length, first, second);
+}
+inline const char* find_byte(const char* begin, const char* end, char value) {
+    while (static_cast<size_t>(end - begin) >= SIMD_SCAN_BLOCK) {
+        const uint64_t mask = scan_block64(begin, value, value).first;
+        if (mask != 0) {
+            return begin + __builtin_ctzll(mask);
+        }
+        begin += SIMD_SCAN_BLOCK;
+    }
+    const void* found = std::memchr(begin, value, static_cast<size_t>(end - begin));
+    return found ? static_cast<const char*>(found) : end;
+}
+inline uint64_t byte_sum(const char* data, size_t length) {
+    uint64_t sum = 0;
+    size_t i = 0;
+#if defined(__AVX2__)
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i acc = zero;
+    for (; i + 32 <= length; i += 32) {
+        const __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        acc = _mm256_add_epi64(acc, _mm256_sad_epu8(chunk, zero));
+    }
+    const __m128i folded = _mm_add_epi64(_mm256_castsi256_si128(acc), _mm256_extracti128_si256(acc, 1));
+    alignas(16) uint64_t lanes[2];
+    _mm_store_si128(reinterpret_cast<__m128i*>(lanes), folded);
+    sum = lanes[0] + lanes[1];
+#elif defined(__SSE2__) || defined(_M_X64)
+    const __m128i zero = _mm_setzero_si128();
+    __m128i acc = zero;
+    for (; i + 16 <= length; i += 16) {
+        const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        acc = _mm_add_epi64(acc, _mm_sad_epu8(chunk, zero));
+    }
+    alignas(16) uint64_t lanes[2];
+    _mm_store_si128(reinterpret_cast<__m128i*>(lanes), acc);
+    sum = lanes[0] + lanes[1];
+#elif defined(__aarch64__)
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(data);
+    for (; i + 16 <= length; i += 16) {
+        sum += vaddlvq_u8(vld1q_u8(bytes + i));
+    }
+#endif
+    for (; i < length; ++i) {
+        sum += static_cast<uint8_t>(data[i]);
+    }
+    return sum;
+}
+}
+}
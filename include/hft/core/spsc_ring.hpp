@@ -0,0 +1,71 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <utility>
+namespace hft {
+namespace core {
+template<typename T>
+class SpscRing {
+private:
+    std::unique_ptr<T[]> slots_;
+    size_t capacity_;
+    size_t mask_;
+    alignas(64) std::atomic<size_t> head_{0};
+    size_t cached_tail_{0};
+    alignas(64) std::atomic<size_t> tail_{0};
+    size_t cached_head_{0};
+public:
+    explicit SpscRing(size_t capacity) {
+        capacity_ = 1;
+        while (capacity_ < capacity) {
+            capacity_ <<= 1;
+        }
+        mask_ = capacity_ - 1;
+        slots_ = std::make_unique<T[]>(capacity_);
+    }
+    SpscRing(const SpscRing&) = delete;
+    SpscRing& operator=(const SpscRing&) = delete;
+    size_t capacity() const { return capacity_; }
+    size_t size() const {
+        return tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire);
+    }
+    bool empty() const { return size() == 0; }
+    template<typename Fill>
+    bool try_produce(Fill&& fill) {
+        const size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - cached_head_ == capacity_) {
+            cached_head_ = head_.load(std::memory_order_acquire);
+            if (tail - cached_head_ == capacity_) {
+                return false;
+            }
+        }
+        fill(slots_[tail & mask_]);
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+    template<typename Consume>
+    bool try_consume(Consume&& consume) {
+        const size_t head = head_.load(std::memory_order_relaxed);
+        if (head == cached_tail_) {
+            cached_tail_ = tail_.load(std::memory_order_acquire);
+            if (head == cached_tail_) {
+                return false;
+            }
+        }
+        consume(slots_[head & mask_]);
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+    bool try_push(T&& value) {
+        return try_produce([&value](T& slot) { slot = std::move(value); });
+    }
+    bool try_push(const T& value) {
+        return try_produce([&value](T& slot) { slot = value; });
+    }
+    bool try_pop(T& value) {
+        return try_consume([&value](T& slot) { value = std::move(slot); });
+    }
+};
+}
+}
@@ -0,0 +1,130 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__)
+#include <immintrin.h>
+#endif
+namespace hft {
+namespace core {
+enum class WaitStrategyType : uint8_t {
+    BUSY_SPIN,
+    SPIN_PAUSE,
+    SPIN_YIELD,
+    SPIN_FUTEX,
+    DOORBELL
+};
+struct WaitStrategyConfig {
+    WaitStrategyType type = WaitStrategyType::SPIN_YIELD;
+    uint32_t spin_iterations = 0;
+    uint64_t enqueue_timeout_ns = 0;
+};
+inline void cpu_relax() {
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__)
+    _mm_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield" ::: "memory");
+#else
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+#endif
+}
+inline const char* wait_strategy_name(WaitStrategyType type) {
+    switch (type) {
+        case WaitStrategyType::BUSY_SPIN: return "busy-spin";
+        case WaitStrategyType::SPIN_PAUSE: return "spin-pause";
+        case WaitStrategyType::SPIN_YIELD: return "spin-yield";
+        case WaitStrategyType::SPIN_FUTEX: return "spin-futex";
+        case WaitStrategyType::DOORBELL: return "doorbell";
+    }
+    return "unknown";
+}
+class Doorbell {
+private:
+    alignas(64) std::atomic<uint32_t> sequence_{0};
+    alignas(64) std::atomic<uint32_t> sleepers_{0};
+public:
+    uint32_t prepare() const { return sequence_.load(std::memory_order_seq_cst); }
+    void ring() {
+        sequence_.fetch_add(1, std::memory_order_seq_cst);
+        if (sleepers_.load(std::memory_order_seq_cst) != 0) {
+            sequence_.notify_all();
+        }
+    }
+    void wait(uint32_t observed) {
+        sleepers_.fetch_add(1, std::memory_order_seq_cst);
+        if (sequence_.load(std::memory_order_seq_cst) == observed) {
+            sequence_.wait(observed, std::memory_order_acquire);
+        }
+        sleepers_.fetch_sub(1, std::memory_order_release);
+    }
+};
+class WaitStrategy {
+private:
+    WaitStrategyConfig config_;
+    Doorbell* doorbell_;
+    uint32_t idle_iterations_;
+    uint32_t ticket_;
+public:
+    explicit WaitStrategy(const WaitStrategyConfig& config, Doorbell* doorbell = nullptr)
+        : config_(config), doorbell_(doorbell), idle_iterations_(0),
+          ticket_(doorbell ? doorbell->prepare() : 0) {}
+    static bool uses_doorbell(WaitStrategyType type) {
+        return type == WaitStrategyType::SPIN_FUTEX || type == WaitStrategyType::DOORBELL;
+    }
+    void reset() { idle_iterations_ = 0; }
+    void idle() {
+        const bool spinning = idle_iterations_ < config_.spin_iterations;
+        if (spinning) {
+            ++idle_iterations_;
+        }
+        switch (config_.type) {
+            case WaitStrategyType::BUSY_SPIN:
+                break;
+            case WaitStrategyType::SPIN_PAUSE:
+                if (!spinning) cpu_relax();
+                break;
+            case WaitStrategyType::SPIN_YIELD:
+                if (!spinning) std::this_thread::yield();
+                break;
+            case WaitStrategyType::SPIN_FUTEX:
+            case WaitStrategyType::DOORBELL:
+                if (!doorbell_) {
+                    std::this_thread::yield();
+                } else if (spinning && config_.type == WaitStrategyType::SPIN_FUTEX) {
+                    cpu_relax();
+                    ticket_ = doorbell_->prepare();
+                } else if (idle_iterations_ == config_.spin_iterations) {
+                    doorbell_->wait(ticket_);
+                    ticket_ = doorbell_->prepare();
+                }
+                break;
+        }
+    }
+    template<typename TryOperation>
+    bool retry_until(TryOperation&& operation, uint64_t timeout_ns) {
+        if (operation()) {
+            return true;
+        }
+        if (timeout_ns == 0) {
+            return false;
+        }
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::nanoseconds(timeout_ns);
+        uint32_t attempts = 0;
+        for (;;) {
+            if (++attempts < config_.spin_iterations || config_.type == WaitStrategyType::BUSY_SPIN) {
+                cpu_relax();
+            } else {
+                std::this_thread::yield();
+            }
+            if (operation()) {
+                return true;
+            }
+            if ((attempts & 63) == 0 && std::chrono::steady_clock::now() >= deadline) {
+                return false;
+            }
+        }
+    }
+};
+}
+}
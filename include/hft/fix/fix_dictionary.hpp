@@ -0,0 +1,483 @@
+#pragma once
+#include "hft/fix/fix_encoder.hpp"
+#include "hft/fix/fix_message_view.hpp"
+#include "hft/core/numeric.hpp"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <string_view>
+#include <tuple>
+#include <utility>
+namespace hft {
+namespace fix {
+enum class FixMsgType : uint8_t {
+    UNKNOWN,
+    HEARTBEAT,
+    TEST_REQUEST,
+    RESEND_REQUEST,
+    REJECT,
+    SEQUENCE_RESET,
+    LOGOUT,
+    LOGON,
+    NEW_ORDER_SINGLE,
+    ORDER_CANCEL_REQUEST,
+    ORDER_CANCEL_REPLACE_REQUEST,
+    EXECUTION_REPORT,
+    ORDER_CANCEL_REJECT
+};
+inline FixMsgType classify_msg_type(std::string_view msg_type) {
+    if (msg_type.size() != 1) {
+        return FixMsgType::UNKNOWN;
+    }
+    switch (msg_type[0]) {
+        case '0': return FixMsgType::HEARTBEAT;
+        case '1': return FixMsgType::TEST_REQUEST;
+        case '2': return FixMsgType::RESEND_REQUEST;
+        case '3': return FixMsgType::REJECT;
+        case '4': return FixMsgType::SEQUENCE_RESET;
+        case '5': return FixMsgType::LOGOUT;
+        case 'A': return FixMsgType::LOGON;
+        case 'D': return FixMsgType::NEW_ORDER_SINGLE;
+        case 'F': return FixMsgType::ORDER_CANCEL_REQUEST;
+        case 'G': return FixMsgType::ORDER_CANCEL_REPLACE_REQUEST;
+        case '8': return FixMsgType::EXECUTION_REPORT;
+        case '9': return FixMsgType::ORDER_CANCEL_REJECT;
+        default: return FixMsgType::UNKNOWN;
+    }
+}
+inline bool is_admin_msg_type(FixMsgType type) {
+    return type >= FixMsgType::HEARTBEAT && type <= FixMsgType::LOGON;
+}
+enum class FixDecodeStatus : uint8_t {
+    OK,
+    WRONG_MSG_TYPE,
+    MISSING_REQUIRED_FIELD,
+    DUPLICATE_FIELD,
+    BAD_VALUE,
+    MALFORMED
+};
+struct FixDecodeResult {
+    FixDecodeStatus status;
+    uint32_t tag;
+    uint64_t present;
+    bool ok() const { return status == FixDecodeStatus::OK; }
+};
+template<typename T>
+struct FixValueCodec;
+template<>
+struct FixValueCodec<uint64_t> {
+    static constexpr size_t MAX_LENGTH = 20;
+    static bool decode(std::string_view text, uint64_t& value) { return core::parse_uint(text.data(), text.size(), value); }
+    static void encode(FixFieldWriter& writer, uint64_t value) { writer.put_uint(value); }
+    static bool is_set(uint64_t value) { return value != 0; }
+    static size_t length(uint64_t) { return MAX_LENGTH; }
+};
+template<>
+struct FixValueCodec<double> {
+    static constexpr size_t MAX_LENGTH = 22 + FIX_PRICE_DECIMALS;
+    static bool decode(std::string_view text, double& value) { return core::parse_price(text.data(), text.size(), value); }
+    static void encode(FixFieldWriter& writer, double value) { writer.put_fixed<FIX_PRICE_DECIMALS>(value); }
+    static bool is_set(double value) { return value != 0.0; }
+    static size_t length(double) { return MAX_LENGTH; }
+};
+template<>
+struct FixValueCodec<char> {
+    static bool decode(std::string_view text, char& value) {
+        if (text.size() != 1) {
+            return false;
+        }
+        value = text[0];
+        return true;
+    }
+    static void encode(FixFieldWriter& writer, char value) { writer.put_char(value); }
+    static bool is_set(char value) { return value != '\0'; }
+    static size_t length(char) { return 1; }
+};
+template<>
+struct FixValueCodec<std::string_view> {
+    static bool decode(std::string_view text, std::string_view& value) {
+        value = text;
+        return !text.empty();
+    }
+    static void encode(FixFieldWriter& writer, std::string_view value) { writer.put_bytes(value); }
+    static bool is_set(std::string_view value) { return !value.empty(); }
+    static size_t length(std::string_view value) { return value.size(); }
+};
+template<typename Member>
+struct FixMemberTraits;
+template<typename Message, typename Value>
+struct FixMemberTraits<Value Message::*> {
+    using MessageType = Message;
+    using ValueType = Value;
+};
+template<uint32_t Tag, auto Member, bool Required = true>
+struct FixFieldSpec {
+    using Message = typename FixMemberTraits<decltype(Member)>::MessageType;
+    using Value = typename FixMemberTraits<decltype(Member)>::ValueType;
+    using Codec = FixValueCodec<Value>;
+    static constexpr uint32_t TAG = Tag;
+    static constexpr bool REQUIRED = Required;
+    static constexpr FixLiteral PREFIX = FixLiteral::field_prefix(Tag);
+    static bool decode(std::string_view text, Message& message) { return Codec::decode(text, message.*Member); }
+    static void encode(const Message& message, FixFieldWriter& writer) {
+        if (Required || Codec::is_set(message.*Member)) {
+            writer.put_literal(PREFIX);
+            Codec::encode(writer, message.*Member);
+        }
+    }
+    static size_t max_encoded_length(const Message& message) {
+        return sizeof(PREFIX.text) + Codec::length(message.*Member);
+    }
+};
+template<typename Message, typename... Fields>
+class FixDictionary {
+public:
+    static constexpr size_t FIELD_COUNT = sizeof...(Fields);
+    static_assert(FIELD_COUNT > 0 && FIELD_COUNT < 64, "dictionary must have between 1 and 63 fields");
+    static constexpr std::array<uint32_t, FIELD_COUNT> TAGS = {Fields::TAG...};
+    static constexpr uint64_t REQUIRED_MASK = [] {
+        uint64_t mask = 0;
+        uint64_t bit = 1;
+        ((mask |= Fields::REQUIRED ? bit : 0, bit <<= 1), ...);
+        return mask;
+    }();
+    static constexpr uint32_t TAG_LIMIT = std::max({Fields::TAG...}) + 1;
+private:
+    static constexpr std::array<uint8_t, TAG_LIMIT> SLOTS = [] {
+        std::array<uint8_t, TAG_LIMIT> slots{};
+        for (size_t i = 0; i < FIELD_COUNT; ++i) {
+            slots[TAGS[i]] = static_cast<uint8_t>(i + 1);
+        }
+        return slots;
+    }();
+    static constexpr bool UNIQUE_TAGS = [] {
+        size_t mapped = 0;
+        for (uint8_t slot : SLOTS) {
+            mapped += slot != 0;
+        }
+        return mapped == FIELD_COUNT;
+    }();
+    static_assert(UNIQUE_TAGS, "dictionary tags must be unique");
+    template<size_t... I>
+    static bool decode_slot(size_t index, std::string_view text, Message& message, std::index_sequence<I...>) {
+        bool decoded = false;
+        ((index == I && (decoded = std::tuple_element_t<I, std::tuple<Fields...>>::decode(text, message), true)) || ...);
+        return decoded;
+    }
+public:
+    static constexpr uint64_t field_bit(uint32_t tag) {
+        return tag < TAG_LIMIT && SLOTS[tag] != 0 ? 1ull << (SLOTS[tag] - 1) : 0;
+    }
+    static FixDecodeResult decode_fields(const char* data, const FixFieldRef* fields, size_t count, Message& message) {
+        message = Message{};
+        uint64_t present = 0;
+        for (size_t i = 0; i < count; ++i) {
+            const uint32_t tag = fields[i].tag;
+            if (tag >= TAG_LIMIT || SLOTS[tag] == 0) {
+                continue;
+            }
+            const size_t index = SLOTS[tag] - 1;
+            const uint64_t bit = 1ull << index;
+            if (present & bit) {
+                return FixDecodeResult{FixDecodeStatus::DUPLICATE_FIELD, tag, present};
+            }
+            present |= bit;
+            if (!decode_slot(index, std::string_view(data + fields[i].offset, fields[i].length), message,
+                             std::index_sequence_for<Fields...>{})) {
+                return FixDecodeResult{FixDecodeStatus::BAD_VALUE, tag, present};
+            }
+        }
+        const uint64_t missing = REQUIRED_MASK & ~present;
+        if (missing != 0) {
+            return FixDecodeResult{FixDecodeStatus::MISSING_REQUIRED_FIELD, TAGS[__builtin_ctzll(missing)], present};
+        }
+        return FixDecodeResult{FixDecodeStatus::OK, 0, present};
+    }
+    static FixDecodeResult decode_raw(const char* data, size_t length, std::string_view msg_type, Message& message) {
+        message = Message{};
+        if (data == nullptr || length == 0 || length > MAX_FIX_MESSAGE_SIZE) {
+            return FixDecodeResult{FixDecodeStatus::MALFORMED, 0, 0};
+        }
+        FixDecodeResult result{FixDecodeStatus::OK, 0, 0};
+        std::string_view seen_type;
+        size_t field_count = 0;
+        FixTagSet seen_tags;
+        const bool scanned = visit_fix_fields(data, length, [&](uint32_t tag, uint32_t offset, uint32_t value_length) {
+            if (++field_count > FixMessageView::MAX_FIELDS) {
+                return false;
+            }
+            if (!seen_tags.insert(tag)) {
+                if (result.status == FixDecodeStatus::OK) {
+                    result = FixDecodeResult{FixDecodeStatus::DUPLICATE_FIELD, tag, result.present};
+                }
+                return true;
+            }
+            const std::string_view text(data + offset, value_length);
+            if (tag == Tags::MSG_TYPE) {
+                seen_type = text;
+                return true;
+            }
+            if (tag >= TAG_LIMIT || SLOTS[tag] == 0 || result.status != FixDecodeStatus::OK) {
+                return true;
+            }
+            const size_t index = SLOTS[tag] - 1;
+            result.present |= 1ull << index;
+            if (!decode_slot(index, text, message, std::index_sequence_for<Fields...>{})) {
+                result = FixDecodeResult{FixDecodeStatus::BAD_VALUE, tag, result.present};
+            }
+            return true;
+        });
+        if (!scanned) {
+            return FixDecodeResult{FixDecodeStatus::MALFORMED, 0, result.present};
+        }
+        if (seen_type != msg_type) {
+            return FixDecodeResult{FixDecodeStatus::WRONG_MSG_TYPE, Tags::MSG_TYPE, 0};
+        }
+        if (result.status != FixDecodeStatus::OK) {
+            return result;
+        }
+        const uint64_t missing = REQUIRED_MASK & ~result.present;
+        if (missing != 0) {
+            return FixDecodeResult{FixDecodeStatus::MISSING_REQUIRED_FIELD, TAGS[__builtin_ctzll(missing)],
+                                   result.present};
+        }
+        return result;
+    }
+    static void encode_fields(const Message& message, FixFieldWriter& writer) {
+        (Fields::encode(message, writer), ...);
+    }
+    static size_t max_encoded_length(const Message& message) {
+        return (Fields::max_encoded_length(message) + ...);
+    }
+};
+struct NewOrderSingle {
+    uint64_t cl_ord_id;
+    std::string_view symbol;
+    char side;
+    uint64_t order_qty;
+    char ord_type;
+    double price;
+    char time_in_force;
+    std::string_view transact_time;
+};
+struct OrderCancelRequest {
+    uint64_t orig_cl_ord_id;
+    uint64_t cl_ord_id;
+    uint64_t order_id;
+    std::string_view symbol;
+    char side;
+    uint64_t order_qty;
+    std::string_view transact_time;
+};
+struct OrderCancelReplaceRequest {
+    uint64_t orig_cl_ord_id;
+    uint64_t cl_ord_id;
+    uint64_t order_id;
+    std::string_view symbol;
+    char side;
+    uint64_t order_qty;
+    char ord_type;
+    double price;
+    char time_in_force;
+    std::string_view transact_time;
+};
+struct ExecutionReport {
+    uint64_t order_id;
+    uint64_t cl_ord_id;
+    uint64_t exec_id;
+    char exec_type;
+    char ord_status;
+    std::string_view symbol;
+    char side;
+    uint64_t order_qty;
+    double price;
+    uint64_t last_qty;
+    double last_px;
+    uint64_t leaves_qty;
+    uint64_t cum_qty;
+    double avg_px;
+};
+struct OrderCancelReject {
+    std::string_view order_id;
+    uint64_t cl_ord_id;
+    uint64_t orig_cl_ord_id;
+    char ord_status;
+    char cxl_rej_response_to;
+    uint64_t cxl_rej_reason;
+    std::string_view text;
+};
+struct Heartbeat {
+    std::string_view test_req_id;
+};
+struct TestRequest {
+    std::string_view test_req_id;
+};
+struct ResendRequest {
+    uint64_t begin_seq_no;
+    uint64_t end_seq_no;
+};
+struct SessionReject {
+    uint64_t ref_seq_num;
+    uint64_t session_reject_reason;
+    std::string_view text;
+};
+struct SequenceReset {
+    char poss_dup_flag;
+    char gap_fill_flag;
+    uint64_t new_seq_no;
+};
+struct Logout {
+    std::string_view text;
+};
+struct Logon {
+    uint64_t encrypt_method;
+    uint64_t heart_bt_int;
+    char reset_seq_num_flag;
+};
+template<>
+struct FixMessageTraits<Heartbeat> {
+    static constexpr std::string_view MSG_TYPE = "0";
+    static constexpr FixLiteral MSG_TYPE_FIELD{"35=0\x01"};
+    using Dictionary = FixDictionary<Heartbeat,
+        FixFieldSpec<Tags::TEST_REQ_ID, &Heartbeat::test_req_id, false>>;
+};
+template<>
+struct FixMessageTraits<TestRequest> {
+    static constexpr std::string_view MSG_TYPE = "1";
+    static constexpr FixLiteral MSG_TYPE_FIELD{"35=1\x01"};
+    using Dictionary = FixDictionary<TestRequest,
+        FixFieldSpec<Tags::TEST_REQ_ID, &TestRequest::test_req_id>>;
+};
+template<>
+struct FixMessageTraits<ResendRequest> {
+    static constexpr std::string_view MSG_TYPE = "2";
+    static constexpr FixLiteral MSG_TYPE_FIELD{"35=2\x01"};
+    using Dictionary = FixDictionary<ResendRequest,
+        FixFieldSpec<Tags::BEGIN_SEQ_NO, &ResendRequest::begin_seq_no>,
+        FixFieldSpec<Tags::END_SEQ_NO, &ResendRequest::end_seq_no>>;
+};
+template<>
+struct FixMessageTraits<SessionReject> {
+    static constexpr std::string_view MSG_TYPE = "3";
+    static constexpr FixLiteral MSG_TYPE_FIELD{"35=3\x01"};
+    using Dictionary = FixDictionary<SessionReject,
+        FixFieldSpec<Tags::REF_SEQ_NUM, &SessionReject::ref_seq_num>,
+        FixFieldSpec<Tags::SESSION_REJECT_REASON, &SessionReject::session_reject_reason, false>,
+        FixFieldSpec<Tags::TEXT, &SessionReject::text, false>>;
+};
+template<>
+struct FixMessageTraits<SequenceReset> {
+    static constexpr std::string_view MSG_TYPE = "4";
+    static constexpr FixLiteral MSG_TYPE_FIELD{"35=4\x01"};
+    using Dictionary = FixDictionary<SequenceReset,
+        FixFieldSpec<Tags::POSS_DUP_FLAG, &SequenceReset::poss_dup_flag, false>,
+        FixFieldSpec<Tags::GAP_FILL_FLAG, &SequenceReset::gap_fill_flag, false>,
+        FixFieldSpec<Tags::NEW_SEQ_NO, &SequenceReset::new_seq_no>>;
+};
+template<>
+struct FixMessageTraits<Logout> {
+    static constexpr std::string_view MSG_TYPE = "5";
+    static constexpr FixLiteral MSG_TYPE_FIELD{"35=5\x01"};
+    using Dictionary = FixDictionary<Logout,
+        FixFieldSpec<Tags::TEXT, &Logout::text, false>>;
+};
+template<>
+struct FixMessageTraits<Logon> {
+    static constexpr std::string_view MSG_TYPE = "A";
+    static constexpr FixLiteral MSG_TYPE_FIELD{"35=A\x01"};
+    using Dictionary = FixDictionary<Logon,
+        FixFieldSpec<Tags::ENCRYPT_METHOD, &Logon::encrypt_method>,
+        FixFieldSpec<Tags::HEART_BT_INT, &Logon::heart_bt_int>,
+        FixFieldSpec<Tags::RESET_SEQ_NUM_FLAG, &Logon::reset_seq_num_flag, false>>;
+};
+template<>
+struct FixMessageTraits<NewOrderSingle> {
+    static constexpr std::string_view MSG_TYPE = "D";
+    static constexpr FixLiteral MSG_TYPE_FIELD{"35=D\x01"};
+    using Dictionary = FixDictionary<NewOrderSingle,
+        FixFieldSpec<Tags::CL_ORD_ID, &NewOrderSingle::cl_ord_id>,
+        FixFieldSpec<Tags::SYMBOL, &NewOrderSingle::symbol>,
+        FixFieldSpec<Tags::SIDE, &NewOrderSingle::side>,
+        FixFieldSpec<Tags::ORDER_QTY, &NewOrderSingle::order_qty>,
+        FixFieldSpec<Tags::ORD_TYPE, &NewOrderSingle::ord_type>,
+        FixFieldSpec<Tags::PRICE, &NewOrderSingle::price, false>,
+        FixFieldSpec<Tags::TIME_IN_FORCE, &NewOrderSingle::time_in_force, false>,
+        FixFieldSpec<Tags::TRANSACT_TIME, &NewOrderSingle::transact_time, false>>;
+};
+template<>
+struct FixMessageTraits<OrderCancelRequest> {
+    static constexpr std::string_view MSG_TYPE = "F";
+    static constexpr FixLiteral MSG_TYPE_FIELD{"35=F\x01"};
+    using Dictionary = FixDictionary<OrderCancelRequest,
+        FixFieldSpec<Tags::ORIG_CL_ORD_ID, &OrderCancelRequest::orig_cl_ord_id>,
+        FixFieldSpec<Tags::CL_ORD_ID, &OrderCancelRequest::cl_ord_id>,
+        FixFieldSpec<Tags::ORDER_ID, &OrderCancelRequest::order_id, false>,
+        FixFieldSpec<Tags::SYMBOL, &OrderCancelRequest::symbol>,
+        FixFieldSpec<Tags::SIDE, &OrderCancelRequest::side>,
+        FixFieldSpec<Tags::ORDER_QTY, &OrderCancelRequest::order_qty, false>,
+        FixFieldSpec<Tags::TRANSACT_TIME, &OrderCancelRequest::transact_time, false>>;
+};
+template<>
+struct FixMessageTraits<OrderCancelReplaceRequest> {
+    static constexpr std::string_view MSG_TYPE = "G";
+    static constexpr FixLiteral MSG_TYPE_FIELD{"35=G\x01"};
+    using Dictionary = FixDictionary<OrderCancelReplaceRequest,
+        FixFieldSpec<Tags::ORIG_CL_ORD_ID, &OrderCancelReplaceRequest::orig_cl_ord_id>,
+        FixFieldSpec<Tags::CL_ORD_ID, &OrderCancelReplaceRequest::cl_ord_id>,
+        FixFieldSpec<Tags::ORDER_ID, &OrderCancelReplaceRequest::order_id, false>,
+        FixFieldSpec<Tags::SYMBOL, &OrderCancelReplaceRequest::symbol>,
+        FixFieldSpec<Tags::SIDE, &OrderCancelReplaceRequest::side>,
+        FixFieldSpec<Tags::ORDER_QTY, &OrderCancelReplaceRequest::order_qty>,
+        FixFieldSpec<Tags::ORD_TYPE, &OrderCancelReplaceRequest::ord_type>,
+        FixFieldSpec<Tags::PRICE, &OrderCancelReplaceRequest::price, false>,
+        FixFieldSpec<Tags::TIME_IN_FORCE, &OrderCancelReplaceRequest::time_in_force, false>,
+        FixFieldSpec<Tags::TRANSACT_TIME, &OrderCancelReplaceRequest::transact_time, false>>;
+};
+template<>
+struct FixMessageTraits<ExecutionReport> {
+    static constexpr std::string_view MSG_TYPE = "8";
+    static constexpr FixLiteral MSG_TYPE_FIELD{"35=8\x01"};
+    using Dictionary = FixDictionary<ExecutionReport,
+        FixFieldSpec<Tags::ORDER_ID, &ExecutionReport::order_id>,
+        FixFieldSpec<Tags::CL_ORD_ID, &ExecutionReport::cl_ord_id, false>,
+        FixFieldSpec<Tags::EXEC_ID, &ExecutionReport::exec_id>,
+        FixFieldSpec<Tags::EXEC_TYPE, &ExecutionReport::exec_type>,
+        FixFieldSpec<Tags::ORD_STATUS, &ExecutionReport::ord_status>,
+        FixFieldSpec<Tags::SYMBOL, &ExecutionReport::symbol>,
+        FixFieldSpec<Tags::SIDE, &ExecutionReport::side>,
+        FixFieldSpec<Tags::ORDER_QTY, &ExecutionReport::order_qty, false>,
+        FixFieldSpec<Tags::PRICE, &ExecutionReport::price, false>,
+        FixFieldSpec<Tags::LAST_QTY, &ExecutionReport::last_qty, false>,
+        FixFieldSpec<Tags::LAST_PX, &ExecutionReport::last_px, false>,
+        FixFieldSpec<Tags::LEAVES_QTY, &ExecutionReport::leaves_qty>,
+        FixFieldSpec<Tags::CUM_QTY, &ExecutionReport::cum_qty>,
+        FixFieldSpec<Tags::AVG_PX, &ExecutionReport::avg_px>>;
+};
+template<>
+struct FixMessageTraits<OrderCancelReject> {
+    static constexpr std::string_view MSG_TYPE = "9";
+    static constexpr FixLiteral MSG_TYPE_FIELD{"35=9\x01"};
+    using Dictionary = FixDictionary<OrderCancelReject,
+        FixFieldSpec<Tags::ORDER_ID, &OrderCancelReject::order_id>,
+        FixFieldSpec<Tags::CL_ORD_ID, &OrderCancelReject::cl_ord_id>,
+        FixFieldSpec<Tags::ORIG_CL_ORD_ID, &OrderCancelReject::orig_cl_ord_id>,
+        FixFieldSpec<Tags::ORD_STATUS, &OrderCancelReject::ord_status>,
+        FixFieldSpec<Tags::CXL_REJ_RESPONSE_TO, &OrderCancelReject::cxl_rej_response_to>,
+        FixFieldSpec<Tags::CXL_REJ_REASON, &OrderCancelReject::cxl_rej_reason, false>,
+        FixFieldSpec<Tags::TEXT, &OrderCancelReject::text, false>>;
+};
+template<typename Message>
+FixDecodeResult decode_fix_message(const FixMessageView& view, Message& message) {
+    using Traits = FixMessageTraits<Message>;
+    if (view.msg_type() != Traits::MSG_TYPE) {
+        return FixDecodeResult{FixDecodeStatus::WRONG_MSG_TYPE, Tags::MSG_TYPE, 0};
+    }
+    return Traits::Dictionary::decode_fields(view.data(), view.fields(), view.field_count(), message);
+}
+template<typename Message>
+FixDecodeResult decode_fix_message(const char* data, size_t length, Message& message) {
+    using Traits = FixMessageTraits<Message>;
+    return Traits::Dictionary::decode_raw(data, length, Traits::MSG_TYPE, message);
+}
+}
+}
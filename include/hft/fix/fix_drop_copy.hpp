@@ -0,0 +1,200 @@
+#pragma once
+#include "hft/core/spsc_ring.hpp"
+#include "hft/core/wait_strategy.hpp"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+namespace hft {
+namespace fix {
+enum class FixDropCopyDirection : uint8_t {
+    INBOUND,
+    OUTBOUND
+};
+struct FixDropCopySegmentHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t segment_index;
+    uint64_t capacity;
+    uint64_t committed;
+    uint64_t reserved[4];
+};
+struct FixDropCopyRecordHeader {
+    uint64_t timestamp_ns;
+    uint32_t length;
+    uint32_t session;
+    uint8_t direction;
+    uint8_t reserved[7];
+};
+struct FixDropCopyIndexEntry {
+    uint64_t cl_ord_id_hash;
+    uint64_t record_offset;
+};
+struct FixDropCopyRecord {
+    uint64_t timestamp_ns;
+    uint32_t session;
+    FixDropCopyDirection direction;
+    uint64_t offset;
+    std::string_view data;
+};
+struct FixDropCopyConfig {
+    std::string directory = "logs/dropcopy";
+    std::string prefix = "fix";
+    size_t segment_size = 256 * 1024 * 1024;
+    uint32_t sync_interval_ms = 50;
+    size_t producer_ring_capacity = 16384;
+    uint64_t ingress_timeout_ns = 100000000;
+};
+struct FixDropCopyStats {
+    std::atomic<uint64_t> records_written{0};
+    std::atomic<uint64_t> bytes_written{0};
+    std::atomic<uint64_t> records_dropped{0};
+    std::atomic<uint64_t> records_indexed{0};
+    std::atomic<uint64_t> segments_rolled{0};
+    std::atomic<uint64_t> writer_segment_creates{0};
+    std::atomic<uint64_t> ingress_stalls{0};
+    std::atomic<uint64_t> doorbell_rings{0};
+    std::atomic<uint64_t> syncs{0};
+    void reset() {
+        records_written = 0;
+        bytes_written = 0;
+        records_dropped = 0;
+        records_indexed = 0;
+        segments_rolled = 0;
+        writer_segment_creates = 0;
+        ingress_stalls = 0;
+        doorbell_rings = 0;
+        syncs = 0;
+    }
+};
+uint64_t drop_copy_key_hash(std::string_view cl_ord_id);
+class FixDropCopyLog {
+public:
+    static constexpr uint32_t FORMAT_VERSION = 1;
+    static constexpr size_t RECORD_ALIGNMENT = 8;
+    static constexpr size_t MAX_PRODUCERS = 64;
+    static constexpr size_t WRITER_BATCH = 256;
+    static constexpr uint32_t WRITER_SPIN_ITERATIONS = 4096;
+private:
+    struct PendingRecord {
+        FixDropCopyRecordHeader header;
+        std::string data;
+    };
+    struct Producer {
+        std::thread::id owner;
+        core::SpscRing<PendingRecord> ring;
+        Producer(std::thread::id id, size_t capacity) : owner(id), ring(capacity) {}
+    };
+    struct Segment {
+        int fd = -1;
+        int index_fd = -1;
+        char* mapping = nullptr;
+        size_t capacity = 0;
+        uint32_t index = 0;
+        std::string path;
+        uint64_t synced = 0;
+        uint64_t indexed = 0;
+        ~Segment();
+        FixDropCopySegmentHeader* header() const { return reinterpret_cast<FixDropCopySegmentHeader*>(mapping); }
+    };
+    FixDropCopyConfig config_;
+    const uint64_t instance_id_;
+    std::array<std::unique_ptr<Producer>, MAX_PRODUCERS> producers_;
+    std::atomic<size_t> producer_count_{0};
+    std::mutex registration_mutex_;
+    std::unique_ptr<Producer> overflow_producer_;
+    std::mutex overflow_mutex_;
+    std::atomic<bool> overflow_reported_{false};
+    core::Doorbell writer_doorbell_;
+    std::thread writer_thread_;
+    std::mutex segment_mutex_;
+    std::shared_ptr<Segment> active_;
+    std::shared_ptr<Segment> standby_;
+    std::vector<std::shared_ptr<Segment>> retired_;
+    uint32_t next_segment_index_;
+    std::atomic<bool> running_;
+    std::mutex flusher_mutex_;
+    std::condition_variable flusher_cv_;
+    std::thread flusher_thread_;
+    FixDropCopyStats stats_;
+public:
+    explicit FixDropCopyLog(const FixDropCopyConfig& config = FixDropCopyConfig());
+    ~FixDropCopyLog();
+    FixDropCopyLog(const FixDropCopyLog&) = delete;
+    FixDropCopyLog& operator=(const FixDropCopyLog&) = delete;
+    bool open();
+    void close();
+    bool is_open() const { return running_.load(); }
+    bool append(FixDropCopyDirection direction, uint32_t session, const char* data, size_t length,
+                uint64_t timestamp_ns);
+    bool append(FixDropCopyDirection direction, uint32_t session, const char* data, size_t length) {
+        return append(direction, session, data, length, static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::system_clock::now().time_since_epoch()).count()));
+    }
+    void sync();
+    std::string segment_path(uint32_t segment_index) const;
+    const FixDropCopyConfig& config() const { return config_; }
+    const FixDropCopyStats& get_stats() const { return stats_; }
+private:
+    Producer& local_producer() {
+        struct CacheEntry {
+            uint64_t instance_id;
+            Producer* producer;
+        };
+        static constexpr size_t CACHE_ENTRIES = 8;
+        thread_local std::array<CacheEntry, CACHE_ENTRIES> cache{};
+        thread_local size_t next_victim = 0;
+        for (const auto& entry : cache) {
+            if (entry.instance_id == instance_id_) {
+                return *entry.producer;
+            }
+        }
+        Producer& producer = register_producer();
+        cache[next_victim] = CacheEntry{instance_id_, &producer};
+        next_victim = (next_victim + 1) % CACHE_ENTRIES;
+        return producer;
+    }
+    Producer& register_producer();
+    bool enqueue(Producer& producer, const FixDropCopyRecordHeader& header, const char* data, size_t length);
+    std::shared_ptr<Segment> create_segment(uint32_t segment_index, const std::string& path);
+    void writer_loop();
+    size_t drain_producer(Producer& producer);
+    void write_record(const PendingRecord& pending);
+    bool roll_segment();
+    void flusher_loop();
+    void maintain(bool final_pass);
+    void index_segment(Segment& segment, uint64_t committed);
+    void finish_segment(Segment& segment);
+};
+class FixDropCopyReader {
+private:
+    int fd_;
+    char* mapping_;
+    size_t mapping_size_;
+    uint64_t committed_;
+    uint64_t position_;
+    std::string path_;
+public:
+    FixDropCopyReader();
+    ~FixDropCopyReader();
+    FixDropCopyReader(const FixDropCopyReader&) = delete;
+    FixDropCopyReader& operator=(const FixDropCopyReader&) = delete;
+    bool open(const std::string& segment_path);
+    void close();
+    void rewind();
+    bool next(FixDropCopyRecord& record);
+    bool read_at(uint64_t offset, FixDropCopyRecord& record) const;
+    size_t find(std::string_view cl_ord_id, std::vector<FixDropCopyRecord>& records) const;
+    uint64_t committed() const { return committed_; }
+};
+}
+}
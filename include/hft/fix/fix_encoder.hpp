@@ -0,0 +1,168 @@
+#pragma once
+#include "hft/fix/fix_parser.hpp"
+#include "hft/core/numeric.hpp"
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+namespace hft {
+namespace fix {
+constexpr size_t FIX_TIMESTAMP_LENGTH = 21;
+size_t format_fix_timestamp(uint64_t epoch_ns, char* out);
+constexpr int FIX_PRICE_DECIMALS = 4;
+template<typename Message>
+struct FixMessageTraits;
+namespace detail {
+constexpr std::array<uint8_t, 100> make_pair_sums() {
+    std::array<uint8_t, 100> sums{};
+    for (int i = 0; i < 100; ++i) {
+        sums[i] = static_cast<uint8_t>(i / 10 + i % 10);
+    }
+    return sums;
+}
+inline constexpr std::array<uint8_t, 100> PAIR_SUMS = make_pair_sums();
+inline char* write_digits(char* end, uint64_t value, uint32_t& sum) {
+    while (value >= 100) {
+        const uint32_t pair = static_cast<uint32_t>(value % 100);
+        value /= 100;
+        end -= 2;
+        std::memcpy(end, &core::DIGIT_PAIRS[pair * 2], 2);
+        sum += PAIR_SUMS[pair];
+    }
+    if (value >= 10) {
+        end -= 2;
+        std::memcpy(end, &core::DIGIT_PAIRS[value * 2], 2);
+    } else {
+        *--end = static_cast<char>('0' + value);
+    }
+    sum += PAIR_SUMS[value];
+    return end;
+}
+inline char* write_uint(char* out, uint64_t value, uint32_t& sum) {
+    const uint32_t digits = core::count_digits(value);
+    write_digits(out + digits, value, sum);
+    sum += digits * '0';
+    return out + digits;
+}
+}
+struct FixLiteral {
+    char text[8];
+    size_t length;
+    uint32_t sum;
+    constexpr FixLiteral() : text{}, length(0), sum(0) {}
+    template<size_t N>
+    constexpr FixLiteral(const char (&value)[N]) : text{}, length(N - 1), sum(0) {
+        static_assert(N <= sizeof(text), "literal too long");
+        for (size_t i = 0; i + 1 < N; ++i) {
+            text[i] = value[i];
+            sum += static_cast<uint8_t>(value[i]);
+        }
+    }
+    static constexpr FixLiteral field_prefix(uint32_t tag) {
+        FixLiteral literal;
+        char digits[10] = {};
+        size_t count = 0;
+        do {
+            digits[count++] = static_cast<char>('0' + tag % 10);
+            tag /= 10;
+        } while (tag != 0);
+        literal.text[literal.length++] = FIX_SOH;
+        while (count != 0) {
+            literal.text[literal.length++] = digits[--count];
+        }
+        literal.text[literal.length++] = FIX_EQUALS;
+        for (size_t i = 0; i < literal.length; ++i) {
+            literal.sum += static_cast<uint8_t>(literal.text[i]);
+        }
+        return literal;
+    }
+};
+class FixFieldWriter {
+private:
+    char* cursor_;
+    uint32_t sum_;
+public:
+    explicit FixFieldWriter(char* cursor) : cursor_(cursor), sum_(0) {}
+    char* cursor() const { return cursor_; }
+    uint32_t sum() const { return sum_; }
+    void put_literal(const FixLiteral& literal) {
+        std::memcpy(cursor_, literal.text, sizeof(literal.text));
+        cursor_ += literal.length;
+        sum_ += literal.sum;
+    }
+    void put_bytes(const char* data, size_t length) {
+        std::memcpy(cursor_, data, length);
+        for (size_t i = 0; i < length; ++i) {
+            sum_ += static_cast<uint8_t>(data[i]);
+        }
+        cursor_ += length;
+    }
+    void put_bytes(std::string_view text) { put_bytes(text.data(), text.size()); }
+    void put_precomputed(std::string_view text, uint32_t sum) {
+        std::memcpy(cursor_, text.data(), text.size());
+        cursor_ += text.size();
+        sum_ += sum;
+    }
+    void put_char(char c) {
+        *cursor_++ = c;
+        sum_ += static_cast<uint8_t>(c);
+    }
+    void put_uint(uint64_t value) { cursor_ = detail::write_uint(cursor_, value, sum_); }
+    template<int Decimals>
+    void put_fixed(double value) {
+        static_assert(Decimals >= 0 && Decimals <= 8, "unsupported decimal places");
+        constexpr uint64_t scale = core::POWERS_OF_TEN[Decimals];
+        if (value < 0.0) {
+            put_char('-');
+            value = -value;
+        }
+        const uint64_t scaled = static_cast<uint64_t>(value * static_cast<double>(scale) + 0.5);
+        put_uint(scaled / scale);
+        if constexpr (Decimals > 0) {
+            put_char('.');
+            detail::write_digits(cursor_ + Decimals, scaled % scale + scale, sum_);
+            cursor_[-1] = '.';
+            sum_ += Decimals * '0' - 1;
+            cursor_ += Decimals;
+        }
+    }
+    void put_fixed(double value, int decimals);
+    void put_timestamp(uint64_t epoch_ns);
+};
+class FixMessageEncoder {
+public:
+    static constexpr size_t BODY_LENGTH_DIGITS = 4;
+private:
+    std::array<char, MAX_FIX_MESSAGE_SIZE> buffer_;
+    std::string begin_prefix_;
+    uint32_t begin_prefix_sum_;
+    std::string header_;
+    uint32_t header_sum_;
+    size_t body_offset_;
+    size_t field_capacity_;
+    uint64_t cached_second_;
+    std::array<char, FIX_TIMESTAMP_LENGTH> cached_timestamp_;
+    uint32_t cached_timestamp_sum_;
+public:
+    FixMessageEncoder(std::string_view sender_comp_id, std::string_view target_comp_id,
+                      std::string_view begin_string = "FIX.4.4");
+    template<typename Message>
+    std::string_view encode(const Message& message, uint32_t msg_seq_num, uint64_t sending_time_ns) {
+        using Traits = FixMessageTraits<Message>;
+        if (Traits::Dictionary::max_encoded_length(message) > field_capacity_) {
+            return std::string_view();
+        }
+        char* const body = buffer_.data() + body_offset_;
+        FixFieldWriter writer(body);
+        writer.put_literal(Traits::MSG_TYPE_FIELD);
+        write_header(writer, msg_seq_num, sending_time_ns);
+        Traits::Dictionary::encode_fields(message, writer);
+        return finish(body, writer);
+    }
+private:
+    void write_header(FixFieldWriter& writer, uint32_t msg_seq_num, uint64_t sending_time_ns);
+    std::string_view finish(char* body, FixFieldWriter& writer);
+};
+}
+}
@@ -0,0 +1,157 @@
+#pragma once
+#include "hft/fix/fix_parser.hpp"
+#include "hft/core/spsc_ring.hpp"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+namespace hft {
+namespace fix {
+using FixConnectionId = FixSessionId;
+class GatewayCodec {
+public:
+    virtual ~GatewayCodec() = default;
+    virtual bool ready() const = 0;
+    virtual FixConnectionId open_connection() = 0;
+    virtual bool on_data(FixConnectionId connection_id, const char* data, size_t length) = 0;
+    virtual void close_connection(FixConnectionId connection_id) = 0;
+    virtual void on_timer(uint64_t) {}
+};
+class FixParserCodec : public GatewayCodec {
+private:
+    FixParser& parser_;
+public:
+    explicit FixParserCodec(FixParser& parser) : parser_(parser) {}
+    bool ready() const override { return parser_.is_running() && parser_.is_inline(); }
+    FixConnectionId open_connection() override { return parser_.open_session(); }
+    bool on_data(FixConnectionId connection_id, const char* data, size_t length) override {
+        parser_.feed_data(connection_id, data, length);
+        return true;
+    }
+    void close_connection(FixConnectionId connection_id) override { parser_.close_session(connection_id); }
+};
+struct FixGatewayConfig {
+    std::string bind_address = "0.0.0.0";
+    uint16_t port = 9878;
+    int listen_backlog = 1024;
+    size_t read_buffer_size = 256 * 1024;
+    int poll_timeout_ms = 1;
+    bool tcp_nodelay = true;
+    bool batch_writes = true;
+    size_t flush_threshold_bytes = 64 * 1024;
+    size_t handoff_capacity = 1024;
+    size_t max_pending_output_bytes = 16 * 1024 * 1024;
+};
+struct FixGatewayStats {
+    std::atomic<uint64_t> connections_accepted{0};
+    std::atomic<uint64_t> connections_closed{0};
+    std::atomic<uint64_t> connections_rejected{0};
+    std::atomic<uint64_t> bytes_received{0};
+    std::atomic<uint64_t> bytes_sent{0};
+    std::atomic<uint64_t> read_calls{0};
+    std::atomic<uint64_t> send_calls{0};
+    std::atomic<uint64_t> messages_batched{0};
+    std::atomic<uint64_t> poll_wakeups{0};
+    std::atomic<uint64_t> send_would_block{0};
+    std::atomic<uint64_t> send_errors{0};
+    std::atomic<uint64_t> messages_handed_off{0};
+    std::atomic<uint64_t> handoff_wakeups{0};
+    std::atomic<uint64_t> handoff_full{0};
+    std::atomic<uint64_t> output_overflows{0};
+    std::atomic<uint64_t> closes_posted{0};
+    void reset() {
+        connections_accepted = 0;
+        connections_closed = 0;
+        connections_rejected = 0;
+        bytes_received = 0;
+        bytes_sent = 0;
+        read_calls = 0;
+        send_calls = 0;
+        messages_batched = 0;
+        poll_wakeups = 0;
+        send_would_block = 0;
+        send_errors = 0;
+        messages_handed_off = 0;
+        handoff_wakeups = 0;
+        handoff_full = 0;
+        output_overflows = 0;
+        closes_posted = 0;
+    }
+};
+class FixGateway {
+public:
+    static constexpr FixConnectionId INVALID_CONNECTION = FixParser::INVALID_SESSION;
+    static constexpr size_t MAX_CONNECTIONS = FixParser::MAX_SESSIONS;
+    static constexpr size_t MAX_POLL_EVENTS = 256;
+private:
+    struct Connection {
+        std::atomic<int> fd{-1};
+        std::atomic<bool> open{false};
+        std::atomic<uint64_t> generation{0};
+        std::mutex output_mutex;
+        std::string pending_output;
+        size_t pending_offset = 0;
+        std::string batch;
+        std::mutex handoff_mutex;
+        std::unique_ptr<core::SpscRing<std::string>> handoff;
+        std::atomic<bool> handoff_pending{false};
+    };
+    std::unique_ptr<GatewayCodec> owned_codec_;
+    GatewayCodec& codec_;
+    FixGatewayConfig config_;
+    int listen_fd_;
+    int poll_fd_;
+    int wake_fd_;
+    uint16_t bound_port_;
+    std::atomic<bool> running_;
+    std::thread event_thread_;
+    std::unique_ptr<Connection[]> connections_;
+    std::unique_ptr<char[]> read_buffer_;
+    std::vector<FixConnectionId> dirty_connections_;
+    std::mutex handoff_list_mutex_;
+    std::vector<FixConnectionId> handoff_connections_;
+    std::vector<FixConnectionId> handoff_scratch_;
+    std::vector<std::pair<FixConnectionId, uint64_t>> close_requests_;
+    std::vector<std::pair<FixConnectionId, uint64_t>> close_scratch_;
+    FixGatewayStats stats_;
+public:
+    explicit FixGateway(FixParser& parser, const FixGatewayConfig& config = FixGatewayConfig());
+    explicit FixGateway(GatewayCodec& codec, const FixGatewayConfig& config = FixGatewayConfig());
+    ~FixGateway();
+    FixGateway(const FixGateway&) = delete;
+    FixGateway& operator=(const FixGateway&) = delete;
+    bool start();
+    void stop();
+    bool is_running() const { return running_.load(); }
+    uint16_t port() const { return bound_port_; }
+    bool send(FixConnectionId connection_id, const char* data, size_t length);
+    void flush(FixConnectionId connection_id);
+    void close_connection(FixConnectionId connection_id);
+    size_t poll_once(int timeout_ms);
+    const FixGatewayStats& get_stats() const { return stats_; }
+    void reset_stats() { stats_.reset(); }
+private:
+    Connection* find_connection(FixConnectionId connection_id) const {
+        return connection_id < MAX_CONNECTIONS && connections_ ? &connections_[connection_id] : nullptr;
+    }
+    bool open_listener();
+    bool watch(int fd, uint64_t token, bool writable);
+    bool open_wakeup();
+    void wake();
+    bool hand_off(FixConnectionId connection_id, Connection& connection, const char* data, size_t length);
+    uint64_t consume_handoff(Connection& connection);
+    void drain_handoffs();
+    void close_now(FixConnectionId connection_id);
+    void event_loop();
+    void accept_connections();
+    void read_connection(FixConnectionId connection_id);
+    void flush_batches();
+    bool write_bytes(Connection& connection, const char* data, size_t length, size_t& written);
+    bool flush_output(Connection& connection);
+};
+}
+}
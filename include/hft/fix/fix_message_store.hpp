@@ -0,0 +1,60 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+namespace hft {
+namespace fix {
+struct FixStoreHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t index_slots;
+    uint64_t data_capacity;
+    uint64_t next_sender_seq;
+    uint64_t next_target_seq;
+    uint64_t write_position;
+    uint64_t reserved[2];
+};
+struct FixStoreEntry {
+    uint64_t seq;
+    uint64_t position;
+    uint32_t length;
+    uint32_t reserved;
+};
+class FixMessageStore {
+public:
+    static constexpr size_t DEFAULT_DATA_CAPACITY = 64 * 1024 * 1024;
+    static constexpr size_t DEFAULT_INDEX_SLOTS = 262144;
+    static constexpr uint32_t STORE_VERSION = 1;
+private:
+    int fd_;
+    char* mapping_;
+    size_t mapping_size_;
+    FixStoreHeader* header_;
+    FixStoreEntry* entries_;
+    char* data_;
+    uint64_t index_mask_;
+    std::string path_;
+public:
+    FixMessageStore();
+    ~FixMessageStore();
+    FixMessageStore(const FixMessageStore&) = delete;
+    FixMessageStore& operator=(const FixMessageStore&) = delete;
+    bool open(const std::string& path, size_t data_capacity = DEFAULT_DATA_CAPACITY,
+              size_t index_slots = DEFAULT_INDEX_SLOTS);
+    void close();
+    bool is_open() const { return mapping_ != nullptr; }
+    const std::string& path() const { return path_; }
+    bool store(uint64_t seq, const char* data, size_t length);
+    std::string_view lookup(uint64_t seq) const;
+    uint64_t next_sender_seq() const { return header_->next_sender_seq; }
+    uint64_t next_target_seq() const { return header_->next_target_seq; }
+    void set_next_sender_seq(uint64_t seq) { header_->next_sender_seq = seq; }
+    void set_next_target_seq(uint64_t seq) { header_->next_target_seq = seq; }
+    size_t data_capacity() const { return header_->data_capacity; }
+    size_t index_slots() const { return header_->index_slots; }
+    void reset();
+    void flush(bool synchronous = false);
+};
+}
+}
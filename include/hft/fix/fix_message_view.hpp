@@ -0,0 +1,84 @@
+#pragma once
+#include "hft/fix/fix_parser.hpp"
+#include "hft/fix/fix_scanner.hpp"
+#include <array>
+#include <cstdint>
+#include <string_view>
+namespace hft {
+namespace fix {
+class FixMessageView {
+public:
+    static constexpr size_t MAX_FIELDS = 128;
+    static constexpr uint32_t HOT_TAG_LIMIT = 256;
+private:
+    const char* data_;
+    uint32_t length_;
+    uint32_t field_count_;
+    std::array<FixFieldRef, MAX_FIELDS> fields_;
+    std::array<uint8_t, HOT_TAG_LIMIT> hot_index_;
+public:
+    FixMessageView() : data_(nullptr), length_(0), field_count_(0), hot_index_{} {}
+    bool parse(const char* data, size_t length);
+    bool parse(std::string_view message) { return parse(message.data(), message.size()); }
+    void clear();
+    const char* data() const { return data_; }
+    size_t size() const { return length_; }
+    size_t field_count() const { return field_count_; }
+    const FixFieldRef& field_at(size_t index) const { return fields_[index]; }
+    const FixFieldRef* fields() const { return fields_.data(); }
+    std::string_view value_at(size_t index) const {
+        return std::string_view(data_ + fields_[index].offset, fields_[index].length);
+    }
+    const FixFieldRef* find(uint32_t tag) const {
+        if (tag < HOT_TAG_LIMIT) {
+            const uint8_t slot = hot_index_[tag];
+            return slot ? &fields_[slot - 1] : nullptr;
+        }
+        for (uint32_t i = 0; i < field_count_; ++i) {
+            if (fields_[i].tag == tag) {
+                return &fields_[i];
+            }
+        }
+        return nullptr;
+    }
+    bool has_field(uint32_t tag) const { return find(tag) != nullptr; }
+    std::string_view get_field(uint32_t tag) const {
+        const FixFieldRef* field = find(tag);
+        return field ? std::string_view(data_ + field->offset, field->length) : std::string_view();
+    }
+    bool get_uint(uint32_t tag, uint64_t& value) const;
+    bool get_int(uint32_t tag, int64_t& value) const;
+    bool get_price(uint32_t tag, double& value) const;
+    bool get_char(uint32_t tag, char& value) const;
+    std::string_view begin_string() const { return get_field(Tags::BEGIN_STRING); }
+    std::string_view msg_type() const { return get_field(Tags::MSG_TYPE); }
+    uint32_t body_length() const;
+    uint32_t msg_seq_num() const;
+    bool to_message(FixMessage& message) const;
+};
+class FixTagSet {
+private:
+    std::array<uint64_t, FixMessageView::HOT_TAG_LIMIT / 64> hot_{};
+    std::array<uint32_t, FixMessageView::MAX_FIELDS> cold_{};
+    uint32_t cold_count_ = 0;
+public:
+    bool insert(uint32_t tag) {
+        if (tag < FixMessageView::HOT_TAG_LIMIT) {
+            const uint64_t bit = 1ull << (tag & 63);
+            const bool fresh = (hot_[tag >> 6] & bit) == 0;
+            hot_[tag >> 6] |= bit;
+            return fresh;
+        }
+        for (uint32_t i = 0; i < cold_count_; ++i) {
+            if (cold_[i] == tag) {
+                return false;
+            }
+        }
+        if (cold_count_ < cold_.size()) {
+            cold_[cold_count_++] = tag;
+        }
+        return true;
+    }
+};
+}
+}
@@ -1,6 +1,9 @@
 #pragma once
 #include "hft/core/types.hpp"
-#include "hft/core/lock_free_queue.hpp"
+#include "hft/core/mirrored_ring_buffer.hpp"
+#include "hft/core/spsc_ring.hpp"
+#include "hft/core/wait_strategy.hpp"
+#include "hft/fix/fix_scanner.hpp"
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -9,11 +12,13 @@
 #include <memory>
 #include <functional>
 #include <mutex>
+#include <array>
 namespace hft {
 namespace fix {
 constexpr char FIX_SOH = '\001';
 constexpr char FIX_EQUALS = '=';
 constexpr size_t MAX_FIX_MESSAGE_SIZE = 8192;
+constexpr size_t FIX_SESSION_BUFFER_SIZE = 4 * MAX_FIX_MESSAGE_SIZE;
 namespace Tags {
     constexpr uint32_t BEGIN_STRING = 8;
     constexpr uint32_t BODY_LENGTH = 9;
@@ -24,6 +29,7 @@ namespace Tags {
     constexpr uint32_t SENDING_TIME = 52;
     constexpr uint32_t TARGET_COMP_ID = 56;
     constexpr uint32_t CL_ORD_ID = 11;
+    constexpr uint32_t ORIG_CL_ORD_ID = 41;
     constexpr uint32_t ORDER_ID = 37;
     constexpr uint32_t EXEC_ID = 17;
     constexpr uint32_t EXEC_TYPE = 150;
@@ -34,12 +40,29 @@ namespace Tags {
     constexpr uint32_t PRICE = 44;
     constexpr uint32_t TIME_IN_FORCE = 59;
     constexpr uint32_t ORD_TYPE = 40;
+    constexpr uint32_t TRANSACT_TIME = 60;
     constexpr uint32_t LAST_QTY = 32;
     constexpr uint32_t LAST_PX = 31;
     constexpr uint32_t LEAVES_QTY = 151;
     constexpr uint32_t CUM_QTY = 14;
     constexpr uint32_t AVG_PX = 6;
+    constexpr uint32_t BEGIN_SEQ_NO = 7;
+    constexpr uint32_t END_SEQ_NO = 16;
+    constexpr uint32_t NEW_SEQ_NO = 36;
+    constexpr uint32_t POSS_DUP_FLAG = 43;
+    constexpr uint32_t REF_SEQ_NUM = 45;
+    constexpr uint32_t TEXT = 58;
+    constexpr uint32_t ENCRYPT_METHOD = 98;
+    constexpr uint32_t CXL_REJ_REASON = 102;
+    constexpr uint32_t HEART_BT_INT = 108;
+    constexpr uint32_t TEST_REQ_ID = 112;
+    constexpr uint32_t ORIG_SENDING_TIME = 122;
+    constexpr uint32_t GAP_FILL_FLAG = 123;
+    constexpr uint32_t RESET_SEQ_NUM_FLAG = 141;
+    constexpr uint32_t SESSION_REJECT_REASON = 373;
+    constexpr uint32_t CXL_REJ_RESPONSE_TO = 434;
 }
+class FixMessageView;
 struct FixField {
     uint32_t tag;
     std::string value;
@@ -91,25 +114,60 @@ struct FixParserStats {
         callback_errors = 0;
     }
 };
+using FixSessionId = uint32_t;
+class FixMessageHandler {
+public:
+    virtual ~FixMessageHandler() = default;
+    virtual void on_message(FixSessionId session_id, const FixMessageView& message) = 0;
+    virtual void on_reject(FixFrameStatus, const char*, size_t) {}
+    virtual void on_session_closed(FixSessionId) {}
+};
+struct FixSessionFrame {
+    std::string data;
+    uint64_t generation = 0;
+};
+struct FixSession {
+    FixSessionId id;
+    size_t worker;
+    std::atomic<bool> open;
+    std::atomic<uint64_t> generation;
+    core::MirroredRingBuffer buffer;
+    uint64_t buffer_generation;
+    size_t pending_frame;
+    core::SpscRing<FixSessionFrame> queue;
+    std::unique_ptr<FixMessageView> view;
+    FixSession(FixSessionId session_id, size_t queue_capacity);
+    ~FixSession();
+};
 class FixParser {
 public:
-    using MessageCallback = std::function<void(const FixMessage&)>;
+    using MessageCallback = std::function<void(FixSessionId, const FixMessage&)>;
     using ErrorCallback = std::function<void(const std::string&, const std::string&)>;
+    static constexpr size_t MAX_SESSIONS = 1024;
+    static constexpr size_t SESSION_QUEUE_SIZE = 1024;
+    static constexpr FixSessionId DEFAULT_SESSION = 0;
+    static constexpr FixSessionId INVALID_SESSION = 0xFFFFFFFFu;
 private:
-    static constexpr size_t PARSER_QUEUE_SIZE = 16384;
-    static constexpr size_t MAX_WORKER_THREADS = 4;
+    static constexpr size_t SESSION_DRAIN_BATCH = 64;
+    struct WorkerSessions {
+        std::array<FixSession*, MAX_SESSIONS> sessions{};
+        std::atomic<size_t> count{0};
+    };
     std::atomic<bool> running_{false};
     size_t num_worker_threads_;
     std::vector<std::thread> worker_threads_;
-    std::unique_ptr<core::LockFreeQueue<std::string, PARSER_QUEUE_SIZE>> raw_message_queue_;
-    std::unique_ptr<core::LockFreeQueue<FixMessage, PARSER_QUEUE_SIZE>> parsed_message_queue_;
+    std::array<std::atomic<FixSession*>, MAX_SESSIONS> session_table_{};
+    std::vector<std::unique_ptr<FixSession>> sessions_;
+    std::unique_ptr<WorkerSessions[]> worker_sessions_;
+    core::WaitStrategyConfig wait_config_;
     MessageCallback message_callback_;
     ErrorCallback error_callback_;
+    std::atomic<uint64_t> callback_version_{0};
     FixParserStats stats_;
-    std::string message_buffer_;
-    size_t buffer_position_;
+    mutable std::mutex session_mutex_;
     mutable std::mutex buffer_mutex_;
     mutable std::mutex callback_mutex_;
+    FixMessageHandler* inline_handler_;
 public:
     explicit FixParser(size_t num_workers = 4);
     ~FixParser();
@@ -119,21 +177,36 @@ public:
     FixParser& operator=(FixParser&&) = delete;
     void set_message_callback(MessageCallback callback);
     void set_error_callback(ErrorCallback callback);
+    void set_inline_handler(FixMessageHandler* handler);
+    bool is_inline() const { return inline_handler_ != nullptr; }
     void start();
     void stop();
     bool is_running() const { return running_.load(); }
     void feed_data(const char* data, size_t length);
     void feed_data(const std::string& data);
+    FixSessionId open_session();
+    void close_session(FixSessionId session_id);
+    void feed_data(FixSessionId session_id, const char* data, size_t length);
+    size_t get_session_count() const;
+    size_t get_session_worker(FixSessionId session_id) const;
+    void set_wait_strategy(const core::WaitStrategyConfig& config);
     bool parse_message(const std::string& raw_message, FixMessage& parsed_message);
+    bool parse_view(const char* data, size_t length, FixMessageView& view);
     const FixParserStats& get_stats() const { return stats_; }
     void reset_stats() { stats_.reset(); }
     void set_worker_threads(size_t count);
     size_t get_worker_threads() const { return num_worker_threads_; }
 private:
-    void parsing_worker();
-    void processing_worker();
-    bool extract_next_message(std::string& message);
+    void session_worker(size_t worker_index);
+    size_t drain_session(FixSession& session, FixMessage& parsed_message, const MessageCallback& callback);
+    void assign_session(FixSession& session);
+    void feed_session(FixSession& session, const char* data, size_t length);
+    size_t frame_session(FixSession& session, const char* data, size_t length);
+    size_t enqueue_frames(FixSession& session, const char* data, size_t length);
+    size_t dispatch_inline(FixSession& session, const char* data, size_t length);
     bool parse_message_internal(const std::string& raw_message, FixMessage& message);
+    bool decode_message(const char* data, size_t length, FixMessage& message);
+    bool verify_frame(const char* data, size_t length);
     bool parse_field(const std::string& field_str, uint32_t& tag, std::string& value);
     bool validate_message_structure(const FixMessage& message);
     uint8_t calculate_checksum(const std::string& message_without_checksum);
@@ -0,0 +1,73 @@
+#pragma once
+#include "hft/core/simd_scan.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+namespace hft {
+namespace fix {
+struct FixFieldRef {
+    uint32_t tag;
+    uint32_t offset;
+    uint32_t length;
+};
+enum class FixFrameStatus : uint8_t {
+    COMPLETE,
+    INCOMPLETE,
+    INVALID,
+    BAD_CHECKSUM
+};
+struct FixFrame {
+    FixFrameStatus status;
+    size_t start;
+    size_t length;
+    uint32_t body_length;
+    uint8_t checksum;
+};
+constexpr size_t FIX_TRAILER_LENGTH = 7;
+uint8_t fix_checksum(const char* data, size_t length);
+FixFrame frame_fix_message(const char* data, size_t length);
+int scan_fix_fields(const char* data, size_t length, FixFieldRef* fields, size_t max_fields);
+template<typename Visitor>
+bool visit_fix_field(const char* data, size_t begin, size_t end, Visitor& visitor) {
+    uint32_t tag = 0;
+    size_t position = begin;
+    const size_t tag_end = std::min(end, begin + 9);
+    for (; position < tag_end; ++position) {
+        const uint32_t digit = static_cast<uint32_t>(static_cast<unsigned char>(data[position])) - '0';
+        if (digit > 9) {
+            break;
+        }
+        tag = tag * 10 + digit;
+    }
+    if (position == begin || position == end || data[position] != '=' || tag == 0) {
+        return false;
+    }
+    return visitor(tag, static_cast<uint32_t>(position + 1), static_cast<uint32_t>(end - position - 1));
+}
+template<typename Visitor>
+bool visit_fix_fields(const char* data, size_t length, Visitor&& visitor) {
+    size_t field_start = 0;
+    for (size_t base = 0; base < length; base += core::SIMD_SCAN_BLOCK) {
+        const size_t block = std::min(core::SIMD_SCAN_BLOCK, length - base);
+        uint64_t pending;
+        if (block == core::SIMD_SCAN_BLOCK) {
+            pending = core::scan_block64(data + base, '\001', '\001').first;
+        } else {
+            char tail[core::SIMD_SCAN_BLOCK] = {};
+            std::memcpy(tail, data + base, block);
+            pending = core::scan_block64(tail, '\001', '\001').first & ((1ull << block) - 1);
+        }
+        while (pending != 0) {
+            const size_t position = base + static_cast<unsigned>(__builtin_ctzll(pending));
+            pending &= pending - 1;
+            if (!visit_fix_field(data, field_start, position, visitor)) {
+                return false;
+            }
+            field_start = position + 1;
+        }
+    }
+    return field_start == length || visit_fix_field(data, field_start, length, visitor);
+}
+}
+}
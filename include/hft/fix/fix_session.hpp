@@ -0,0 +1,146 @@
+#pragma once
+#include "hft/fix/fix_dictionary.hpp"
+#include "hft/fix/fix_encoder.hpp"
+#include "hft/fix/fix_message_store.hpp"
+#include "hft/fix/fix_message_view.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <string_view>
+namespace hft {
+namespace fix {
+class FixTransport {
+public:
+    virtual ~FixTransport() = default;
+    virtual bool send(const char* data, size_t length) = 0;
+    virtual void disconnect() {}
+};
+struct FixSessionConfig {
+    std::string sender_comp_id;
+    std::string target_comp_id;
+    std::string begin_string = "FIX.4.4";
+    uint32_t heartbeat_interval_s = 30;
+    std::string store_path;
+    size_t store_capacity = FixMessageStore::DEFAULT_DATA_CAPACITY;
+    size_t store_index_slots = FixMessageStore::DEFAULT_INDEX_SLOTS;
+    bool reset_on_logon = false;
+};
+enum class FixSessionState : uint8_t {
+    DISCONNECTED,
+    LOGON_SENT,
+    ACTIVE,
+    LOGOUT_SENT
+};
+struct FixSessionStats {
+    std::atomic<uint64_t> messages_sent{0};
+    std::atomic<uint64_t> messages_received{0};
+    std::atomic<uint64_t> application_messages{0};
+    std::atomic<uint64_t> duplicates_ignored{0};
+    std::atomic<uint64_t> sequence_gaps{0};
+    std::atomic<uint64_t> resend_requests_sent{0};
+    std::atomic<uint64_t> resend_requests_served{0};
+    std::atomic<uint64_t> messages_resent{0};
+    std::atomic<uint64_t> gap_fills_sent{0};
+    std::atomic<uint64_t> heartbeats_sent{0};
+    std::atomic<uint64_t> test_requests_sent{0};
+    std::atomic<uint64_t> rejects_received{0};
+    std::atomic<uint64_t> send_failures{0};
+    std::atomic<uint64_t> comp_id_rejects{0};
+    void reset() {
+        messages_sent = 0;
+        messages_received = 0;
+        application_messages = 0;
+        duplicates_ignored = 0;
+        sequence_gaps = 0;
+        resend_requests_sent = 0;
+        resend_requests_served = 0;
+        messages_resent = 0;
+        gap_fills_sent = 0;
+        heartbeats_sent = 0;
+        test_requests_sent = 0;
+        rejects_received = 0;
+        send_failures = 0;
+        comp_id_rejects = 0;
+    }
+};
+class FixSessionEngine : public FixMessageHandler {
+public:
+    static constexpr size_t TEST_REQ_ID_CAPACITY = 24;
+private:
+    FixSessionConfig config_;
+    FixTransport* transport_;
+    FixMessageHandler* application_;
+    FixMessageStore store_;
+    FixMessageEncoder encoder_;
+    FixMessageView resend_view_;
+    std::string resend_body_;
+    std::string resend_buffer_;
+    FixSessionState state_;
+    uint64_t heartbeat_interval_ns_;
+    uint64_t clock_ns_;
+    uint64_t last_sent_ns_;
+    uint64_t last_received_ns_;
+    bool resend_pending_;
+    uint64_t resend_target_seq_;
+    bool test_request_pending_;
+    uint64_t test_request_counter_;
+    char test_req_id_[TEST_REQ_ID_CAPACITY];
+    size_t test_req_id_length_;
+    FixSessionStats stats_;
+public:
+    FixSessionEngine(const FixSessionConfig& config, FixTransport* transport, FixMessageHandler* application);
+    FixSessionEngine(const FixSessionEngine&) = delete;
+    FixSessionEngine& operator=(const FixSessionEngine&) = delete;
+    bool open();
+    bool logon(uint64_t now_ns);
+    bool logout(std::string_view text = std::string_view());
+    void on_disconnect();
+    void on_timer(uint64_t now_ns);
+    void on_message(FixSessionId session_id, const FixMessageView& message) override;
+    void on_reject(FixFrameStatus, const char*, size_t) override { stats_.rejects_received.fetch_add(1); }
+    template<typename Message>
+    bool send(const Message& message) {
+        if (state_ != FixSessionState::ACTIVE && !is_admin_msg_type(classify_msg_type(FixMessageTraits<Message>::MSG_TYPE))) {
+            return false;
+        }
+        const uint64_t seq = store_.next_sender_seq();
+        const std::string_view wire = encoder_.encode(message, static_cast<uint32_t>(seq), sending_time_ns());
+        if (wire.empty() || !store_.store(seq, wire.data(), wire.size())) {
+            stats_.send_failures.fetch_add(1);
+            return false;
+        }
+        store_.set_next_sender_seq(seq + 1);
+        return transmit(wire.data(), wire.size());
+    }
+    FixSessionState state() const { return state_; }
+    bool is_active() const { return state_ == FixSessionState::ACTIVE; }
+    uint64_t next_sender_seq() const { return store_.next_sender_seq(); }
+    uint64_t next_target_seq() const { return store_.next_target_seq(); }
+    const FixSessionConfig& config() const { return config_; }
+    const FixSessionStats& get_stats() const { return stats_; }
+    void reset_stats() { stats_.reset(); }
+    FixMessageStore& store() { return store_; }
+private:
+    static uint64_t sending_time_ns() {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count());
+    }
+    bool transmit(const char* data, size_t length);
+    void disconnect_transport();
+    void advance_target_seq(uint64_t seq);
+    bool check_comp_ids(const FixMessageView& message) const;
+    bool check_sequence(const FixMessageView& message, FixMsgType type, uint64_t seq);
+    bool on_logon(const FixMessageView& message, uint64_t seq);
+    void on_sequence_reset(const FixMessageView& message, uint64_t seq);
+    void on_resend_request(const FixMessageView& message);
+    void on_test_request(const FixMessageView& message);
+    void on_heartbeat(const FixMessageView& message);
+    void on_logout();
+    void request_resend(uint64_t seq);
+    bool send_gap_fill(uint64_t seq, uint64_t new_seq_no);
+    bool resend_stored(std::string_view stored);
+    void terminate(std::string_view text);
+};
+}
+}
@@ -0,0 +1,89 @@
+#pragma once
+#include "hft/fix/fix_drop_copy.hpp"
+#include "hft/fix/fix_gateway.hpp"
+#include "hft/fix/fix_session.hpp"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+namespace hft {
+namespace fix {
+struct FixSessionCodecStats {
+    std::atomic<uint64_t> sessions_opened{0};
+    std::atomic<uint64_t> sessions_closed{0};
+    std::atomic<uint64_t> sessions_rejected{0};
+    std::atomic<uint64_t> messages_dropped{0};
+    void reset() {
+        sessions_opened = 0;
+        sessions_closed = 0;
+        sessions_rejected = 0;
+        messages_dropped = 0;
+    }
+};
+class FixSessionCodec : public GatewayCodec, public FixMessageHandler {
+public:
+    static constexpr uint64_t TIMER_INTERVAL_NS = 10000000ull;
+private:
+    class Transport : public FixTransport {
+    private:
+        FixSessionCodec& codec_;
+        FixConnectionId connection_id_;
+    public:
+        Transport(FixSessionCodec& codec, FixConnectionId connection_id)
+            : codec_(codec), connection_id_(connection_id) {}
+        bool send(const char* data, size_t length) override { return codec_.transmit(connection_id_, data, length); }
+        void disconnect() override { codec_.disconnect(connection_id_); }
+    };
+    struct Session {
+        std::recursive_mutex mutex;
+        std::unique_ptr<Transport> transport;
+        std::unique_ptr<FixSessionEngine> engine;
+        std::atomic<bool> open{false};
+    };
+    FixParser& parser_;
+    FixSessionConfig config_;
+    FixMessageHandler& application_;
+    FixDropCopyLog* drop_copy_;
+    std::atomic<FixGateway*> gateway_;
+    std::unique_ptr<Session[]> sessions_;
+    uint64_t next_timer_ns_;
+    FixSessionCodecStats stats_;
+public:
+    FixSessionCodec(FixParser& parser, const FixSessionConfig& config, FixMessageHandler& application,
+                    FixDropCopyLog* drop_copy = nullptr);
+    FixSessionCodec(const FixSessionCodec&) = delete;
+    FixSessionCodec& operator=(const FixSessionCodec&) = delete;
+    void attach(FixGateway* gateway) { gateway_.store(gateway, std::memory_order_release); }
+    bool ready() const override { return parser_.is_running() && parser_.is_inline(); }
+    FixConnectionId open_connection() override;
+    bool on_data(FixConnectionId connection_id, const char* data, size_t length) override;
+    void close_connection(FixConnectionId connection_id) override;
+    void on_timer(uint64_t now_ns) override;
+    void on_message(FixSessionId session_id, const FixMessageView& message) override;
+    void on_reject(FixFrameStatus status, const char* data, size_t length) override {
+        application_.on_reject(status, data, length);
+    }
+    template<typename Message>
+    bool send(FixConnectionId connection_id, const Message& message) {
+        Session* session = find_session(connection_id);
+        if (!session) {
+            return false;
+        }
+        std::lock_guard<std::recursive_mutex> lock(session->mutex);
+        if (!session->open.load(std::memory_order_relaxed) || !session->engine->send(message)) {
+            stats_.messages_dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        return true;
+    }
+    const FixSessionCodecStats& get_stats() const { return stats_; }
+    void reset_stats() { stats_.reset(); }
+private:
+    Session* find_session(FixConnectionId connection_id) const {
+        return connection_id < FixGateway::MAX_CONNECTIONS ? &sessions_[connection_id] : nullptr;
+    }
+    bool transmit(FixConnectionId connection_id, const char* data, size_t length);
+    void disconnect(FixConnectionId connection_id);
+};
+}
+}
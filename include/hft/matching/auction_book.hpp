@@ -0,0 +1,79 @@
+#pragma once
+#include "hft/core/types.hpp"
+#include "hft/order/order.hpp"
+#include <unordered_map>
+#include <vector>
+namespace hft {
+namespace matching {
+enum class TradingPhase : uint8_t {
+    CONTINUOUS,
+    AUCTION
+};
+struct AuctionOrder {
+    core::OrderID id;
+    core::Price price;
+    core::Quantity quantity;
+    uint32_t level;
+    core::Side side;
+    bool is_market;
+};
+struct AuctionEquilibrium {
+    core::Price price = 0.0;
+    core::Quantity executable_quantity = 0;
+    core::Quantity bid_surplus = 0;
+    core::Quantity ask_surplus = 0;
+    size_t price_levels = 0;
+    bool valid = false;
+};
+struct AuctionMatch {
+    uint32_t bid_index;
+    uint32_t ask_index;
+    core::Quantity quantity;
+};
+struct AuctionResult {
+    core::Symbol symbol;
+    AuctionEquilibrium equilibrium;
+    size_t orders_accumulated = 0;
+    size_t orders_executed = 0;
+    size_t fills = 0;
+    double price_discovery_ns = 0.0;
+    double execution_ns = 0.0;
+};
+class AuctionBook {
+private:
+    struct Level {
+        core::Price price;
+        core::Quantity bid_quantity;
+        core::Quantity ask_quantity;
+    };
+    core::Symbol symbol_;
+    std::vector<AuctionOrder> orders_;
+    std::unordered_map<core::OrderID, uint32_t> order_index_;
+    std::vector<Level> levels_;
+    std::unordered_map<core::Price, uint32_t> level_index_;
+    core::Quantity market_bid_quantity_;
+    core::Quantity market_ask_quantity_;
+    std::vector<core::Quantity> executed_;
+    mutable std::vector<uint32_t> sorted_levels_;
+    mutable std::vector<core::Price> sorted_prices_;
+    mutable std::vector<core::Quantity> cumulative_demand_;
+    mutable std::vector<core::Quantity> cumulative_supply_;
+    mutable std::vector<core::Quantity> executable_;
+    mutable std::vector<core::Quantity> imbalance_;
+public:
+    explicit AuctionBook(const core::Symbol& symbol);
+    void add_order(const order::Order& order);
+    bool cancel_order(core::OrderID order_id);
+    AuctionEquilibrium compute_equilibrium(core::Price reference_price) const;
+    std::vector<AuctionMatch> execute(const AuctionEquilibrium& equilibrium);
+    const std::vector<AuctionOrder>& get_orders() const { return orders_; }
+    const std::vector<core::Quantity>& get_executed_quantities() const { return executed_; }
+    size_t order_count() const { return order_index_.size(); }
+    const core::Symbol& get_symbol() const { return symbol_; }
+    void reserve(size_t order_capacity);
+    void clear();
+private:
+    void sort_levels() const;
+};
+}
+}
@@ -0,0 +1,181 @@
+#pragma once
+#include "hft/core/types.hpp"
+#include <atomic>
+#include <array>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+namespace hft {
+namespace matching {
+enum class MarketDataUpdateType : uint8_t {
+    ADD_LEVEL = 1,
+    MODIFY_LEVEL = 2,
+    DELETE_LEVEL = 3,
+    TRADE = 4,
+    AUCTION_TRADE = 5
+};
+struct MarketDataUpdate {
+    uint64_t symbol_sequence;
+    uint64_t timestamp_ns;
+    core::OrderID order_id;
+    core::OrderID contra_order_id;
+    core::Price price;
+    core::Quantity quantity;
+    uint32_t symbol_id;
+    MarketDataUpdateType type;
+    core::Side side;
+};
+struct alignas(64) MarketDataSlot {
+    std::atomic<uint64_t> version{0};
+    MarketDataUpdate update{};
+};
+enum class MarketDataPollResult : uint8_t {
+    UPDATE,
+    EMPTY,
+    OVERRUN
+};
+class MarketDataRing {
+private:
+    std::unique_ptr<MarketDataSlot[]> slots_;
+    size_t capacity_;
+    size_t mask_;
+    alignas(64) std::atomic<uint64_t> published_sequence_{0};
+    alignas(64) uint64_t next_sequence_{1};
+public:
+    explicit MarketDataRing(size_t capacity);
+    MarketDataRing(const MarketDataRing&) = delete;
+    MarketDataRing& operator=(const MarketDataRing&) = delete;
+    size_t capacity() const { return capacity_; }
+    uint64_t published_sequence() const { return published_sequence_.load(std::memory_order_acquire); }
+    void publish(const MarketDataUpdate& update) {
+        const uint64_t sequence = next_sequence_++;
+        MarketDataSlot& slot = slots_[sequence & mask_];
+        slot.version.store((sequence << 1) | 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        slot.update = update;
+        slot.version.store(sequence << 1, std::memory_order_release);
+        published_sequence_.store(sequence, std::memory_order_release);
+    }
+    MarketDataPollResult read(uint64_t sequence, MarketDataUpdate& update) const {
+        const MarketDataSlot& slot = slots_[sequence & mask_];
+        const uint64_t expected = sequence << 1;
+        const uint64_t before = slot.version.load(std::memory_order_acquire);
+        if (before != expected) {
+            return before < expected || before == (expected | 1) ? MarketDataPollResult::EMPTY
+                                                                   : MarketDataPollResult::OVERRUN;
+        }
+        update = slot.update;
+        std::atomic_thread_fence(std::memory_order_acquire);
+        const uint64_t after = slot.version.load(std::memory_order_relaxed);
+        return after == expected ? MarketDataPollResult::UPDATE : MarketDataPollResult::OVERRUN;
+    }
+};
+class MarketDataSubscriber {
+private:
+    const MarketDataRing* ring_;
+    uint64_t next_sequence_;
+    uint64_t overruns_;
+public:
+    explicit MarketDataSubscriber(const MarketDataRing& ring)
+        : ring_(&ring), next_sequence_(ring.published_sequence() + 1), overruns_(0) {}
+    MarketDataPollResult poll(MarketDataUpdate& update) {
+        MarketDataPollResult result = ring_->read(next_sequence_, update);
+        if (result == MarketDataPollResult::UPDATE) {
+            ++next_sequence_;
+        } else if (result == MarketDataPollResult::OVERRUN) {
+            ++overruns_;
+            const uint64_t latest = ring_->published_sequence();
+            next_sequence_ = latest >= ring_->capacity() / 2 ? latest - ring_->capacity() / 2 + 1 : 1;
+        }
+        return result;
+    }
+    template<typename Handler>
+    size_t poll_batch(Handler&& handler, size_t max_updates) {
+        MarketDataUpdate update;
+        size_t count = 0;
+        while (count < max_updates) {
+            MarketDataPollResult result = poll(update);
+            if (result == MarketDataPollResult::EMPTY) break;
+            if (result == MarketDataPollResult::OVERRUN) continue;
+            handler(update);
+            ++count;
+        }
+        return count;
+    }
+    uint64_t next_sequence() const { return next_sequence_; }
+    uint64_t overruns() const { return overruns_; }
+    uint64_t lag() const { return ring_->published_sequence() + 1 - next_sequence_; }
+};
+class SymbolDirectory {
+public:
+    static constexpr uint32_t MAX_SYMBOLS = 1024;
+    static constexpr uint32_t INVALID_SYMBOL_ID = 0xFFFFFFFFu;
+private:
+    static constexpr size_t SLOT_COUNT = MAX_SYMBOLS * 2;
+    std::array<core::Symbol, MAX_SYMBOLS> names_;
+    std::array<std::atomic<uint32_t>, SLOT_COUNT> slots_{};
+    std::atomic<uint32_t> count_{0};
+    std::mutex assign_mutex_;
+public:
+    uint32_t get_or_assign(const core::Symbol& symbol);
+    uint32_t find(const core::Symbol& symbol) const;
+    std::string_view name(uint32_t symbol_id) const;
+    uint32_t size() const { return count_.load(std::memory_order_acquire); }
+};
+class MarketDataBookBuilder {
+public:
+    struct LocalBook {
+        std::map<core::Price, core::Quantity, std::greater<core::Price>> bids;
+        std::map<core::Price, core::Quantity, std::less<core::Price>> asks;
+        uint64_t last_sequence = 0;
+        core::Price last_trade_price = 0.0;
+        core::Quantity last_trade_quantity = 0;
+        bool stale = false;
+        core::Price best_bid() const { return bids.empty() ? 0.0 : bids.begin()->first; }
+        core::Price best_ask() const { return asks.empty() ? 0.0 : asks.begin()->first; }
+    };
+private:
+    std::vector<LocalBook> books_;
+    uint64_t gaps_detected_ = 0;
+public:
+    void apply(const MarketDataUpdate& update);
+    void reset(uint32_t symbol_id);
+    const LocalBook* get_book(uint32_t symbol_id) const;
+    uint64_t gaps_detected() const { return gaps_detected_; }
+};
+class MarketDataPublisher {
+public:
+    static constexpr size_t DEFAULT_RING_CAPACITY = 65536;
+private:
+    struct SymbolState {
+        uint64_t sequence = 0;
+        std::unordered_map<core::Price, core::Quantity> bid_levels;
+        std::unordered_map<core::Price, core::Quantity> ask_levels;
+    };
+    MarketDataRing ring_;
+    SymbolDirectory& symbols_;
+    std::vector<SymbolState> symbol_states_;
+public:
+    explicit MarketDataPublisher(SymbolDirectory& symbols, size_t ring_capacity = DEFAULT_RING_CAPACITY);
+    MarketDataPublisher(const MarketDataPublisher&) = delete;
+    MarketDataPublisher& operator=(const MarketDataPublisher&) = delete;
+    uint32_t symbol_id(const core::Symbol& symbol) { return symbols_.get_or_assign(symbol); }
+    void publish_level_delta(uint32_t symbol_id, core::Side side, core::Price price,
+                             int64_t quantity_delta, core::OrderID order_id, core::TimePoint timestamp);
+    void publish_trade(uint32_t symbol_id, core::Side aggressor_side, core::Price price,
+                       core::Quantity quantity, core::OrderID aggressive_order_id,
+                       core::OrderID passive_order_id, core::TimePoint timestamp);
+    void publish_auction_trade(uint32_t symbol_id, core::Price price, core::Quantity quantity,
+                               core::OrderID buy_order_id, core::OrderID sell_order_id, core::TimePoint timestamp);
+    MarketDataSubscriber subscribe() const { return MarketDataSubscriber(ring_); }
+    const SymbolDirectory& symbols() const { return symbols_; }
+    const MarketDataRing& ring() const { return ring_; }
+private:
+    void publish(uint32_t symbol_id, MarketDataUpdate& update);
+};
+}
+}
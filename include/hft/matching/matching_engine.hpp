@@ -3,9 +3,18 @@
 #include "hft/core/lock_free_queue.hpp"
 #include "hft/core/async_logger.hpp"
 #include "hft/core/memory_optimized_segment_tree.hpp"
+#include "hft/core/wait_strategy.hpp"
+#include "hft/matching/auction_book.hpp"
+#include "hft/matching/market_data_publisher.hpp"
+#include "hft/matching/matching_stats.hpp"
+#include "hft/matching/top_of_book.hpp"
 #include "hft/order/order.hpp"
 #include "hft/order/order_book.hpp"
+#include <array>
+#include <deque>
+#include <future>
 #include <memory>
+#include <mutex>
 #include <vector>
 #include <unordered_map>
 #include <functional>
@@ -47,28 +56,6 @@ struct ExecutionReport {
           remaining_quantity(order.remaining_quantity()), avg_executed_price(0.0),
           timestamp(order.timestamp) {}
 };
-struct MatchingStats {
-    std::atomic<uint64_t> orders_processed{0};
-    std::atomic<uint64_t> orders_matched{0};
-    std::atomic<uint64_t> orders_rejected{0};
-    std::atomic<uint64_t> total_fills{0};
-    std::atomic<double> total_volume{0.0};
-    std::atomic<double> total_notional{0.0};
-    std::atomic<double> avg_matching_latency_ns{0.0};
-    std::atomic<double> max_matching_latency_ns{0.0};
-    std::atomic<uint64_t> matching_operations{0};
-    void reset() {
-        orders_processed = 0;
-        orders_matched = 0;
-        orders_rejected = 0;
-        total_fills = 0;
-        total_volume = 0.0;
-        total_notional = 0.0;
-        avg_matching_latency_ns = 0.0;
-        max_matching_latency_ns = 0.0;
-        matching_operations = 0;
-    }
-};
 enum class MatchingAlgorithm {
     PRICE_TIME_PRIORITY,
     PRO_RATA,
@@ -80,7 +67,28 @@ public:
     using ExecutionCallback = std::function<void(const ExecutionReport&)>;
     using FillCallback = std::function<void(const Fill&)>;
     using ErrorCallback = std::function<void(const std::string&, const std::string&)>;
+    using BackpressureCallback = std::function<void(size_t queue_depth, bool engaged)>;
 private:
+    struct SegmentTreeLevels {
+        std::unordered_map<core::Price, core::Quantity> bids;
+        std::unordered_map<core::Price, core::Quantity> asks;
+    };
+    enum class CommandType : uint8_t {
+        OPEN_AUCTION,
+        UNCROSS_AUCTION,
+        CANCEL_ORDER,
+        MODIFY_ORDER
+    };
+    struct EngineCommand {
+        CommandType type;
+        core::Symbol symbol;
+        core::Price reference_price = 0.0;
+        core::OrderID order_id = 0;
+        core::Price price = 0.0;
+        core::Quantity quantity = 0;
+        uint64_t order_barrier = 0;
+        std::promise<AuctionResult> result;
+    };
     static constexpr size_t ORDER_QUEUE_SIZE = 65536;
     static constexpr size_t MAX_SYMBOLS = 1000;
     std::unordered_map<core::Symbol, std::unique_ptr<order::OrderBook>> order_books_;
@@ -94,10 +102,27 @@ private:
     ExecutionCallback execution_callback_;
     FillCallback fill_callback_;
     ErrorCallback error_callback_;
-    MatchingStats stats_;
+    BackpressureCallback backpressure_callback_;
+    core::WaitStrategyConfig wait_config_;
+    core::Doorbell order_doorbell_;
+    alignas(64) std::atomic<uint64_t> orders_enqueued_{0};
+    alignas(64) std::atomic<uint64_t> orders_dequeued_{0};
+    std::atomic<bool> backpressure_active_{false};
+    size_t high_watermark_;
+    size_t low_watermark_;
+    MatchingCounters counters_;
     std::unordered_map<core::OrderID, order::Order> active_orders_;
     std::atomic<core::OrderID> next_execution_id_{1};
     std::unique_ptr<core::AsyncLogger> logger_;
+    SymbolDirectory symbol_directory_;
+    std::unique_ptr<MarketDataPublisher> market_data_publisher_;
+    std::unique_ptr<TopOfBookCache> top_of_book_;
+    std::vector<SegmentTreeLevels> segment_tree_levels_;
+    std::array<std::atomic<TradingPhase>, SymbolDirectory::MAX_SYMBOLS> trading_phases_{};
+    std::vector<std::unique_ptr<AuctionBook>> auction_books_;
+    std::mutex command_mutex_;
+    std::deque<EngineCommand> pending_commands_;
+    std::atomic<bool> commands_pending_{false};
 public:
     explicit MatchingEngine(MatchingAlgorithm algorithm = MatchingAlgorithm::PRICE_TIME_PRIORITY,
                            const std::string& log_path = "logs/engine_logs.log",
@@ -111,6 +136,22 @@ public:
     void set_fill_callback(FillCallback callback);
     void set_error_callback(ErrorCallback callback);
     void set_matching_algorithm(MatchingAlgorithm algorithm);
+    void set_wait_strategy(const core::WaitStrategyConfig& config);
+    const core::WaitStrategyConfig& get_wait_strategy() const { return wait_config_; }
+    void set_backpressure_callback(BackpressureCallback callback, size_t high_watermark, size_t low_watermark);
+    size_t get_queue_depth() const;
+    size_t get_queue_capacity() const { return ORDER_QUEUE_SIZE; }
+    bool is_backpressured() const { return backpressure_active_.load(std::memory_order_relaxed); }
+    void enable_market_data(size_t ring_capacity = MarketDataPublisher::DEFAULT_RING_CAPACITY);
+    MarketDataPublisher* get_market_data_publisher() { return market_data_publisher_.get(); }
+    const MarketDataPublisher* get_market_data_publisher() const { return market_data_publisher_.get(); }
+    void enable_top_of_book();
+    const TopOfBookCache* get_top_of_book() const { return top_of_book_.get(); }
+    TopOfBookSampler create_top_of_book_sampler() const;
+    const SymbolDirectory& get_symbol_directory() const { return symbol_directory_; }
+    bool set_trading_phase(const core::Symbol& symbol, TradingPhase phase);
+    TradingPhase get_trading_phase(const core::Symbol& symbol) const;
+    std::future<AuctionResult> uncross_auction(const core::Symbol& symbol, core::Price reference_price);
     void start();
     void stop();
     bool is_running() const { return running_.load(); }
@@ -120,8 +161,8 @@ public:
     order::OrderBook* get_order_book(const core::Symbol& symbol);
     const order::OrderBook* get_order_book(const core::Symbol& symbol) const;
     std::vector<core::Symbol> get_symbols() const;
-    const MatchingStats& get_stats() const { return stats_; }
-    void reset_stats() { stats_.reset(); }
+    MatchingStats get_stats() const { return counters_.snapshot(symbol_directory_); }
+    void reset_stats() { counters_.reset(symbol_directory_); }
     bool has_order(core::OrderID order_id) const;
     order::Order get_order(core::OrderID order_id) const;
     std::vector<order::Order> get_orders_for_symbol(const core::Symbol& symbol) const;
@@ -147,6 +188,24 @@ private:
     void store_segment_tree_order(const order::Order& order);
     void update_segment_tree_order(const order::Order& order);
     void remove_segment_tree_order(core::OrderID order_id);
+    void publish_book_delta(const core::Symbol& symbol, core::Side side, core::Price price,
+                            int64_t quantity_delta, core::OrderID order_id);
+    void publish_fills(const order::Order& aggressive_order, const std::vector<Fill>& fills);
+    void publish_top_of_book(const core::Symbol& symbol);
+    void track_segment_tree_level(const core::Symbol& symbol, core::Side side, core::Price price,
+                                  int64_t quantity_delta);
+    void post_command(EngineCommand command);
+    void run_pending_commands(uint64_t orders_processed);
+    void execute_command(EngineCommand& command);
+    bool execute_cancel(core::OrderID order_id);
+    bool execute_modify(core::OrderID order_id, core::Price new_price, core::Quantity new_quantity);
+    bool remove_live_order(core::OrderID order_id, order::Order& removed);
+    void open_auction(const core::Symbol& symbol);
+    AuctionResult execute_uncross(const core::Symbol& symbol, core::Price reference_price);
+    AuctionBook* find_auction_book(uint32_t symbol_id) const;
+    AuctionBook* find_auction_book(const core::Symbol& symbol) const;
+    void accumulate_auction_order(AuctionBook& auction, const order::Order& order, uint32_t symbol_id);
+    void move_resting_orders_to_auction(const core::Symbol& symbol, AuctionBook& auction);
     void update_order_status(order::Order& order, const std::vector<Fill>& fills);
     ExecutionReport create_execution_report(const order::Order& order,
                                           const std::vector<Fill>& fills);
@@ -154,8 +213,9 @@ private:
     bool validate_order(const order::Order& order) const;
     bool validate_price(core::Price price) const;
     bool validate_quantity(core::Quantity quantity) const;
-    void update_matching_latency(double latency_ns);
-    void record_fill(const Fill& fill);
+    void record_fills(uint32_t symbol_id, const std::vector<Fill>& fills);
+    void on_order_enqueued();
+    void on_order_dequeued();
     bool perform_risk_checks(const order::Order& order) const;
     bool check_position_limits(const order::Order& order) const;
     bool check_order_limits(const order::Order& order) const;
@@ -173,6 +233,8 @@ private:
     std::unordered_map<core::Symbol, double> unrealized_pnl_;
     std::unordered_map<core::Symbol, std::pair<core::OrderID, core::OrderID>> active_quotes_;
     std::atomic<core::OrderID> next_quote_id_{1000000};
+    std::unique_ptr<MarketDataSubscriber> market_data_subscriber_;
+    MarketDataBookBuilder local_books_;
 public:
     explicit MarketMakingEngine(double spread_bps = 5.0, core::Quantity default_size = 100);
     ~MarketMakingEngine();
@@ -189,6 +251,8 @@ public:
     double get_total_pnl() const;
     void on_market_data_update(const core::MarketDataTick& tick);
     void on_trade_execution(const ExecutionReport& execution);
+    size_t poll_market_data(size_t max_updates = 4096);
+    const MarketDataBookBuilder::LocalBook* get_local_book(const core::Symbol& symbol) const;
 private:
     std::pair<core::Price, core::Price> calculate_quote_prices(const core::Symbol& symbol,
                                                               core::Price reference_price);
@@ -0,0 +1,167 @@
+#pragma once
+#include "hft/core/types.hpp"
+#include "hft/matching/market_data_publisher.hpp"
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+namespace hft {
+namespace matching {
+enum class RejectReason : uint8_t {
+    VALIDATION,
+    RISK_CHECK,
+    QUEUE_FULL,
+    COUNT
+};
+constexpr size_t REJECT_REASON_COUNT = static_cast<size_t>(RejectReason::COUNT);
+struct SymbolStats {
+    core::Symbol symbol;
+    uint64_t orders_processed = 0;
+    uint64_t orders_matched = 0;
+    uint64_t fills = 0;
+    uint64_t volume = 0;
+    double notional = 0.0;
+};
+struct MatchingStats {
+    uint64_t orders_processed = 0;
+    uint64_t orders_matched = 0;
+    uint64_t orders_rejected = 0;
+    uint64_t total_fills = 0;
+    double total_volume = 0.0;
+    double total_notional = 0.0;
+    double avg_matching_latency_ns = 0.0;
+    double max_matching_latency_ns = 0.0;
+    uint64_t matching_operations = 0;
+    uint64_t queue_full_events = 0;
+    uint64_t backpressure_events = 0;
+    uint64_t peak_queue_depth = 0;
+    std::array<uint64_t, REJECT_REASON_COUNT> rejects_by_reason{};
+    std::vector<SymbolStats> symbols;
+};
+struct alignas(64) SymbolCounters {
+    std::atomic<uint64_t> orders_processed{0};
+    std::atomic<uint64_t> orders_matched{0};
+    std::atomic<uint64_t> fills{0};
+    std::atomic<uint64_t> volume{0};
+    std::atomic<double> notional{0.0};
+};
+struct alignas(64) ThreadCounters {
+    std::thread::id owner;
+    const bool shared;
+    const std::atomic<uint64_t>* reset_generation;
+    std::atomic<uint64_t> applied_generation;
+    std::array<std::atomic<uint64_t>, REJECT_REASON_COUNT> rejects{};
+    std::atomic<uint64_t> backpressure_events{0};
+    std::atomic<uint64_t> peak_queue_depth{0};
+    std::atomic<uint64_t> matching_operations{0};
+    std::atomic<double> latency_sum_ns{0.0};
+    std::atomic<double> max_latency_ns{0.0};
+    std::unique_ptr<SymbolCounters[]> symbols;
+    ThreadCounters(std::thread::id thread_id, const std::atomic<uint64_t>& generation, bool shared_shard = false)
+        : owner(thread_id), shared(shared_shard), reset_generation(&generation),
+          applied_generation(generation.load(std::memory_order_acquire)),
+          symbols(std::make_unique<SymbolCounters[]>(SymbolDirectory::MAX_SYMBOLS)) {}
+    template<typename T>
+    void add(std::atomic<T>& counter, T delta) {
+        if (shared) {
+            counter.fetch_add(delta, std::memory_order_relaxed);
+        } else {
+            counter.store(counter.load(std::memory_order_relaxed) + delta, std::memory_order_relaxed);
+        }
+    }
+    template<typename T>
+    void raise(std::atomic<T>& counter, T value) {
+        T current = counter.load(std::memory_order_relaxed);
+        if (!shared) {
+            if (value > current) counter.store(value, std::memory_order_relaxed);
+            return;
+        }
+        while (value > current && !counter.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+        }
+    }
+    void apply_pending_reset() {
+        if (shared) return;
+        const uint64_t generation = reset_generation->load(std::memory_order_acquire);
+        if (generation != applied_generation.load(std::memory_order_relaxed)) {
+            peak_queue_depth.store(0, std::memory_order_relaxed);
+            max_latency_ns.store(0.0, std::memory_order_relaxed);
+            applied_generation.store(generation, std::memory_order_release);
+        }
+    }
+    void record_reject(RejectReason reason) { add<uint64_t>(rejects[static_cast<size_t>(reason)], 1); }
+    void record_backpressure() { add<uint64_t>(backpressure_events, 1); }
+    void record_queue_depth(uint64_t depth) {
+        apply_pending_reset();
+        raise<uint64_t>(peak_queue_depth, depth);
+    }
+    void record_order(uint32_t symbol_id, bool matched) {
+        if (symbol_id >= SymbolDirectory::MAX_SYMBOLS) return;
+        SymbolCounters& counters = symbols[symbol_id];
+        add<uint64_t>(counters.orders_processed, 1);
+        if (matched) add<uint64_t>(counters.orders_matched, 1);
+    }
+    void record_matched(uint32_t symbol_id, uint64_t count) {
+        if (symbol_id >= SymbolDirectory::MAX_SYMBOLS) return;
+        add<uint64_t>(symbols[symbol_id].orders_matched, count);
+    }
+    void record_fill(uint32_t symbol_id, core::Price price, core::Quantity quantity) {
+        if (symbol_id >= SymbolDirectory::MAX_SYMBOLS) return;
+        SymbolCounters& counters = symbols[symbol_id];
+        add<uint64_t>(counters.fills, 1);
+        add<uint64_t>(counters.volume, quantity);
+        add<double>(counters.notional, price * static_cast<double>(quantity));
+    }
+    void record_latency(double latency_ns) {
+        apply_pending_reset();
+        add<uint64_t>(matching_operations, 1);
+        add<double>(latency_sum_ns, latency_ns);
+        raise<double>(max_latency_ns, latency_ns);
+    }
+};
+class MatchingCounters {
+public:
+    static constexpr size_t MAX_THREADS = 256;
+private:
+    std::array<std::unique_ptr<ThreadCounters>, MAX_THREADS> shards_;
+    std::atomic<size_t> shard_count_{0};
+    std::mutex registration_mutex_;
+    const uint64_t instance_id_;
+    std::atomic<uint64_t> reset_generation_{0};
+    std::unique_ptr<ThreadCounters> overflow_shard_;
+    std::atomic<bool> overflow_reported_{false};
+    mutable std::mutex baseline_mutex_;
+    MatchingStats baseline_;
+public:
+    MatchingCounters();
+    MatchingCounters(const MatchingCounters&) = delete;
+    MatchingCounters& operator=(const MatchingCounters&) = delete;
+    ThreadCounters& local() {
+        struct CacheEntry {
+            uint64_t instance_id;
+            ThreadCounters* shard;
+        };
+        static constexpr size_t CACHE_ENTRIES = 8;
+        thread_local std::array<CacheEntry, CACHE_ENTRIES> cache{};
+        thread_local size_t next_victim = 0;
+        for (const auto& entry : cache) {
+            if (entry.instance_id == instance_id_) {
+                return *entry.shard;
+            }
+        }
+        ThreadCounters& shard = register_thread();
+        cache[next_victim] = CacheEntry{instance_id_, &shard};
+        next_victim = (next_victim + 1) % CACHE_ENTRIES;
+        return shard;
+    }
+    MatchingStats snapshot(const SymbolDirectory& symbols) const;
+    void reset(const SymbolDirectory& symbols);
+    size_t thread_count() const { return shard_count_.load(std::memory_order_acquire); }
+private:
+    ThreadCounters& register_thread();
+    MatchingStats collect(const SymbolDirectory& symbols) const;
+    void collect_shard(const ThreadCounters& shard, MatchingStats& stats, double& latency_sum_ns) const;
+};
+}
+}
@@ -0,0 +1,109 @@
+#pragma once
+#include "hft/core/types.hpp"
+#include "hft/matching/market_data_publisher.hpp"
+#include <atomic>
+#include <memory>
+#include <vector>
+namespace hft {
+namespace matching {
+struct TopOfBook {
+    core::Price bid_price = 0.0;
+    core::Price ask_price = 0.0;
+    core::Quantity bid_quantity = 0;
+    core::Quantity ask_quantity = 0;
+    uint64_t timestamp_ns = 0;
+    core::Price mid_price() const {
+        return (bid_price > 0.0 && ask_price > 0.0) ? (bid_price + ask_price) / 2.0 : 0.0;
+    }
+    bool operator==(const TopOfBook& other) const {
+        return bid_price == other.bid_price && ask_price == other.ask_price &&
+               bid_quantity == other.bid_quantity && ask_quantity == other.ask_quantity;
+    }
+};
+struct alignas(64) TopOfBookSlot {
+    std::atomic<uint64_t> version{0};
+    TopOfBook value{};
+};
+class TopOfBookCache {
+private:
+    std::unique_ptr<TopOfBookSlot[]> slots_;
+    std::vector<TopOfBook> last_written_;
+public:
+    TopOfBookCache()
+        : slots_(std::make_unique<TopOfBookSlot[]>(SymbolDirectory::MAX_SYMBOLS)),
+          last_written_(SymbolDirectory::MAX_SYMBOLS) {}
+    TopOfBookCache(const TopOfBookCache&) = delete;
+    TopOfBookCache& operator=(const TopOfBookCache&) = delete;
+    bool update(uint32_t symbol_id, const TopOfBook& top) {
+        if (symbol_id >= SymbolDirectory::MAX_SYMBOLS || last_written_[symbol_id] == top) {
+            return false;
+        }
+        last_written_[symbol_id] = top;
+        TopOfBookSlot& slot = slots_[symbol_id];
+        const uint64_t version = slot.version.load(std::memory_order_relaxed);
+        slot.version.store(version + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        slot.value = top;
+        slot.version.store(version + 2, std::memory_order_release);
+        return true;
+    }
+    uint64_t version(uint32_t symbol_id) const {
+        return symbol_id < SymbolDirectory::MAX_SYMBOLS
+            ? slots_[symbol_id].version.load(std::memory_order_acquire) : 0;
+    }
+    bool read(uint32_t symbol_id, TopOfBook& top, uint64_t* version_out = nullptr) const {
+        if (symbol_id >= SymbolDirectory::MAX_SYMBOLS) {
+            return false;
+        }
+        const TopOfBookSlot& slot = slots_[symbol_id];
+        for (;;) {
+            const uint64_t before = slot.version.load(std::memory_order_acquire);
+            if (before == 0) {
+                return false;
+            }
+            if (before & 1) {
+                continue;
+            }
+            top = slot.value;
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (slot.version.load(std::memory_order_relaxed) == before) {
+                if (version_out) {
+                    *version_out = before;
+                }
+                return true;
+            }
+        }
+    }
+};
+class TopOfBookSampler {
+private:
+    const TopOfBookCache* cache_;
+    const SymbolDirectory* symbols_;
+    std::vector<uint64_t> seen_versions_;
+public:
+    TopOfBookSampler(const TopOfBookCache& cache, const SymbolDirectory& symbols)
+        : cache_(&cache), symbols_(&symbols), seen_versions_(SymbolDirectory::MAX_SYMBOLS, 0) {}
+    template<typename Handler>
+    size_t poll_changed(Handler&& handler) {
+        const uint32_t symbol_count = symbols_->size();
+        size_t changed = 0;
+        TopOfBook top;
+        for (uint32_t symbol_id = 0; symbol_id < symbol_count; ++symbol_id) {
+            if (cache_->version(symbol_id) == seen_versions_[symbol_id]) {
+                continue;
+            }
+            uint64_t version = 0;
+            if (cache_->read(symbol_id, top, &version)) {
+                seen_versions_[symbol_id] = version;
+                handler(symbols_->name(symbol_id), top);
+                ++changed;
+            }
+        }
+        return changed;
+    }
+    bool read(const core::Symbol& symbol, TopOfBook& top) const {
+        return cache_->read(symbols_->find(symbol), top);
+    }
+};
+}
+}
@@ -36,6 +36,14 @@ void PnLCalculator::update_market_prices(const std::unordered_map<Symbol, Price>
         update_market_price(symbol, price);
     }
 }
+size_t PnLCalculator::update_market_prices(matching::TopOfBookSampler& sampler) {
+    return sampler.poll_changed([this](std::string_view symbol, const matching::TopOfBook& top) {
+        Price mid = top.mid_price();
+        if (mid > 0.0) {
+            update_market_price(Symbol(symbol), mid);
+        }
+    });
+}
 Position PnLCalculator::get_position(const Symbol& symbol) const {
     std::lock_guard<std::mutex> lock(positions_mutex_);
     auto it = positions_.find(symbol);
@@ -0,0 +1,228 @@
+#include "hft/order/order.hpp"
+#include "hft/matching/matching_engine.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <string>
+#include <vector>
+class AuctionBenchmark {
+private:
+    struct Expected {
+        hft::core::Price price = 0.0;
+        hft::core::Quantity executable_quantity = 0;
+    };
+    static constexpr const char* SYMBOL = "AUCT";
+    static constexpr int64_t REFERENCE_TICKS = 10000;
+    static constexpr size_t RESTING_ORDERS = 64;
+    static constexpr size_t CANCEL_STRIDE = 64;
+    std::vector<hft::order::Order> resting_;
+    std::vector<hft::order::Order> auction_;
+    size_t price_levels_;
+public:
+    AuctionBenchmark(size_t order_count, size_t price_levels) : price_levels_(std::max<size_t>(2, price_levels)) {
+        build_orders(order_count);
+    }
+    static bool cancelled_in_call(size_t index) {
+        return index % CANCEL_STRIDE == CANCEL_STRIDE - 1;
+    }
+    bool run() {
+        std::cout << "AUCTION UNCROSS BENCHMARK" << std::endl;
+        std::cout << "=========================" << std::endl;
+        std::cout << "Resting:   " << resting_.size() << " continuous orders moved into the call" << std::endl;
+        std::cout << "Auction:   " << auction_.size() << " orders over " << price_levels_ << " price levels" << std::endl;
+        const Expected expected = compute_expected();
+        const std::string log_path = (std::filesystem::temp_directory_path() / "auction_bench.log").string();
+        hft::matching::MatchingEngine engine(hft::matching::MatchingAlgorithm::PRICE_TIME_PRIORITY, log_path);
+        hft::core::WaitStrategyConfig wait_config;
+        wait_config.enqueue_timeout_ns = 1000000000ull;
+        engine.set_wait_strategy(wait_config);
+        engine.enable_top_of_book();
+        std::atomic<uint64_t> filled_quantity{0};
+        std::atomic<uint64_t> fill_count{0};
+        std::atomic<uint64_t> cancel_reports{0};
+        engine.set_execution_callback([&](const hft::matching::ExecutionReport& report) {
+            if (report.status == hft::core::OrderStatus::CANCELLED) {
+                cancel_reports.fetch_add(1, std::memory_order_relaxed);
+            }
+        });
+        engine.set_fill_callback([&](const hft::matching::Fill& fill) {
+            filled_quantity.fetch_add(fill.quantity, std::memory_order_relaxed);
+            fill_count.fetch_add(1, std::memory_order_relaxed);
+        });
+        engine.start();
+        size_t rejected = 0;
+        for (const auto& order : resting_) {
+            rejected += engine.submit_order(order) ? 0 : 1;
+        }
+        engine.set_trading_phase(SYMBOL, hft::matching::TradingPhase::AUCTION);
+        const auto submit_start = std::chrono::steady_clock::now();
+        size_t cancels = 0;
+        for (size_t i = 0; i < auction_.size(); ++i) {
+            rejected += engine.submit_order(auction_[i]) ? 0 : 1;
+            if (cancelled_in_call(i)) {
+                rejected += engine.cancel_order(auction_[i].id) ? 0 : 1;
+                ++cancels;
+            }
+        }
+        const size_t call_cancels = cancels;
+        const auto uncross_start = std::chrono::steady_clock::now();
+        std::future<hft::matching::AuctionResult> pending =
+            engine.uncross_auction(SYMBOL, static_cast<hft::core::Price>(REFERENCE_TICKS) / 100.0);
+        const hft::matching::AuctionResult result = pending.get();
+        const auto uncross_end = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < resting_.size(); i += 4) {
+            rejected += engine.cancel_order(resting_[i].id) ? 0 : 1;
+            rejected += engine.cancel_order(resting_[i + 1].id) ? 0 : 1;
+            cancels += 2;
+        }
+        const hft::matching::TradingPhase phase = engine.get_trading_phase(SYMBOL);
+        engine.stop();
+        engine.set_fill_callback(nullptr);
+        engine.set_execution_callback(nullptr);
+        const hft::order::OrderBook* book = engine.get_order_book(SYMBOL);
+        const hft::core::Price best_bid = book ? book->get_best_bid() : 0.0;
+        const hft::core::Price best_ask = book ? book->get_best_ask() : 0.0;
+        hft::matching::TopOfBook top;
+        const bool top_published = engine.create_top_of_book_sampler().read(SYMBOL, top);
+        const bool top_matches = top_published && book && top.bid_price == best_bid && top.ask_price == best_ask &&
+                                 top.bid_quantity == book->get_bid_quantity(best_bid) &&
+                                 top.ask_quantity == book->get_ask_quantity(best_ask);
+        std::filesystem::remove(log_path);
+        const double submit_ms = std::chrono::duration<double, std::milli>(uncross_start - submit_start).count();
+        const double wait_ms = std::chrono::duration<double, std::milli>(uncross_end - uncross_start).count();
+        std::cout << std::fixed << std::setprecision(2);
+        std::cout << "\nUncross" << std::endl;
+        std::cout << "  Equilibrium:     " << result.equilibrium.price << " for "
+                  << result.equilibrium.executable_quantity << " (expected " << expected.price << " for "
+                  << expected.executable_quantity << ")" << std::endl;
+        std::cout << "  Orders:          " << result.orders_accumulated << " accumulated, " << result.orders_executed
+                  << " executed, " << result.fills << " fills, " << cancels << " cancelled" << std::endl;
+        std::cout << "  Price discovery: " << result.price_discovery_ns / 1e6 << " ms" << std::endl;
+        std::cout << "  Execution:       " << result.execution_ns / 1e6 << " ms" << std::endl;
+        std::cout << "  Uncross total:   " << (result.price_discovery_ns + result.execution_ns) / 1e6 << " ms" << std::endl;
+        std::cout << "  Submit:          " << submit_ms << " ms, queue drain + uncross " << wait_ms << " ms" << std::endl;
+        std::cout << "  Book after:      " << best_bid << " / " << best_ask << " (top of book "
+                  << top.bid_price << " / " << top.ask_price << ")" << std::endl;
+        bool ok = true;
+        if (rejected != 0) {
+            std::cout << "WARNING: " << rejected << " orders rejected on submit" << std::endl;
+            ok = false;
+        }
+        if (!result.equilibrium.valid || result.equilibrium.price != expected.price ||
+            result.equilibrium.executable_quantity != expected.executable_quantity) {
+            std::cout << "WARNING: equilibrium differs from the reference computation" << std::endl;
+            ok = false;
+        }
+        if (result.orders_accumulated != resting_.size() + auction_.size() - call_cancels) {
+            std::cout << "WARNING: auction accumulated " << result.orders_accumulated << " orders" << std::endl;
+            ok = false;
+        }
+        if (filled_quantity.load() != result.equilibrium.executable_quantity || fill_count.load() != result.fills) {
+            std::cout << "WARNING: fills total " << filled_quantity.load() << " in " << fill_count.load()
+                      << " callbacks" << std::endl;
+            ok = false;
+        }
+        if (cancel_reports.load() != cancels) {
+            std::cout << "WARNING: " << cancel_reports.load() << " cancel reports for " << cancels
+                      << " cancels" << std::endl;
+            ok = false;
+        }
+        if (!top_matches) {
+            std::cout << "WARNING: top-of-book cache differs from the book after cancels" << std::endl;
+            ok = false;
+        }
+        if (phase != hft::matching::TradingPhase::CONTINUOUS || (best_bid > 0.0 && best_ask > 0.0 && best_bid >= best_ask)) {
+            std::cout << "WARNING: book left crossed or still in the call phase" << std::endl;
+            ok = false;
+        }
+        return ok;
+    }
+private:
+    static hft::core::Price tick_price(int64_t ticks) {
+        return static_cast<hft::core::Price>(ticks) / 100.0;
+    }
+    void build_orders(size_t order_count) {
+        const int64_t half_range = static_cast<int64_t>(price_levels_ / 2);
+        hft::core::OrderID next_id = 1;
+        resting_.reserve(RESTING_ORDERS);
+        for (size_t i = 0; i < RESTING_ORDERS; ++i) {
+            const bool buy = i % 2 == 0;
+            const int64_t offset = half_range + 1 + static_cast<int64_t>(i / 2);
+            resting_.emplace_back(next_id++, SYMBOL, buy ? hft::core::Side::BUY : hft::core::Side::SELL,
+                                  hft::core::OrderType::LIMIT, tick_price(REFERENCE_TICKS + (buy ? -offset : offset)),
+                                  100 + i);
+        }
+        uint64_t state = 0x9E3779B97F4A7C15ull;
+        auto next = [&state]() {
+            state ^= state << 13;
+            state ^= state >> 7;
+            state ^= state << 17;
+            return state;
+        };
+        auction_.reserve(order_count);
+        for (size_t i = 0; i < order_count; ++i) {
+            const bool buy = next() % 2 == 0;
+            const int64_t offset = static_cast<int64_t>(next() % price_levels_) - half_range;
+            const int64_t skew = buy ? half_range / 4 : -half_range / 4;
+            auction_.emplace_back(next_id++, SYMBOL, buy ? hft::core::Side::BUY : hft::core::Side::SELL,
+                                  hft::core::OrderType::LIMIT, tick_price(REFERENCE_TICKS + offset + skew),
+                                  1 + next() % 1000);
+        }
+    }
+    Expected compute_expected() const {
+        std::map<hft::core::Price, std::pair<hft::core::Quantity, hft::core::Quantity>> levels;
+        for (const auto* orders : {&resting_, &auction_}) {
+            for (size_t i = 0; i < orders->size(); ++i) {
+                if (orders == &auction_ && cancelled_in_call(i)) continue;
+                const hft::order::Order& order = (*orders)[i];
+                auto& level = levels[order.price];
+                (order.side == hft::core::Side::BUY ? level.first : level.second) += order.quantity;
+            }
+        }
+        const hft::core::Price reference = tick_price(REFERENCE_TICKS);
+        Expected best;
+        hft::core::Quantity best_imbalance = std::numeric_limits<hft::core::Quantity>::max();
+        for (const auto& [price, unused] : levels) {
+            hft::core::Quantity demand = 0;
+            hft::core::Quantity supply = 0;
+            for (const auto& [level_price, quantities] : levels) {
+                demand += level_price >= price ? quantities.first : 0;
+                supply += level_price <= price ? quantities.second : 0;
+            }
+            const hft::core::Quantity executable = std::min(demand, supply);
+            const hft::core::Quantity imbalance = demand > supply ? demand - supply : supply - demand;
+            if (executable == 0) continue;
+            if (executable > best.executable_quantity ||
+                (executable == best.executable_quantity &&
+                 (imbalance < best_imbalance ||
+                  (imbalance == best_imbalance && std::abs(price - reference) < std::abs(best.price - reference))))) {
+                best.price = price;
+                best.executable_quantity = executable;
+                best_imbalance = imbalance;
+            }
+        }
+        return best;
+    }
+};
+int main(int argc, char* argv[]) {
+    try {
+        const size_t order_count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+        const size_t price_levels = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 200;
+        if (order_count == 0 || price_levels == 0) {
+            std::cout << "Usage: " << argv[0] << " [orders] [price_levels]" << std::endl;
+            return 1;
+        }
+        AuctionBenchmark benchmark(order_count, price_levels);
+        return benchmark.run() ? 0 : 1;
+    } catch (const std::exception& e) {
+        std::cout << "❌ Error: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,406 @@
+#include "hft/backtesting/columnar_tick_store.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+namespace hft {
+namespace backtesting {
+namespace {
+constexpr char COLUMNAR_MAGIC[8] = {'H', 'F', 'T', 'C', 'O', 'L', 'T', '1'};
+constexpr size_t WIDE_COLUMNS = 8;
+enum WideColumn : size_t {
+    TIMESTAMP,
+    BID_PRICE,
+    ASK_PRICE,
+    LAST_PRICE,
+    BID_SIZE,
+    ASK_SIZE,
+    LAST_SIZE,
+    SEQUENCE_NUMBER
+};
+inline size_t align_up(size_t value, size_t alignment) {
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+inline size_t wide_column_offset(size_t column, size_t block_capacity) {
+    return column * block_capacity * sizeof(uint64_t);
+}
+inline size_t symbol_column_offset(size_t block_capacity) {
+    return WIDE_COLUMNS * block_capacity * sizeof(uint64_t);
+}
+inline uint64_t to_timestamp_ns(core::TimePoint time) {
+    const int64_t ns = std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+    return ns > 0 ? static_cast<uint64_t>(ns) : 0;
+}
+template<typename T>
+inline void put_column(char* block, size_t column_offset, size_t row, const T& value) {
+    std::memcpy(block + column_offset + row * sizeof(T), &value, sizeof(T));
+}
+}
+ColumnarTickWriter::ColumnarTickWriter()
+    : header_{}, block_fill_(0), write_offset_(0), last_timestamp_ns_(0) {}
+ColumnarTickWriter::~ColumnarTickWriter() {
+    close();
+}
+size_t ColumnarTickWriter::block_size(size_t block_capacity) {
+    return align_up(symbol_column_offset(block_capacity) + block_capacity * sizeof(uint16_t), BLOCK_ALIGNMENT);
+}
+bool ColumnarTickWriter::open(const std::string& path, size_t block_capacity) {
+    close();
+    if (block_capacity == 0 || block_capacity > UINT32_MAX) {
+        std::cerr << "Invalid columnar block capacity: " << block_capacity << std::endl;
+        return false;
+    }
+    file_.open(path, std::ios::binary | std::ios::trunc);
+    if (!file_.is_open()) {
+        std::cerr << "Failed to create columnar tick file: " << path << std::endl;
+        return false;
+    }
+    path_ = path;
+    header_ = ColumnarFileHeader{};
+    std::memcpy(header_.magic, COLUMNAR_MAGIC, sizeof(COLUMNAR_MAGIC));
+    header_.version = FORMAT_VERSION;
+    header_.block_capacity = static_cast<uint32_t>(block_capacity);
+    header_.block_size = block_size(block_capacity);
+    header_.time_ordered = 1;
+    block_.assign(header_.block_size, 0);
+    block_fill_ = 0;
+    index_.clear();
+    symbols_.clear();
+    symbol_ids_.clear();
+    last_timestamp_ns_ = 0;
+    const std::vector<char> reserved_header(BLOCK_ALIGNMENT, 0);
+    file_.write(reserved_header.data(), static_cast<std::streamsize>(reserved_header.size()));
+    write_offset_ = BLOCK_ALIGNMENT;
+    return file_.good();
+}
+bool ColumnarTickWriter::intern_symbol(std::string_view symbol, uint16_t& symbol_id) {
+    if (symbol.size() >= COLUMNAR_SYMBOL_LENGTH) {
+        std::cerr << "Symbol too long for columnar tick file: " << symbol << std::endl;
+        return false;
+    }
+    const std::string key(symbol);
+    const auto it = symbol_ids_.find(key);
+    if (it != symbol_ids_.end()) {
+        symbol_id = it->second;
+        return true;
+    }
+    if (symbols_.size() == COLUMNAR_MAX_SYMBOLS) {
+        std::cerr << "Columnar tick file exceeds " << COLUMNAR_MAX_SYMBOLS << " symbols: " << path_ << std::endl;
+        return false;
+    }
+    symbol_id = static_cast<uint16_t>(symbols_.size());
+    symbols_.push_back(key);
+    symbol_ids_.emplace(key, symbol_id);
+    return true;
+}
+bool ColumnarTickWriter::append(const ColumnarTickRow& row) {
+    if (!file_.is_open() || row.symbol_id >= symbols_.size()) {
+        return false;
+    }
+    const size_t capacity = header_.block_capacity;
+    char* block = block_.data();
+    put_column(block, wide_column_offset(TIMESTAMP, capacity), block_fill_, row.timestamp_ns);
+    put_column(block, wide_column_offset(BID_PRICE, capacity), block_fill_, row.bid_price);
+    put_column(block, wide_column_offset(ASK_PRICE, capacity), block_fill_, row.ask_price);
+    put_column(block, wide_column_offset(LAST_PRICE, capacity), block_fill_, row.last_price);
+    put_column(block, wide_column_offset(BID_SIZE, capacity), block_fill_, row.bid_size);
+    put_column(block, wide_column_offset(ASK_SIZE, capacity), block_fill_, row.ask_size);
+    put_column(block, wide_column_offset(LAST_SIZE, capacity), block_fill_, row.last_size);
+    put_column(block, wide_column_offset(SEQUENCE_NUMBER, capacity), block_fill_, row.sequence_number);
+    put_column(block, symbol_column_offset(capacity), block_fill_, row.symbol_id);
+    if (header_.tick_count == 0) {
+        header_.start_time_ns = row.timestamp_ns;
+    } else if (row.timestamp_ns < last_timestamp_ns_) {
+        header_.time_ordered = 0;
+    }
+    header_.start_time_ns = std::min(header_.start_time_ns, row.timestamp_ns);
+    header_.end_time_ns = std::max(header_.end_time_ns, row.timestamp_ns);
+    last_timestamp_ns_ = row.timestamp_ns;
+    ++header_.tick_count;
+    return ++block_fill_ < capacity || flush_block();
+}
+bool ColumnarTickWriter::append(const HistoricalTick& tick) {
+    ColumnarTickRow row{to_timestamp_ns(tick.timestamp), tick.bid_price, tick.ask_price, tick.last_price,
+                        tick.bid_size, tick.ask_size, tick.last_size, tick.sequence_number, 0};
+    return intern_symbol(tick.symbol, row.symbol_id) && append(row);
+}
+bool ColumnarTickWriter::flush_block() {
+    if (block_fill_ == 0) {
+        return true;
+    }
+    const size_t capacity = header_.block_capacity;
+    const char* timestamps = block_.data() + wide_column_offset(TIMESTAMP, capacity);
+    ColumnarBlockIndexEntry entry{UINT64_MAX, 0, write_offset_, static_cast<uint32_t>(block_fill_), 0};
+    for (size_t row = 0; row < block_fill_; ++row) {
+        uint64_t timestamp_ns;
+        std::memcpy(&timestamp_ns, timestamps + row * sizeof(uint64_t), sizeof(timestamp_ns));
+        entry.min_timestamp_ns = std::min(entry.min_timestamp_ns, timestamp_ns);
+        entry.max_timestamp_ns = std::max(entry.max_timestamp_ns, timestamp_ns);
+    }
+    file_.write(block_.data(), static_cast<std::streamsize>(block_.size()));
+    if (!file_.good()) {
+        std::cerr << "Failed to write columnar tick block: " << path_ << std::endl;
+        return false;
+    }
+    index_.push_back(entry);
+    write_offset_ += block_.size();
+    std::fill(block_.begin(), block_.end(), 0);
+    block_fill_ = 0;
+    return true;
+}
+bool ColumnarTickWriter::close() {
+    if (!file_.is_open()) {
+        return false;
+    }
+    bool ok = flush_block();
+    header_.block_count = index_.size();
+    header_.index_offset = write_offset_;
+    header_.symbols_offset = write_offset_ + index_.size() * sizeof(ColumnarBlockIndexEntry);
+    header_.symbol_count = static_cast<uint32_t>(symbols_.size());
+    file_.write(reinterpret_cast<const char*>(index_.data()),
+                static_cast<std::streamsize>(index_.size() * sizeof(ColumnarBlockIndexEntry)));
+    for (const auto& symbol : symbols_) {
+        char name[COLUMNAR_SYMBOL_LENGTH] = {};
+        std::memcpy(name, symbol.data(), symbol.size());
+        file_.write(name, sizeof(name));
+    }
+    file_.seekp(0);
+    file_.write(reinterpret_cast<const char*>(&header_), sizeof(header_));
+    ok = ok && file_.good();
+    file_.close();
+    if (!ok) {
+        std::cerr << "Failed to finalize columnar tick file: " << path_ << std::endl;
+    }
+    return ok;
+}
+ColumnarTickReader::ColumnarTickReader()
+    : fd_(-1), mapping_(nullptr), mapping_size_(0), header_(nullptr), index_(nullptr) {}
+ColumnarTickReader::~ColumnarTickReader() {
+    close();
+}
+bool ColumnarTickReader::open(const std::string& path) {
+    close();
+    fd_ = ::open(path.c_str(), O_RDONLY);
+    if (fd_ < 0) {
+        std::cerr << "Failed to open columnar tick file: " << path << std::endl;
+        return false;
+    }
+    struct stat file_stat;
+    if (fstat(fd_, &file_stat) != 0 || static_cast<size_t>(file_stat.st_size) < ColumnarTickWriter::BLOCK_ALIGNMENT) {
+        std::cerr << "Invalid columnar tick file: " << path << std::endl;
+        close();
+        return false;
+    }
+    void* mapping = mmap(nullptr, static_cast<size_t>(file_stat.st_size), PROT_READ, MAP_SHARED, fd_, 0);
+    if (mapping == MAP_FAILED) {
+        std::cerr << "Failed to map columnar tick file: " << path << std::endl;
+        close();
+        return false;
+    }
+    mapping_ = static_cast<const char*>(mapping);
+    mapping_size_ = static_cast<size_t>(file_stat.st_size);
+    madvise(mapping, mapping_size_, MADV_SEQUENTIAL);
+    const auto* header = reinterpret_cast<const ColumnarFileHeader*>(mapping_);
+    const size_t capacity = header->block_capacity;
+    const bool valid = std::memcmp(header->magic, COLUMNAR_MAGIC, sizeof(COLUMNAR_MAGIC)) == 0 &&
+                       header->version == ColumnarTickWriter::FORMAT_VERSION && capacity != 0 &&
+                       header->block_size == ColumnarTickWriter::block_size(capacity) &&
+                       header->index_offset <= mapping_size_ &&
+                       header->block_count <= (mapping_size_ - header->index_offset) / sizeof(ColumnarBlockIndexEntry) &&
+                       header->symbols_offset == header->index_offset +
+                                                 header->block_count * sizeof(ColumnarBlockIndexEntry) &&
+                       header->symbol_count <= (mapping_size_ - header->symbols_offset) / COLUMNAR_SYMBOL_LENGTH;
+    if (!valid) {
+        std::cerr << "Invalid columnar tick file header: " << path << std::endl;
+        close();
+        return false;
+    }
+    const auto* index = reinterpret_cast<const ColumnarBlockIndexEntry*>(mapping_ + header->index_offset);
+    for (size_t i = 0; i < header->block_count; ++i) {
+        if (index[i].offset < ColumnarTickWriter::BLOCK_ALIGNMENT || index[i].tick_count > capacity ||
+            index[i].offset + header->block_size > header->index_offset) {
+            std::cerr << "Corrupt columnar block index in " << path << " at block " << i << std::endl;
+            close();
+            return false;
+        }
+    }
+    header_ = header;
+    index_ = index;
+    symbols_.reserve(header->symbol_count);
+    const char* names = mapping_ + header->symbols_offset;
+    for (size_t i = 0; i < header->symbol_count; ++i) {
+        const char* name = names + i * COLUMNAR_SYMBOL_LENGTH;
+        symbols_.emplace_back(name, strnlen(name, COLUMNAR_SYMBOL_LENGTH));
+    }
+    return true;
+}
+void ColumnarTickReader::close() {
+    if (mapping_) {
+        munmap(const_cast<char*>(mapping_), mapping_size_);
+        mapping_ = nullptr;
+    }
+    if (fd_ >= 0) {
+        ::close(fd_);
+        fd_ = -1;
+    }
+    mapping_size_ = 0;
+    header_ = nullptr;
+    index_ = nullptr;
+    symbols_.clear();
+}
+ColumnarTickBlock ColumnarTickReader::block(size_t index) const {
+    ColumnarTickBlock block;
+    if (!header_ || index >= header_->block_count) {
+        return block;
+    }
+    const ColumnarBlockIndexEntry& entry = index_[index];
+    const size_t capacity = header_->block_capacity;
+    const char* base = mapping_ + entry.offset;
+    const uint16_t* symbol_id = reinterpret_cast<const uint16_t*>(base + symbol_column_offset(capacity));
+    uint16_t max_symbol_id = 0;
+    for (size_t i = 0; i < entry.tick_count; ++i) {
+        max_symbol_id = std::max(max_symbol_id, symbol_id[i]);
+    }
+    if (entry.tick_count != 0 && max_symbol_id >= symbols_.size()) {
+        std::cerr << "Corrupt columnar symbol column at block " << index << ": symbol id " << max_symbol_id
+                  << " exceeds symbol count " << symbols_.size() << std::endl;
+        return block;
+    }
+    block.count = entry.tick_count;
+    block.min_timestamp_ns = entry.min_timestamp_ns;
+    block.max_timestamp_ns = entry.max_timestamp_ns;
+    block.timestamp_ns = reinterpret_cast<const uint64_t*>(base + wide_column_offset(TIMESTAMP, capacity));
+    block.bid_price = reinterpret_cast<const double*>(base + wide_column_offset(BID_PRICE, capacity));
+    block.ask_price = reinterpret_cast<const double*>(base + wide_column_offset(ASK_PRICE, capacity));
+    block.last_price = reinterpret_cast<const double*>(base + wide_column_offset(LAST_PRICE, capacity));
+    block.bid_size = reinterpret_cast<const uint64_t*>(base + wide_column_offset(BID_SIZE, capacity));
+    block.ask_size = reinterpret_cast<const uint64_t*>(base + wide_column_offset(ASK_SIZE, capacity));
+    block.last_size = reinterpret_cast<const uint64_t*>(base + wide_column_offset(LAST_SIZE, capacity));
+    block.sequence_number = reinterpret_cast<const uint64_t*>(base + wide_column_offset(SEQUENCE_NUMBER, capacity));
+    block.symbol_id = symbol_id;
+    return block;
+}
+size_t ColumnarTickReader::find_block(uint64_t timestamp_ns) const {
+    if (!header_) {
+        return 0;
+    }
+    const ColumnarBlockIndexEntry* end = index_ + header_->block_count;
+    if (header_->time_ordered) {
+        return static_cast<size_t>(std::partition_point(index_, end, [timestamp_ns](const ColumnarBlockIndexEntry& entry) {
+            return entry.max_timestamp_ns < timestamp_ns;
+        }) - index_);
+    }
+    return static_cast<size_t>(std::find_if(index_, end, [timestamp_ns](const ColumnarBlockIndexEntry& entry) {
+        return entry.max_timestamp_ns >= timestamp_ns;
+    }) - index_);
+}
+void ColumnarTickReader::prefetch_block(size_t index) const {
+    if (!header_ || index >= header_->block_count) {
+        return;
+    }
+    const uintptr_t start = reinterpret_cast<uintptr_t>(mapping_ + index_[index].offset);
+    madvise(reinterpret_cast<void*>(start), header_->block_size, MADV_WILLNEED);
+}
+ColumnarMarketDataParser::ColumnarMarketDataParser() : next_block_(0), position_(0) {}
+bool ColumnarMarketDataParser::open(const std::string& filename) {
+    close();
+    if (!reader_.open(filename)) {
+        return false;
+    }
+    symbols_.assign(reader_.symbols().begin(), reader_.symbols().end());
+    load_block(0);
+    return true;
+}
+bool ColumnarMarketDataParser::load_block(size_t index) {
+    if (index >= reader_.block_count()) {
+        block_ = ColumnarTickBlock{};
+        next_block_ = reader_.block_count();
+        position_ = 0;
+        return false;
+    }
+    block_ = reader_.block(index);
+    next_block_ = index + 1;
+    position_ = 0;
+    reader_.prefetch_block(next_block_);
+    return true;
+}
+bool ColumnarMarketDataParser::read_next_tick(HistoricalTick& tick) {
+    while (position_ >= block_.count) {
+        if (!load_block(next_block_)) {
+            return false;
+        }
+    }
+    const size_t row = position_++;
+    tick.symbol = symbols_[block_.symbol_id[row]];
+    tick.timestamp = core::TimePoint(std::chrono::nanoseconds(block_.timestamp_ns[row]));
+    tick.bid_price = block_.bid_price[row];
+    tick.ask_price = block_.ask_price[row];
+    tick.last_price = block_.last_price[row];
+    tick.bid_size = block_.bid_size[row];
+    tick.ask_size = block_.ask_size[row];
+    tick.last_size = block_.last_size[row];
+    tick.sequence_number = block_.sequence_number[row];
+    tick.mid_price = (tick.bid_price + tick.ask_price) / 2.0;
+    tick.spread_bps = ((tick.ask_price - tick.bid_price) / tick.mid_price) * 10000.0;
+    tick.is_trade_tick = (tick.last_size > 0);
+    tick.trade_aggressor_side = tick.last_price >= tick.mid_price ?
+        core::Side::BUY : core::Side::SELL;
+    return true;
+}
+bool ColumnarMarketDataParser::read_next_snapshot(HistoricalOrderBookSnapshot& snapshot) {
+    HistoricalTick tick;
+    if (!read_next_tick(tick)) return false;
+    snapshot.symbol = tick.symbol;
+    snapshot.timestamp = tick.timestamp;
+    snapshot.sequence_number = tick.sequence_number;
+    snapshot.bids.clear();
+    snapshot.asks.clear();
+    snapshot.bids.emplace_back(tick.bid_price, tick.bid_size);
+    snapshot.asks.emplace_back(tick.ask_price, tick.ask_size);
+    return true;
+}
+void ColumnarMarketDataParser::close() {
+    reader_.close();
+    symbols_.clear();
+    block_ = ColumnarTickBlock{};
+    next_block_ = 0;
+    position_ = 0;
+}
+bool ColumnarMarketDataParser::has_more_data() const {
+    return position_ < block_.count || next_block_ < reader_.block_count();
+}
+size_t ColumnarMarketDataParser::get_total_records() const {
+    return reader_.tick_count();
+}
+bool ColumnarMarketDataParser::seek(core::TimePoint time) {
+    if (!reader_.is_time_ordered()) {
+        return false;
+    }
+    const uint64_t timestamp_ns = to_timestamp_ns(time);
+    if (load_block(reader_.find_block(timestamp_ns))) {
+        position_ = static_cast<size_t>(
+            std::lower_bound(block_.timestamp_ns, block_.timestamp_ns + block_.count, timestamp_ns) - block_.timestamp_ns);
+    }
+    return true;
+}
+bool ColumnarMarketDataParser::convert(MarketDataParser& source, const std::string& columnar_file,
+                                       size_t block_capacity) {
+    ColumnarTickWriter writer;
+    if (!writer.open(columnar_file, block_capacity)) {
+        return false;
+    }
+    HistoricalTick tick;
+    while (source.read_next_tick(tick)) {
+        if (!writer.append(tick)) {
+            writer.close();
+            return false;
+        }
+    }
+    return writer.close();
+}
+}
+}
@@ -0,0 +1,261 @@
+#include "hft/backtesting/merged_market_data.hpp"
+#include <algorithm>
+#include <filesystem>
+#include <iostream>
+namespace hft {
+namespace backtesting {
+MergedMarketDataParser::MergedMarketDataParser(const MergedReplayConfig& config)
+    : config_(config), stopping_(false), primed_(false), total_records_(0) {}
+MergedMarketDataParser::~MergedMarketDataParser() {
+    close();
+}
+bool MergedMarketDataParser::open(const std::string& path) {
+    close();
+    std::error_code error;
+    std::vector<std::string> files;
+    if (std::filesystem::is_directory(path, error)) {
+        for (const auto& entry : std::filesystem::directory_iterator(path, error)) {
+            if (entry.is_regular_file()) {
+                files.push_back(entry.path().string());
+            }
+        }
+        std::sort(files.begin(), files.end());
+    } else {
+        files.push_back(path);
+    }
+    for (const auto& file : files) {
+        std::unique_ptr<MarketDataParser> parser = create_market_data_parser(file);
+        if (!parser) {
+            continue;
+        }
+        if (!parser->open(file)) {
+            std::cerr << "Failed to open merged replay source: " << file << std::endl;
+            close();
+            return false;
+        }
+        add_source(std::move(parser));
+    }
+    if (streams_.empty()) {
+        std::cerr << "No market data files found for merged replay: " << path << std::endl;
+        return false;
+    }
+    return true;
+}
+bool MergedMarketDataParser::add_source(std::unique_ptr<MarketDataParser> parser) {
+    if (!parser || primed_) {
+        std::cerr << "Cannot add merged replay source after replay has started" << std::endl;
+        return false;
+    }
+    auto stream = std::make_unique<Stream>();
+    stream->index = static_cast<uint32_t>(streams_.size());
+    total_records_ += parser->get_total_records();
+    stream->parser = std::move(parser);
+    streams_.push_back(std::move(stream));
+    return true;
+}
+bool MergedMarketDataParser::prime() {
+    primed_ = true;
+    if (streams_.empty()) {
+        return false;
+    }
+    const size_t block_ticks = std::max<size_t>(1, config_.read_ahead_ticks);
+    for (auto& stream : streams_) {
+        stream->front.resize(block_ticks);
+        stream->back.resize(block_ticks);
+    }
+    stopping_ = false;
+    const size_t thread_count = std::max<size_t>(1, std::min(config_.io_threads, streams_.size()));
+    for (size_t i = 0; i < thread_count; ++i) {
+        io_threads_.emplace_back([this] { io_loop(); });
+    }
+    for (auto& stream : streams_) {
+        request_fill(stream->index);
+    }
+    heap_.reserve(streams_.size());
+    for (auto& stream : streams_) {
+        if (advance_block(*stream)) {
+            heap_.push_back(HeapEntry{timestamp_ns(stream->front[0]), stream->index});
+            sift_up(heap_.size() - 1);
+        }
+    }
+    return true;
+}
+bool MergedMarketDataParser::read_next_tick(HistoricalTick& tick) {
+    if (!primed_ && !prime()) {
+        return false;
+    }
+    if (heap_.empty()) {
+        return false;
+    }
+    Stream& stream = *streams_[heap_[0].stream];
+    std::swap(tick, stream.front[stream.position++]);
+    if (stream.position < stream.front_count || advance_block(stream)) {
+        const HistoricalTick& next = stream.front[stream.position];
+        heap_[0].timestamp_ns = timestamp_ns(next);
+        __builtin_prefetch(&next + 1);
+        __builtin_prefetch(reinterpret_cast<const char*>(&next + 1) + sizeof(HistoricalTick) - 1);
+    } else {
+        heap_[0] = heap_.back();
+        heap_.pop_back();
+    }
+    if (!heap_.empty()) {
+        sift_down(0);
+    }
+    return true;
+}
+bool MergedMarketDataParser::advance_block(Stream& stream) {
+    if (stream.draining) {
+        return false;
+    }
+    if (!stream.back_ready.load(std::memory_order_acquire)) {
+        stats_.replay_waits.fetch_add(1, std::memory_order_relaxed);
+        std::unique_lock<std::mutex> lock(mutex_);
+        ready_cv_.wait(lock, [this, &stream] {
+            return stopping_ || stream.back_ready.load(std::memory_order_acquire);
+        });
+        if (!stream.back_ready.load(std::memory_order_acquire)) {
+            return false;
+        }
+    }
+    std::swap(stream.front, stream.back);
+    stream.front_count = stream.back_count;
+    stream.position = 0;
+    stream.draining = stream.back_final;
+    stream.back_ready.store(false, std::memory_order_release);
+    if (!stream.draining) {
+        request_fill(stream.index);
+    }
+    return stream.front_count != 0;
+}
+void MergedMarketDataParser::request_fill(uint32_t index) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        fill_requests_.push_back(index);
+    }
+    fill_cv_.notify_one();
+}
+void MergedMarketDataParser::io_loop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        fill_cv_.wait(lock, [this] { return stopping_ || !fill_requests_.empty(); });
+        if (stopping_) {
+            return;
+        }
+        Stream& stream = *streams_[fill_requests_.front()];
+        fill_requests_.pop_front();
+        lock.unlock();
+        fill_back(stream);
+        lock.lock();
+        stream.back_ready.store(true, std::memory_order_release);
+        ready_cv_.notify_all();
+    }
+}
+void MergedMarketDataParser::fill_back(Stream& stream) {
+    size_t count = 0;
+    while (count < stream.back.size() && stream.parser->read_next_tick(stream.back[count])) {
+        ++count;
+    }
+    stream.back_count = count;
+    stream.back_final = count < stream.back.size();
+    stats_.blocks_loaded.fetch_add(1, std::memory_order_relaxed);
+    stats_.ticks_loaded.fetch_add(count, std::memory_order_relaxed);
+    if (stream.back_final) {
+        stats_.streams_exhausted.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+void MergedMarketDataParser::sift_down(size_t index) {
+    const HeapEntry entry = heap_[index];
+    const size_t size = heap_.size();
+    while (true) {
+        const size_t first = index * HEAP_ARITY + 1;
+        if (first >= size) {
+            break;
+        }
+        const size_t last = std::min(first + HEAP_ARITY, size);
+        size_t best = first;
+        for (size_t child = first + 1; child < last; ++child) {
+            if (before(heap_[child], heap_[best])) {
+                best = child;
+            }
+        }
+        if (!before(heap_[best], entry)) {
+            break;
+        }
+        heap_[index] = heap_[best];
+        index = best;
+    }
+    heap_[index] = entry;
+}
+void MergedMarketDataParser::sift_up(size_t index) {
+    const HeapEntry entry = heap_[index];
+    while (index > 0) {
+        const size_t parent = (index - 1) / HEAP_ARITY;
+        if (!before(entry, heap_[parent])) {
+            break;
+        }
+        heap_[index] = heap_[parent];
+        index = parent;
+    }
+    heap_[index] = entry;
+}
+bool MergedMarketDataParser::read_next_snapshot(HistoricalOrderBookSnapshot& snapshot) {
+    HistoricalTick tick;
+    if (!read_next_tick(tick)) return false;
+    snapshot.symbol = tick.symbol;
+    snapshot.timestamp = tick.timestamp;
+    snapshot.sequence_number = tick.sequence_number;
+    snapshot.bids.clear();
+    snapshot.asks.clear();
+    snapshot.bids.emplace_back(tick.bid_price, tick.bid_size);
+    snapshot.asks.emplace_back(tick.ask_price, tick.ask_size);
+    return true;
+}
+void MergedMarketDataParser::stop_io_threads() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    fill_cv_.notify_all();
+    ready_cv_.notify_all();
+    for (auto& thread : io_threads_) {
+        thread.join();
+    }
+    io_threads_.clear();
+}
+void MergedMarketDataParser::close() {
+    stop_io_threads();
+    for (auto& stream : streams_) {
+        stream->parser->close();
+    }
+    streams_.clear();
+    heap_.clear();
+    fill_requests_.clear();
+    stopping_ = false;
+    primed_ = false;
+    total_records_ = 0;
+}
+bool MergedMarketDataParser::has_more_data() const {
+    if (primed_) {
+        return !heap_.empty();
+    }
+    return std::any_of(streams_.begin(), streams_.end(), [](const std::unique_ptr<Stream>& stream) {
+        return stream->parser->has_more_data();
+    });
+}
+bool MergedMarketDataParser::seek(core::TimePoint time) {
+    if (primed_ || streams_.empty()) {
+        return false;
+    }
+    bool all_seeked = true;
+    for (auto& stream : streams_) {
+        all_seeked = stream->parser->seek(time) && all_seeked;
+    }
+    return all_seeked;
+}
+bool MergedMarketDataParser::is_time_ordered() const {
+    return !streams_.empty() && std::all_of(streams_.begin(), streams_.end(), [](const std::unique_ptr<Stream>& stream) {
+        return stream->parser->is_time_ordered();
+    });
+}
+}
+}
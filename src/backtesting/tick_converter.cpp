@@ -0,0 +1,308 @@
+#include "hft/backtesting/tick_replay.hpp"
+#include "hft/backtesting/columnar_tick_store.hpp"
+#include "hft/core/simd_scan.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <queue>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+namespace hft {
+namespace backtesting {
+class TickConverter {
+private:
+    struct ChunkResult {
+        size_t begin_offset = 0;
+        size_t end_offset = 0;
+        std::vector<ColumnarTickRow> rows;
+        std::vector<std::string> symbols;
+        size_t lines = 0;
+        bool ok = false;
+    };
+    struct MergeCursor {
+        uint64_t timestamp_ns;
+        size_t chunk;
+        size_t row;
+        bool operator>(const MergeCursor& other) const {
+            return timestamp_ns != other.timestamp_ns ? timestamp_ns > other.timestamp_ns : chunk > other.chunk;
+        }
+    };
+    static constexpr size_t MIN_CHUNK_BYTES = 1 << 20;
+    static constexpr size_t CHUNKS_PER_THREAD = 4;
+    static constexpr size_t BOUNDARY_READ_SIZE = 4096;
+    std::string input_file_;
+    std::string output_file_;
+    size_t threads_;
+    size_t block_capacity_;
+public:
+    TickConverter(const std::string& input_file, const std::string& output_file, size_t threads,
+                  size_t block_capacity)
+        : input_file_(input_file), output_file_(output_file), threads_(std::max<size_t>(1, threads)),
+          block_capacity_(block_capacity) {}
+    bool convert() {
+        const bool columnar = output_file_.ends_with(".tcol");
+        if (!columnar && !output_file_.ends_with(".bin")) {
+            std::cerr << "Unsupported output format (expected .tcol or .bin): " << output_file_ << std::endl;
+            return false;
+        }
+        std::error_code error;
+        const size_t file_size = std::filesystem::file_size(input_file_, error);
+        if (error) {
+            std::cerr << "Failed to stat CSV file: " << input_file_ << std::endl;
+            return false;
+        }
+        const auto start = std::chrono::steady_clock::now();
+        std::vector<ChunkResult> chunks = split_chunks(file_size);
+        std::atomic<size_t> next_chunk{0};
+        std::vector<std::thread> workers;
+        const size_t worker_count = std::min(threads_, chunks.size());
+        for (size_t i = 0; i < worker_count; ++i) {
+            workers.emplace_back([this, &chunks, &next_chunk] {
+                for (size_t chunk = next_chunk.fetch_add(1); chunk < chunks.size(); chunk = next_chunk.fetch_add(1)) {
+                    parse_chunk(chunks[chunk]);
+                }
+            });
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+        const auto parsed = std::chrono::steady_clock::now();
+        size_t line_base = 0;
+        size_t tick_count = 0;
+        std::unordered_set<std::string> distinct_symbols;
+        for (auto& chunk : chunks) {
+            if (!chunk.ok) {
+                std::cerr << "Failed to parse CSV chunk [" << chunk.begin_offset << ", " << chunk.end_offset
+                          << ") of " << input_file_ << std::endl;
+                return false;
+            }
+            for (auto& row : chunk.rows) {
+                row.sequence_number += line_base;
+            }
+            line_base += chunk.lines;
+            tick_count += chunk.rows.size();
+            distinct_symbols.insert(chunk.symbols.begin(), chunk.symbols.end());
+        }
+        const size_t symbol_count = distinct_symbols.size();
+        const bool written = columnar ? write_columnar(chunks) : write_binary(chunks, symbol_count);
+        if (!written) {
+            return false;
+        }
+        const auto finished = std::chrono::steady_clock::now();
+        const double parse_seconds = std::chrono::duration<double>(parsed - start).count();
+        const double total_seconds = std::chrono::duration<double>(finished - start).count();
+        std::cout << "Converted " << input_file_ << " -> " << output_file_ << std::endl;
+        std::cout << "  Ticks:      " << tick_count << " across " << symbol_count << " symbols" << std::endl;
+        std::cout << "  Chunks:     " << chunks.size() << " on " << worker_count << " threads" << std::endl;
+        std::cout << std::fixed << std::setprecision(2);
+        std::cout << "  Parse:      " << parse_seconds * 1e3 << " ms" << std::endl;
+        std::cout << "  Sort+write: " << (total_seconds - parse_seconds) * 1e3 << " ms" << std::endl;
+        std::cout << "  Throughput: " << file_size / total_seconds / (1 << 20) << " MB/s, "
+                  << tick_count / total_seconds / 1e6 << " M ticks/s" << std::endl;
+        return true;
+    }
+private:
+    std::vector<ChunkResult> split_chunks(size_t file_size) {
+        const size_t chunk_count =
+            std::max<size_t>(1, std::min(threads_ * CHUNKS_PER_THREAD, file_size / MIN_CHUNK_BYTES));
+        std::vector<size_t> boundaries{0};
+        std::ifstream file(input_file_, std::ios::binary);
+        char buffer[BOUNDARY_READ_SIZE];
+        for (size_t i = 1; i < chunk_count; ++i) {
+            size_t offset = std::max(boundaries.back(), file_size / chunk_count * i);
+            file.clear();
+            file.seekg(static_cast<std::streamoff>(offset));
+            while (offset < file_size) {
+                file.read(buffer, sizeof(buffer));
+                const size_t length = static_cast<size_t>(file.gcount());
+                if (length == 0) {
+                    offset = file_size;
+                    break;
+                }
+                const char* newline = core::find_byte(buffer, buffer + length, '\n');
+                if (newline != buffer + length) {
+                    offset += static_cast<size_t>(newline - buffer) + 1;
+                    break;
+                }
+                offset += length;
+            }
+            if (offset >= file_size) {
+                break;
+            }
+            boundaries.push_back(offset);
+        }
+        boundaries.push_back(file_size);
+        std::vector<ChunkResult> chunks(boundaries.size() - 1);
+        for (size_t i = 0; i < chunks.size(); ++i) {
+            chunks[i].begin_offset = boundaries[i];
+            chunks[i].end_offset = boundaries[i + 1];
+        }
+        return chunks;
+    }
+    void parse_chunk(ChunkResult& chunk) {
+        CSVMarketDataParser parser;
+        if (!parser.open_range(input_file_, chunk.begin_offset, chunk.end_offset)) {
+            return;
+        }
+        std::unordered_map<std::string, uint16_t> symbol_ids;
+        chunk.rows.reserve((chunk.end_offset - chunk.begin_offset) / 48);
+        HistoricalTick tick;
+        bool time_ordered = true;
+        while (parser.read_next_tick(tick)) {
+            auto it = symbol_ids.find(tick.symbol);
+            if (it == symbol_ids.end()) {
+                if (chunk.symbols.size() == COLUMNAR_MAX_SYMBOLS) {
+                    std::cerr << "CSV chunk exceeds " << COLUMNAR_MAX_SYMBOLS << " symbols" << std::endl;
+                    return;
+                }
+                it = symbol_ids.emplace(tick.symbol, static_cast<uint16_t>(chunk.symbols.size())).first;
+                chunk.symbols.push_back(tick.symbol);
+            }
+            const uint64_t timestamp_ns = static_cast<uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(tick.timestamp.time_since_epoch()).count());
+            time_ordered = time_ordered && (chunk.rows.empty() || chunk.rows.back().timestamp_ns <= timestamp_ns);
+            chunk.rows.push_back(ColumnarTickRow{timestamp_ns, tick.bid_price, tick.ask_price, tick.last_price,
+                                                tick.bid_size, tick.ask_size, tick.last_size,
+                                                tick.sequence_number, it->second});
+        }
+        if (parser.has_more_data()) {
+            return;
+        }
+        if (!time_ordered) {
+            std::stable_sort(chunk.rows.begin(), chunk.rows.end(),
+                             [](const ColumnarTickRow& a, const ColumnarTickRow& b) {
+                                 return a.timestamp_ns < b.timestamp_ns;
+                             });
+        }
+        chunk.lines = parser.get_total_records();
+        chunk.ok = true;
+    }
+    template<typename Emit>
+    bool merge_chunks(const std::vector<ChunkResult>& chunks, Emit&& emit) {
+        std::priority_queue<MergeCursor, std::vector<MergeCursor>, std::greater<MergeCursor>> heap;
+        for (size_t i = 0; i < chunks.size(); ++i) {
+            if (!chunks[i].rows.empty()) {
+                heap.push(MergeCursor{chunks[i].rows[0].timestamp_ns, i, 0});
+            }
+        }
+        while (!heap.empty()) {
+            MergeCursor cursor = heap.top();
+            heap.pop();
+            const std::vector<ColumnarTickRow>& rows = chunks[cursor.chunk].rows;
+            const uint64_t limit = heap.empty() ? UINT64_MAX : heap.top().timestamp_ns;
+            const bool yields_ties = !heap.empty() && heap.top().chunk < cursor.chunk;
+            do {
+                if (!emit(cursor.chunk, rows[cursor.row])) {
+                    return false;
+                }
+                ++cursor.row;
+            } while (cursor.row < rows.size() &&
+                     (rows[cursor.row].timestamp_ns < limit ||
+                      (rows[cursor.row].timestamp_ns == limit && !yields_ties)));
+            if (cursor.row < rows.size()) {
+                cursor.timestamp_ns = rows[cursor.row].timestamp_ns;
+                heap.push(cursor);
+            }
+        }
+        return true;
+    }
+    bool write_columnar(const std::vector<ChunkResult>& chunks) {
+        ColumnarTickWriter writer;
+        if (!writer.open(output_file_, block_capacity_)) {
+            return false;
+        }
+        std::vector<std::vector<uint16_t>> symbol_maps(chunks.size());
+        for (size_t i = 0; i < chunks.size(); ++i) {
+            symbol_maps[i].resize(chunks[i].symbols.size());
+            for (size_t s = 0; s < chunks[i].symbols.size(); ++s) {
+                if (!writer.intern_symbol(chunks[i].symbols[s], symbol_maps[i][s])) {
+                    writer.close();
+                    return false;
+                }
+            }
+        }
+        const bool merged = merge_chunks(chunks, [&writer, &symbol_maps](size_t chunk, const ColumnarTickRow& row) {
+            ColumnarTickRow mapped = row;
+            mapped.symbol_id = symbol_maps[chunk][row.symbol_id];
+            return writer.append(mapped);
+        });
+        return writer.close() && merged;
+    }
+    bool write_binary(const std::vector<ChunkResult>& chunks, size_t symbol_count) {
+        std::ofstream file(output_file_, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            std::cerr << "Failed to create binary tick file: " << output_file_ << std::endl;
+            return false;
+        }
+        if (symbol_count > 1) {
+            std::cerr << "Warning: binary format stores a single symbol; " << symbol_count
+                      << " symbols will be labelled with the first one (use .tcol to keep them)" << std::endl;
+        }
+        BinaryMarketDataParser::BinaryHeader header;
+        header.record_count = 0;
+        header.start_time_ns = 0;
+        header.end_time_ns = 0;
+        std::strcpy(header.symbol, "UNKNOWN");
+        header.record_size = sizeof(BinaryMarketDataParser::BinaryTick);
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        std::vector<BinaryMarketDataParser::BinaryTick> batch;
+        batch.reserve(block_capacity_);
+        auto flush = [&file, &batch] {
+            file.write(reinterpret_cast<const char*>(batch.data()),
+                       static_cast<std::streamsize>(batch.size() * sizeof(BinaryMarketDataParser::BinaryTick)));
+            batch.clear();
+            return file.good();
+        };
+        const bool merged = merge_chunks(chunks, [&](size_t chunk, const ColumnarTickRow& row) {
+            if (header.record_count++ == 0) {
+                header.start_time_ns = row.timestamp_ns;
+                const std::string& symbol = chunks[chunk].symbols[row.symbol_id];
+                std::strncpy(header.symbol, symbol.c_str(), sizeof(header.symbol) - 1);
+                header.symbol[sizeof(header.symbol) - 1] = '\0';
+            }
+            header.end_time_ns = row.timestamp_ns;
+            batch.push_back(BinaryMarketDataParser::BinaryTick{row.timestamp_ns, row.bid_price, row.ask_price,
+                                                               row.last_price, row.bid_size, row.ask_size,
+                                                               row.last_size, row.sequence_number});
+            return batch.size() < block_capacity_ || flush();
+        });
+        const bool flushed = merged && flush();
+        file.seekp(0);
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        if (!flushed || !file.good()) {
+            std::cerr << "Failed to write binary tick file: " << output_file_ << std::endl;
+            return false;
+        }
+        return true;
+    }
+};
+}
+}
+int main(int argc, char* argv[]) {
+    using namespace hft::backtesting;
+    if (argc < 3) {
+        std::cout << "Usage: " << argv[0] << " <input.csv> <output.tcol|output.bin> [threads] [block_capacity]\n";
+        std::cout << "  Splits the CSV at line boundaries, parses chunks in parallel and writes\n";
+        std::cout << "  time-sorted ticks to the columnar (.tcol) or legacy binary (.bin) format.\n";
+        return 1;
+    }
+    const size_t hardware_threads = std::max(1u, std::thread::hardware_concurrency());
+    const size_t threads = argc > 3 ? std::strtoull(argv[3], nullptr, 10) : hardware_threads;
+    const size_t block_capacity = argc > 4 ? std::strtoull(argv[4], nullptr, 10)
+                                           : ColumnarTickWriter::DEFAULT_BLOCK_CAPACITY;
+    if (threads == 0 || block_capacity == 0) {
+        std::cerr << "threads and block_capacity must be positive" << std::endl;
+        return 1;
+    }
+    TickConverter converter(argv[1], argv[2], threads, block_capacity);
+    return converter.convert() ? 0 : 1;
+}
@@ -1,5 +1,9 @@
 #include "hft/backtesting/tick_replay.hpp"
+#include "hft/backtesting/columnar_tick_store.hpp"
+#include "hft/backtesting/merged_market_data.hpp"
 #include "hft/order/order.hpp"
+#include "hft/core/numeric.hpp"
+#include "hft/core/simd_scan.hpp"
 #include <iostream>
 #include <sstream>
 #include <algorithm>
@@ -8,54 +12,140 @@
 #include <random>
 #include <deque>
 #include <numeric>
+#include <filesystem>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 namespace hft {
 namespace backtesting {
+namespace {
+inline std::string_view trim_csv_field(const char* begin, const char* end) {
+    while (begin != end && (*begin == ' ' || *begin == '\t' || *begin == '\r')) ++begin;
+    while (end != begin && (end[-1] == ' ' || end[-1] == '\t' || end[-1] == '\r')) --end;
+    return std::string_view(begin, static_cast<size_t>(end - begin));
+}
+}
 CSVMarketDataParser::CSVMarketDataParser(const core::Symbol& default_symbol)
-    : line_number_(0), default_symbol_(default_symbol) {}
+    : fd_(-1), data_(nullptr), size_(0), end_offset_(0), offset_(0), block_offset_(0), block_separators_(0),
+      block_newlines_(0), required_columns_(8), line_number_(0), default_symbol_(default_symbol) {}
+CSVMarketDataParser::~CSVMarketDataParser() {
+    close();
+}
 bool CSVMarketDataParser::open(const std::string& filename) {
-    file_.open(filename);
-    if (!file_.is_open()) {
+    return open_range(filename, 0, SIZE_MAX);
+}
+bool CSVMarketDataParser::open_range(const std::string& filename, size_t begin_offset, size_t end_offset) {
+    close();
+    fd_ = ::open(filename.c_str(), O_RDONLY);
+    struct stat file_stat;
+    if (fd_ < 0 || fstat(fd_, &file_stat) != 0) {
         std::cerr << "Failed to open CSV file: " << filename << std::endl;
+        close();
+        return false;
+    }
+    size_ = static_cast<size_t>(file_stat.st_size);
+    if (size_ != 0) {
+        void* mapping = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd_, 0);
+        if (mapping == MAP_FAILED) {
+            std::cerr << "Failed to map CSV file: " << filename << std::endl;
+            close();
+            return false;
+        }
+        madvise(mapping, size_, MADV_SEQUENTIAL);
+        data_ = static_cast<const char*>(mapping);
+    }
+    required_columns_ = 1 + static_cast<size_t>(std::max({7, format_.timestamp_col, format_.bid_price_col,
+        format_.ask_price_col, format_.last_price_col, format_.bid_size_col, format_.ask_size_col,
+        format_.last_size_col}));
+    if (required_columns_ > MAX_CSV_COLUMNS) {
+        std::cerr << "CSV column index exceeds " << MAX_CSV_COLUMNS << " columns: " << filename << std::endl;
+        close();
         return false;
     }
+    end_offset_ = std::min(end_offset, size_);
+    offset_ = std::min(begin_offset, end_offset_);
     line_number_ = 0;
-    if (format_.has_header && file_.good()) {
-        std::getline(file_, current_line_);
+    scan_block_at(offset_);
+    if (format_.has_header && offset_ == 0 && offset_ < end_offset_) {
+        split_next_line();
         line_number_++;
     }
     return true;
 }
+void CSVMarketDataParser::scan_block_at(size_t block_offset) {
+    block_offset_ = block_offset;
+    if (block_offset >= end_offset_) {
+        block_separators_ = 0;
+        block_newlines_ = 0;
+        return;
+    }
+    const core::ByteMasks masks =
+        core::scan_block(data_ + block_offset, end_offset_ - block_offset, format_.delimiter, '\n');
+    block_separators_ = masks.first | masks.second;
+    block_newlines_ = masks.second;
+}
+size_t CSVMarketDataParser::split_next_line() {
+    const char* field = data_ + offset_;
+    size_t count = 0;
+    while (block_offset_ < end_offset_) {
+        while (block_separators_ != 0) {
+            const unsigned bit = static_cast<unsigned>(__builtin_ctzll(block_separators_));
+            block_separators_ &= block_separators_ - 1;
+            const char* position = data_ + block_offset_ + bit;
+            if (count < MAX_CSV_COLUMNS) {
+                fields_[count++] = trim_csv_field(field, position);
+            }
+            field = position + 1;
+            if ((block_newlines_ >> bit) & 1) {
+                offset_ = static_cast<size_t>(field - data_);
+                return count;
+            }
+        }
+        scan_block_at(block_offset_ + core::SIMD_SCAN_BLOCK);
+    }
+    if (count < MAX_CSV_COLUMNS) {
+        fields_[count++] = trim_csv_field(field, data_ + end_offset_);
+    }
+    offset_ = end_offset_;
+    return count;
+}
 bool CSVMarketDataParser::read_next_tick(HistoricalTick& tick) {
-    if (!file_.good()) return false;
-    if (!std::getline(file_, current_line_)) {
+    if (offset_ >= end_offset_) return false;
+    const size_t count = split_next_line();
+    line_number_++;
+    if (count < required_columns_) {
+        std::cerr << "Invalid CSV format at line " << line_number_ << std::endl;
         return false;
     }
-    line_number_++;
-    try {
-        auto fields = parse_csv_line(current_line_);
-        if (fields.size() < 8) {
-            std::cerr << "Invalid CSV format at line " << line_number_ << std::endl;
-            return false;
-        }
-        tick.timestamp = parse_timestamp(fields[format_.timestamp_col]);
-        tick.symbol = fields.size() > format_.symbol_col ? fields[format_.symbol_col] : default_symbol_;
-        tick.bid_price = std::stod(fields[format_.bid_price_col]);
-        tick.ask_price = std::stod(fields[format_.ask_price_col]);
-        tick.last_price = std::stod(fields[format_.last_price_col]);
-        tick.bid_size = std::stoull(fields[format_.bid_size_col]);
-        tick.ask_size = std::stoull(fields[format_.ask_size_col]);
-        tick.last_size = std::stoull(fields[format_.last_size_col]);
-        tick.sequence_number = line_number_;
-        tick.mid_price = (tick.bid_price + tick.ask_price) / 2.0;
-        tick.spread_bps = ((tick.ask_price - tick.bid_price) / tick.mid_price) * 10000.0;
-        tick.is_trade_tick = (tick.last_size > 0);
-        tick.trade_aggressor_side = tick.last_price >= tick.mid_price ?
-            core::Side::BUY : core::Side::SELL;
-        return true;
-    } catch (const std::exception& e) {
-        std::cerr << "Parse error at line " << line_number_ << ": " << e.what() << std::endl;
+    tick.timestamp = parse_timestamp(fields_[format_.timestamp_col]);
+    if (count > static_cast<size_t>(format_.symbol_col)) {
+        tick.symbol.assign(fields_[format_.symbol_col]);
+    } else {
+        tick.symbol = default_symbol_;
+    }
+    const std::string_view bid_price = fields_[format_.bid_price_col];
+    const std::string_view ask_price = fields_[format_.ask_price_col];
+    const std::string_view last_price = fields_[format_.last_price_col];
+    const std::string_view bid_size = fields_[format_.bid_size_col];
+    const std::string_view ask_size = fields_[format_.ask_size_col];
+    const std::string_view last_size = fields_[format_.last_size_col];
+    if (!core::parse_price(bid_price.data(), bid_price.size(), tick.bid_price) ||
+        !core::parse_price(ask_price.data(), ask_price.size(), tick.ask_price) ||
+        !core::parse_price(last_price.data(), last_price.size(), tick.last_price) ||
+        !core::parse_uint(bid_size.data(), bid_size.size(), tick.bid_size) ||
+        !core::parse_uint(ask_size.data(), ask_size.size(), tick.ask_size) ||
+        !core::parse_uint(last_size.data(), last_size.size(), tick.last_size)) {
+        std::cerr << "Parse error at line " << line_number_ << ": invalid numeric field" << std::endl;
         return false;
     }
+    tick.sequence_number = line_number_;
+    tick.mid_price = (tick.bid_price + tick.ask_price) / 2.0;
+    tick.spread_bps = ((tick.ask_price - tick.bid_price) / tick.mid_price) * 10000.0;
+    tick.is_trade_tick = (tick.last_size > 0);
+    tick.trade_aggressor_side = tick.last_price >= tick.mid_price ?
+        core::Side::BUY : core::Side::SELL;
+    return true;
 }
 bool CSVMarketDataParser::read_next_snapshot(HistoricalOrderBookSnapshot& snapshot) {
     HistoricalTick tick;
@@ -70,35 +160,34 @@ bool CSVMarketDataParser::read_next_snapshot(HistoricalOrderBookSnapshot& snapsh
     return true;
 }
 void CSVMarketDataParser::close() {
-    if (file_.is_open()) {
-        file_.close();
-    }
+    if (data_) {
+        munmap(const_cast<char*>(data_), size_);
+        data_ = nullptr;
+    }
+    if (fd_ >= 0) {
+        ::close(fd_);
+        fd_ = -1;
+    }
+    size_ = 0;
+    end_offset_ = 0;
+    offset_ = 0;
+    block_offset_ = 0;
+    block_separators_ = 0;
+    block_newlines_ = 0;
     line_number_ = 0;
 }
 bool CSVMarketDataParser::has_more_data() const {
-    return file_.good() && !file_.eof();
+    return offset_ < end_offset_;
 }
 size_t CSVMarketDataParser::get_total_records() const {
     return line_number_;
 }
-std::vector<std::string> CSVMarketDataParser::parse_csv_line(const std::string& line) {
-    std::vector<std::string> result;
-    std::stringstream ss(line);
-    std::string field;
-    while (std::getline(ss, field, format_.delimiter)) {
-        field.erase(field.find_last_not_of(" \t\r\n") + 1);
-        field.erase(0, field.find_first_not_of(" \t\r\n"));
-        result.push_back(field);
-    }
-    return result;
-}
-core::TimePoint CSVMarketDataParser::parse_timestamp(const std::string& timestamp_str) {
-    try {
-        uint64_t ns = std::stoull(timestamp_str);
-        return core::TimePoint(std::chrono::nanoseconds(ns));
-    } catch (...) {
+core::TimePoint CSVMarketDataParser::parse_timestamp(std::string_view timestamp_str) {
+    uint64_t ns = 0;
+    if (!core::parse_uint(timestamp_str.data(), timestamp_str.size(), ns)) {
         return std::chrono::steady_clock::now();
     }
+    return core::TimePoint(std::chrono::nanoseconds(ns));
 }
 bool BinaryMarketDataParser::open(const std::string& filename) {
     file_.open(filename, std::ios::binary);
@@ -120,12 +209,7 @@ bool BinaryMarketDataParser::open(const std::string& filename) {
 }
 bool BinaryMarketDataParser::read_next_tick(HistoricalTick& tick) {
     if (!file_.good() || current_position_ >= file_size_) return false;
-    struct BinaryTick {
-        uint64_t timestamp_ns;
-        double bid_price, ask_price, last_price;
-        uint64_t bid_size, ask_size, last_size;
-        uint64_t sequence_number;
-    } binary_tick;
+    BinaryTick binary_tick;
     file_.read(reinterpret_cast<char*>(&binary_tick), sizeof(BinaryTick));
     if (!file_.good()) return false;
     tick.symbol = std::string(header_.symbol);
@@ -174,12 +258,6 @@ bool BinaryMarketDataParser::convert_csv_to_binary(const std::string& csv_file,
     if (!csv_parser.open(csv_file)) return false;
     std::ofstream bin_file(binary_file, std::ios::binary);
     if (!bin_file.is_open()) return false;
-    struct BinaryTick {
-        uint64_t timestamp_ns;
-        double bid_price, ask_price, last_price;
-        uint64_t bid_size, ask_size, last_size;
-        uint64_t sequence_number;
-    };
     BinaryHeader header;
     header.record_count = 0;
     header.start_time_ns = 0;
@@ -213,6 +291,19 @@ bool BinaryMarketDataParser::convert_csv_to_binary(const std::string& csv_file,
     bin_file.close();
     return true;
 }
+std::unique_ptr<MarketDataParser> create_market_data_parser(const std::string& path) {
+    std::error_code error;
+    if (std::filesystem::is_directory(path, error)) {
+        return std::make_unique<MergedMarketDataParser>();
+    } else if (path.ends_with(".csv")) {
+        return std::make_unique<CSVMarketDataParser>();
+    } else if (path.ends_with(".bin")) {
+        return std::make_unique<BinaryMarketDataParser>();
+    } else if (path.ends_with(".tcol")) {
+        return std::make_unique<ColumnarMarketDataParser>();
+    }
+    return nullptr;
+}
 MarketMakingStrategy::MarketMakingStrategy(double spread_bps, uint64_t default_size, double max_position)
     : spread_bps_(spread_bps), default_size_(default_size), max_position_(max_position),
       inventory_skew_factor_(0.1), min_spread_bps_(2.0), max_spread_bps_(20.0),
@@ -385,6 +476,10 @@ bool TickReplayEngine::run_backtest() {
     stats_ = ReplayStats{};
     ticks_processed_ = 0;
     matching_engine_->start();
+    if (config_.start_time != core::TimePoint::min()) {
+        data_parser_->seek(config_.start_time);
+    }
+    const bool time_ordered = data_parser_->is_time_ordered();
     std::map<core::Symbol, double> initial_prices;
     HistoricalTick first_tick;
     if (data_parser_->read_next_tick(first_tick)) {
@@ -399,6 +494,7 @@ bool TickReplayEngine::run_backtest() {
     }
     HistoricalTick tick;
     while (data_parser_->read_next_tick(tick)) {
+        if (time_ordered && tick.timestamp > config_.end_time) break;
         if (!is_tick_in_replay_window(tick)) continue;
         if (!process_tick(tick)) break;
         if (config_.print_progress && ticks_processed_ % config_.progress_interval == 0) {
@@ -546,12 +642,8 @@ bool BacktestingSuite::run_all_backtests() {
 bool BacktestingSuite::run_backtest(size_t job_index) {
     if (job_index >= jobs_.size()) return false;
     auto& job = jobs_[job_index];
-    std::unique_ptr<MarketDataParser> parser;
-    if (job.data_file.ends_with(".csv")) {
-        parser = std::make_unique<CSVMarketDataParser>();
-    } else if (job.data_file.ends_with(".bin")) {
-        parser = std::make_unique<BinaryMarketDataParser>();
-    } else {
+    std::unique_ptr<MarketDataParser> parser = create_market_data_parser(job.data_file);
+    if (!parser) {
         std::cerr << "Unsupported data file format: " << job.data_file << std::endl;
         return false;
     }
@@ -0,0 +1,52 @@
+#include "hft/binary/binary_gateway_codec.hpp"
+namespace hft {
+namespace binary {
+BinaryGatewayCodec::BinaryGatewayCodec(BinaryOrderHandler& handler)
+    : handler_(handler, stats_), connections_(std::make_unique<Connection[]>(fix::FixGateway::MAX_CONNECTIONS)) {}
+fix::FixConnectionId BinaryGatewayCodec::open_connection() {
+    std::lock_guard<std::mutex> lock(connections_mutex_);
+    for (fix::FixConnectionId id = 0; id < fix::FixGateway::MAX_CONNECTIONS; ++id) {
+        if (!connections_[id].open) {
+            connections_[id].open = true;
+            connections_[id].pending.clear();
+            return id;
+        }
+    }
+    return fix::FixGateway::INVALID_CONNECTION;
+}
+bool BinaryGatewayCodec::on_data(fix::FixConnectionId connection_id, const char* data, size_t length) {
+    if (connection_id >= fix::FixGateway::MAX_CONNECTIONS) {
+        return false;
+    }
+    Connection& connection = connections_[connection_id];
+    BinaryDispatchResult result;
+    if (connection.pending.empty()) {
+        result = dispatch_binary_messages(connection_id, data, length, handler_);
+        if (!result.invalid && result.consumed < length) {
+            connection.pending.assign(data + result.consumed, length - result.consumed);
+            stats_.partial_frames_buffered.fetch_add(1, std::memory_order_relaxed);
+        }
+    } else {
+        connection.pending.append(data, length);
+        result = dispatch_binary_messages(connection_id, connection.pending.data(), connection.pending.size(), handler_);
+        connection.pending.erase(0, result.consumed);
+    }
+    stats_.messages_received.fetch_add(result.messages, std::memory_order_relaxed);
+    if (result.invalid) {
+        stats_.invalid_frames.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    return true;
+}
+void BinaryGatewayCodec::close_connection(fix::FixConnectionId connection_id) {
+    if (connection_id >= fix::FixGateway::MAX_CONNECTIONS) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(connections_mutex_);
+        connections_[connection_id].open = false;
+    }
+    handler_.on_session_closed(connection_id);
+}
+}
+}
@@ -0,0 +1,83 @@
+#include "hft/core/mirrored_ring_buffer.hpp"
+#include <iostream>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#ifdef __APPLE__
+#include <atomic>
+#include <string>
+#endif
+namespace hft {
+namespace core {
+namespace {
+size_t round_up_pow2(size_t value) {
+    size_t result = 1;
+    while (result < value) {
+        result <<= 1;
+    }
+    return result;
+}
+int create_backing_fd(size_t capacity) {
+#ifdef __APPLE__
+    static std::atomic<uint64_t> sequence{0};
+    const std::string name = "/hft_ring_" + std::to_string(getpid()) + "_" + std::to_string(sequence.fetch_add(1));
+    const int fd = shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+    if (fd >= 0) {
+        shm_unlink(name.c_str());
+    }
+#else
+    const int fd = memfd_create("hft_ring", MFD_CLOEXEC);
+#endif
+    if (fd >= 0 && ftruncate(fd, static_cast<off_t>(capacity)) != 0) {
+        ::close(fd);
+        return -1;
+    }
+    return fd;
+}
+}
+MirroredRingBuffer::MirroredRingBuffer()
+    : data_(nullptr), capacity_(0), mask_(0), read_position_(0), write_position_(0) {}
+MirroredRingBuffer::~MirroredRingBuffer() {
+    close();
+}
+bool MirroredRingBuffer::open(size_t capacity) {
+    close();
+    capacity = round_up_pow2(std::max(capacity, static_cast<size_t>(sysconf(_SC_PAGESIZE))));
+    const int fd = create_backing_fd(capacity);
+    if (fd < 0) {
+        std::cerr << "Failed to create ring buffer backing of " << capacity << " bytes" << std::endl;
+        return false;
+    }
+    void* reserved = mmap(nullptr, capacity * 2, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (reserved == MAP_FAILED) {
+        std::cerr << "Failed to reserve ring buffer address space" << std::endl;
+        ::close(fd);
+        return false;
+    }
+    char* base = static_cast<char*>(reserved);
+    const bool mirrored =
+        mmap(base, capacity, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) != MAP_FAILED &&
+        mmap(base + capacity, capacity, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) != MAP_FAILED;
+    ::close(fd);
+    if (!mirrored) {
+        std::cerr << "Failed to mirror ring buffer mapping" << std::endl;
+        munmap(base, capacity * 2);
+        return false;
+    }
+    data_ = base;
+    capacity_ = capacity;
+    mask_ = capacity - 1;
+    clear();
+    return true;
+}
+void MirroredRingBuffer::close() {
+    if (data_) {
+        munmap(data_, capacity_ * 2);
+        data_ = nullptr;
+    }
+    capacity_ = 0;
+    mask_ = 0;
+    clear();
+}
+}
+}
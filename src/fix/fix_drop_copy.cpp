@@ -0,0 +1,478 @@
+#include "hft/fix/fix_drop_copy.hpp"
+#include "hft/fix/fix_message_view.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+namespace hft {
+namespace fix {
+namespace {
+constexpr char SEGMENT_MAGIC[8] = {'H', 'F', 'T', 'D', 'C', 'O', 'P', 'Y'};
+constexpr size_t SEGMENT_PAGE_SIZE = 4096;
+constexpr const char* SEGMENT_EXTENSION = ".dcl";
+constexpr const char* INDEX_EXTENSION = ".idx";
+constexpr const char* STANDBY_EXTENSION = ".standby";
+std::atomic<uint64_t> next_log_instance_id{1};
+inline size_t align_up(size_t value, size_t alignment) {
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+inline std::string_view record_cl_ord_id(const char* data, size_t length, FixMessageView& view) {
+    return view.parse(data, length) ? view.get_field(Tags::CL_ORD_ID) : std::string_view();
+}
+}
+uint64_t drop_copy_key_hash(std::string_view cl_ord_id) {
+    uint64_t hash = 14695981039346656037ull;
+    for (char c : cl_ord_id) {
+        hash = (hash ^ static_cast<uint8_t>(c)) * 1099511628211ull;
+    }
+    return hash;
+}
+FixDropCopyLog::Segment::~Segment() {
+    if (mapping) {
+        munmap(mapping, capacity);
+    }
+    if (fd >= 0) {
+        ::close(fd);
+    }
+    if (index_fd >= 0) {
+        ::close(index_fd);
+    }
+}
+FixDropCopyLog::FixDropCopyLog(const FixDropCopyConfig& config)
+    : config_(config), instance_id_(next_log_instance_id.fetch_add(1, std::memory_order_relaxed)),
+      overflow_producer_(std::make_unique<Producer>(std::thread::id(), config.producer_ring_capacity)),
+      next_segment_index_(0), running_(false) {
+    config_.segment_size = align_up(std::max(config_.segment_size, SEGMENT_PAGE_SIZE * 2), SEGMENT_PAGE_SIZE);
+}
+FixDropCopyLog::~FixDropCopyLog() {
+    close();
+}
+std::string FixDropCopyLog::segment_path(uint32_t segment_index) const {
+    char name[32];
+    std::snprintf(name, sizeof(name), ".%06u", segment_index);
+    return config_.directory + "/" + config_.prefix + name + SEGMENT_EXTENSION;
+}
+bool FixDropCopyLog::open() {
+    if (running_.load()) {
+        return true;
+    }
+    std::error_code error;
+    std::filesystem::create_directories(config_.directory, error);
+    next_segment_index_ = 0;
+    const std::string stem = config_.prefix + ".";
+    for (const auto& entry : std::filesystem::directory_iterator(config_.directory, error)) {
+        const std::string name = entry.path().filename().string();
+        if (name.size() > stem.size() && name.compare(0, stem.size(), stem) == 0 &&
+            entry.path().extension() == SEGMENT_EXTENSION) {
+            const uint32_t existing = static_cast<uint32_t>(std::strtoul(name.c_str() + stem.size(), nullptr, 10));
+            next_segment_index_ = std::max(next_segment_index_, existing + 1);
+        }
+    }
+    active_ = create_segment(next_segment_index_, segment_path(next_segment_index_));
+    ++next_segment_index_;
+    if (!active_) {
+        return false;
+    }
+    standby_ = create_segment(next_segment_index_, segment_path(next_segment_index_));
+    next_segment_index_ += standby_ ? 1 : 0;
+    running_.store(true);
+    writer_thread_ = std::thread([this]() { writer_loop(); });
+    flusher_thread_ = std::thread([this]() { flusher_loop(); });
+    return true;
+}
+void FixDropCopyLog::close() {
+    if (!running_.exchange(false)) {
+        return;
+    }
+    writer_doorbell_.ring();
+    if (writer_thread_.joinable()) {
+        writer_thread_.join();
+    }
+    {
+        std::lock_guard<std::mutex> lock(flusher_mutex_);
+        flusher_cv_.notify_one();
+    }
+    if (flusher_thread_.joinable()) {
+        flusher_thread_.join();
+    }
+    maintain(true);
+    std::lock_guard<std::mutex> lock(segment_mutex_);
+    if (active_) {
+        finish_segment(*active_);
+        active_.reset();
+    }
+    if (standby_) {
+        std::filesystem::remove(standby_->path);
+        std::filesystem::remove(standby_->path + INDEX_EXTENSION);
+        standby_.reset();
+    }
+}
+void FixDropCopyLog::sync() {
+    std::lock_guard<std::mutex> lock(flusher_mutex_);
+    flusher_cv_.notify_one();
+}
+std::shared_ptr<FixDropCopyLog::Segment> FixDropCopyLog::create_segment(uint32_t segment_index, const std::string& path) {
+    auto segment = std::make_shared<Segment>();
+    segment->index = segment_index;
+    segment->capacity = config_.segment_size;
+    segment->path = path;
+    segment->fd = ::open(segment->path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (segment->fd < 0 || ftruncate(segment->fd, static_cast<off_t>(segment->capacity)) != 0) {
+        std::cerr << "Failed to create drop-copy segment: " << segment->path << std::endl;
+        return nullptr;
+    }
+    void* mapping = mmap(nullptr, segment->capacity, PROT_READ | PROT_WRITE, MAP_SHARED, segment->fd, 0);
+    if (mapping == MAP_FAILED) {
+        std::cerr << "Failed to map drop-copy segment: " << segment->path << std::endl;
+        return nullptr;
+    }
+    segment->mapping = static_cast<char*>(mapping);
+    for (size_t offset = 0; offset < segment->capacity; offset += SEGMENT_PAGE_SIZE) {
+        segment->mapping[offset] = 0;
+    }
+    FixDropCopySegmentHeader* header = segment->header();
+    std::memcpy(header->magic, SEGMENT_MAGIC, sizeof(SEGMENT_MAGIC));
+    header->version = FORMAT_VERSION;
+    header->segment_index = segment_index;
+    header->capacity = segment->capacity;
+    header->committed = sizeof(FixDropCopySegmentHeader);
+    segment->synced = 0;
+    segment->indexed = sizeof(FixDropCopySegmentHeader);
+    segment->index_fd = ::open((segment->path + INDEX_EXTENSION).c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_APPEND,
+                               0644);
+    return segment;
+}
+FixDropCopyLog::Producer& FixDropCopyLog::register_producer() {
+    const std::thread::id thread_id = std::this_thread::get_id();
+    std::lock_guard<std::mutex> lock(registration_mutex_);
+    const size_t count = producer_count_.load(std::memory_order_relaxed);
+    for (size_t i = 0; i < count; ++i) {
+        if (producers_[i]->owner == thread_id) {
+            return *producers_[i];
+        }
+    }
+    if (count == MAX_PRODUCERS) {
+        if (!overflow_reported_.exchange(true)) {
+            std::cerr << "Drop-copy producer limit " << MAX_PRODUCERS
+                      << " reached; further threads share a locked ring" << std::endl;
+        }
+        return *overflow_producer_;
+    }
+    producers_[count] = std::make_unique<Producer>(thread_id, config_.producer_ring_capacity);
+    producer_count_.store(count + 1, std::memory_order_release);
+    return *producers_[count];
+}
+bool FixDropCopyLog::append(FixDropCopyDirection direction, uint32_t session, const char* data, size_t length,
+                            uint64_t timestamp_ns) {
+    const size_t record_size = align_up(sizeof(FixDropCopyRecordHeader) + length, RECORD_ALIGNMENT);
+    if (!running_.load(std::memory_order_acquire) || length == 0 ||
+        record_size + sizeof(FixDropCopySegmentHeader) > config_.segment_size) {
+        stats_.records_dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    const FixDropCopyRecordHeader header{timestamp_ns, static_cast<uint32_t>(length), session,
+                                         static_cast<uint8_t>(direction), {}};
+    Producer& producer = local_producer();
+    if (&producer == overflow_producer_.get()) {
+        std::lock_guard<std::mutex> lock(overflow_mutex_);
+        return enqueue(producer, header, data, length);
+    }
+    return enqueue(producer, header, data, length);
+}
+bool FixDropCopyLog::enqueue(Producer& producer, const FixDropCopyRecordHeader& header, const char* data,
+                             size_t length) {
+    const auto fill = [&](PendingRecord& pending) {
+        pending.header = header;
+        pending.data.assign(data, length);
+    };
+    if (!producer.ring.try_produce(fill)) {
+        stats_.ingress_stalls.fetch_add(1, std::memory_order_relaxed);
+        writer_doorbell_.ring();
+        core::WaitStrategy wait(core::WaitStrategyConfig{core::WaitStrategyType::SPIN_YIELD,
+                                                         WRITER_SPIN_ITERATIONS, 0});
+        const bool produced = wait.retry_until([&]() {
+            return running_.load(std::memory_order_relaxed) && producer.ring.try_produce(fill);
+        }, config_.ingress_timeout_ns);
+        if (!produced) {
+            stats_.records_dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+    }
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (producer.ring.size() <= 1) {
+        stats_.doorbell_rings.fetch_add(1, std::memory_order_relaxed);
+        writer_doorbell_.ring();
+    }
+    return true;
+}
+void FixDropCopyLog::writer_loop() {
+    core::WaitStrategy wait(core::WaitStrategyConfig{core::WaitStrategyType::SPIN_FUTEX, WRITER_SPIN_ITERATIONS, 0},
+                            &writer_doorbell_);
+    for (;;) {
+        const bool stopping = !running_.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        size_t drained = 0;
+        {
+            std::lock_guard<std::mutex> lock(segment_mutex_);
+            const size_t count = producer_count_.load(std::memory_order_acquire);
+            for (size_t i = 0; i < count; ++i) {
+                drained += drain_producer(*producers_[i]);
+            }
+            drained += drain_producer(*overflow_producer_);
+        }
+        if (drained != 0) {
+            wait.reset();
+            continue;
+        }
+        if (stopping) {
+            return;
+        }
+        wait.idle();
+    }
+}
+size_t FixDropCopyLog::drain_producer(Producer& producer) {
+    size_t drained = 0;
+    while (drained < WRITER_BATCH &&
+           producer.ring.try_consume([this](PendingRecord& pending) { write_record(pending); })) {
+        ++drained;
+    }
+    return drained;
+}
+void FixDropCopyLog::write_record(const PendingRecord& pending) {
+    const size_t length = pending.data.size();
+    const size_t record_size = align_up(sizeof(FixDropCopyRecordHeader) + length, RECORD_ALIGNMENT);
+    if (!active_ || (active_->header()->committed + record_size > active_->capacity && !roll_segment())) {
+        stats_.records_dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    FixDropCopySegmentHeader* header = active_->header();
+    char* const out = active_->mapping + header->committed;
+    std::memcpy(out, &pending.header, sizeof(pending.header));
+    std::memcpy(out + sizeof(pending.header), pending.data.data(), length);
+    header->committed += record_size;
+    stats_.records_written.fetch_add(1, std::memory_order_relaxed);
+    stats_.bytes_written.fetch_add(length, std::memory_order_relaxed);
+}
+bool FixDropCopyLog::roll_segment() {
+    std::shared_ptr<Segment> next = std::move(standby_);
+    if (!next) {
+        next = create_segment(next_segment_index_, segment_path(next_segment_index_));
+        ++next_segment_index_;
+        stats_.writer_segment_creates.fetch_add(1, std::memory_order_relaxed);
+        if (!next) {
+            return false;
+        }
+    }
+    retired_.push_back(std::move(active_));
+    active_ = std::move(next);
+    stats_.segments_rolled.fetch_add(1, std::memory_order_relaxed);
+    flusher_cv_.notify_one();
+    return true;
+}
+void FixDropCopyLog::flusher_loop() {
+    while (running_.load()) {
+        {
+            std::unique_lock<std::mutex> lock(flusher_mutex_);
+            flusher_cv_.wait_for(lock, std::chrono::milliseconds(config_.sync_interval_ms));
+        }
+        maintain(false);
+    }
+}
+void FixDropCopyLog::maintain(bool final_pass) {
+    std::shared_ptr<Segment> active;
+    std::vector<std::shared_ptr<Segment>> retired;
+    uint64_t committed = 0;
+    bool need_standby = false;
+    {
+        std::lock_guard<std::mutex> lock(segment_mutex_);
+        active = active_;
+        committed = active ? active->header()->committed : 0;
+        retired.swap(retired_);
+        need_standby = !final_pass && !standby_;
+    }
+    for (auto& segment : retired) {
+        index_segment(*segment, segment->header()->committed);
+        finish_segment(*segment);
+    }
+    if (active && committed > active->synced) {
+        index_segment(*active, committed);
+        const size_t begin = active->synced & ~(SEGMENT_PAGE_SIZE - 1);
+        msync(active->mapping + begin, committed - begin, MS_ASYNC);
+        active->synced = committed;
+        stats_.syncs.fetch_add(1, std::memory_order_relaxed);
+    }
+    if (need_standby) {
+        std::shared_ptr<Segment> segment = create_segment(0, config_.directory + "/" + config_.prefix +
+                                                              STANDBY_EXTENSION);
+        if (!segment) {
+            return;
+        }
+        std::lock_guard<std::mutex> lock(segment_mutex_);
+        const std::string path = segment_path(next_segment_index_);
+        std::error_code error;
+        std::filesystem::rename(segment->path + INDEX_EXTENSION, path + INDEX_EXTENSION, error);
+        if (!error) {
+            std::filesystem::rename(segment->path, path, error);
+        }
+        if (error || !running_.load()) {
+            std::filesystem::remove(segment->path, error);
+            std::filesystem::remove(segment->path + INDEX_EXTENSION, error);
+            std::filesystem::remove(path, error);
+            std::filesystem::remove(path + INDEX_EXTENSION, error);
+            return;
+        }
+        segment->index = next_segment_index_++;
+        segment->path = path;
+        segment->header()->segment_index = segment->index;
+        standby_ = std::move(segment);
+    }
+}
+void FixDropCopyLog::index_segment(Segment& segment, uint64_t committed) {
+    FixMessageView view;
+    std::vector<FixDropCopyIndexEntry> entries;
+    uint64_t position = segment.indexed;
+    while (position + sizeof(FixDropCopyRecordHeader) <= committed) {
+        FixDropCopyRecordHeader record;
+        std::memcpy(&record, segment.mapping + position, sizeof(record));
+        const std::string_view cl_ord_id = record_cl_ord_id(
+            segment.mapping + position + sizeof(record), record.length, view);
+        if (!cl_ord_id.empty()) {
+            entries.push_back(FixDropCopyIndexEntry{drop_copy_key_hash(cl_ord_id), position});
+        }
+        position += align_up(sizeof(record) + record.length, RECORD_ALIGNMENT);
+    }
+    segment.indexed = position;
+    if (!entries.empty() && segment.index_fd >= 0) {
+        const size_t bytes = entries.size() * sizeof(FixDropCopyIndexEntry);
+        if (::write(segment.index_fd, entries.data(), bytes) != static_cast<ssize_t>(bytes)) {
+            std::cerr << "Failed to write drop-copy index: " << segment.path << INDEX_EXTENSION << std::endl;
+        }
+        stats_.records_indexed.fetch_add(entries.size(), std::memory_order_relaxed);
+    }
+}
+void FixDropCopyLog::finish_segment(Segment& segment) {
+    if (!segment.mapping) {
+        return;
+    }
+    index_segment(segment, segment.header()->committed);
+    const uint64_t committed = segment.header()->committed;
+    msync(segment.mapping, committed, MS_SYNC);
+    munmap(segment.mapping, segment.capacity);
+    segment.mapping = nullptr;
+    if (ftruncate(segment.fd, static_cast<off_t>(committed)) != 0) {
+        std::cerr << "Failed to trim drop-copy segment: " << segment.path << std::endl;
+    }
+    fsync(segment.fd);
+    if (segment.index_fd >= 0) {
+        fsync(segment.index_fd);
+    }
+    stats_.syncs.fetch_add(1, std::memory_order_relaxed);
+}
+FixDropCopyReader::FixDropCopyReader()
+    : fd_(-1), mapping_(nullptr), mapping_size_(0), committed_(0), position_(0) {}
+FixDropCopyReader::~FixDropCopyReader() {
+    close();
+}
+bool FixDropCopyReader::open(const std::string& segment_path) {
+    close();
+    fd_ = ::open(segment_path.c_str(), O_RDONLY);
+    struct stat file_stat;
+    if (fd_ < 0 || fstat(fd_, &file_stat) != 0 ||
+        static_cast<size_t>(file_stat.st_size) < sizeof(FixDropCopySegmentHeader)) {
+        std::cerr << "Failed to open drop-copy segment: " << segment_path << std::endl;
+        close();
+        return false;
+    }
+    mapping_size_ = static_cast<size_t>(file_stat.st_size);
+    void* mapping = mmap(nullptr, mapping_size_, PROT_READ, MAP_SHARED, fd_, 0);
+    if (mapping == MAP_FAILED) {
+        std::cerr << "Failed to map drop-copy segment: " << segment_path << std::endl;
+        mapping_size_ = 0;
+        close();
+        return false;
+    }
+    mapping_ = static_cast<char*>(mapping);
+    FixDropCopySegmentHeader header;
+    std::memcpy(&header, mapping_, sizeof(header));
+    if (std::memcmp(header.magic, SEGMENT_MAGIC, sizeof(SEGMENT_MAGIC)) != 0 ||
+        header.version != FixDropCopyLog::FORMAT_VERSION) {
+        std::cerr << "Invalid drop-copy segment: " << segment_path << std::endl;
+        close();
+        return false;
+    }
+    committed_ = std::min<uint64_t>(header.committed, mapping_size_);
+    path_ = segment_path;
+    rewind();
+    return true;
+}
+void FixDropCopyReader::close() {
+    if (mapping_) {
+        munmap(mapping_, mapping_size_);
+        mapping_ = nullptr;
+    }
+    if (fd_ >= 0) {
+        ::close(fd_);
+        fd_ = -1;
+    }
+    mapping_size_ = 0;
+    committed_ = 0;
+    position_ = 0;
+}
+void FixDropCopyReader::rewind() {
+    position_ = sizeof(FixDropCopySegmentHeader);
+}
+bool FixDropCopyReader::read_at(uint64_t offset, FixDropCopyRecord& record) const {
+    if (offset < sizeof(FixDropCopySegmentHeader) || offset + sizeof(FixDropCopyRecordHeader) > committed_) {
+        return false;
+    }
+    FixDropCopyRecordHeader header;
+    std::memcpy(&header, mapping_ + offset, sizeof(header));
+    if (offset + sizeof(header) + header.length > committed_) {
+        return false;
+    }
+    record.timestamp_ns = header.timestamp_ns;
+    record.session = header.session;
+    record.direction = static_cast<FixDropCopyDirection>(header.direction);
+    record.offset = offset;
+    record.data = std::string_view(mapping_ + offset + sizeof(header), header.length);
+    return true;
+}
+bool FixDropCopyReader::next(FixDropCopyRecord& record) {
+    if (!read_at(position_, record)) {
+        return false;
+    }
+    position_ += align_up(sizeof(FixDropCopyRecordHeader) + record.data.size(), FixDropCopyLog::RECORD_ALIGNMENT);
+    return true;
+}
+size_t FixDropCopyReader::find(std::string_view cl_ord_id, std::vector<FixDropCopyRecord>& records) const {
+    const int index_fd = ::open((path_ + INDEX_EXTENSION).c_str(), O_RDONLY);
+    if (index_fd < 0) {
+        return 0;
+    }
+    const uint64_t key = drop_copy_key_hash(cl_ord_id);
+    FixMessageView view;
+    FixDropCopyIndexEntry entries[512];
+    size_t found = 0;
+    ssize_t bytes;
+    while ((bytes = ::read(index_fd, entries, sizeof(entries))) > 0) {
+        const size_t count = static_cast<size_t>(bytes) / sizeof(FixDropCopyIndexEntry);
+        for (size_t i = 0; i < count; ++i) {
+            FixDropCopyRecord record;
+            if (entries[i].cl_ord_id_hash == key && read_at(entries[i].record_offset, record) &&
+                record_cl_ord_id(record.data.data(), record.data.size(), view) == cl_ord_id) {
+                records.push_back(record);
+                ++found;
+            }
+        }
+    }
+    ::close(index_fd);
+    return found;
+}
+}
+}
@@ -0,0 +1,134 @@
+#include "hft/fix/fix_encoder.hpp"
+#include "hft/core/simd_scan.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+namespace hft {
+namespace fix {
+namespace {
+constexpr FixLiteral SENDING_TIME_PREFIX{"\x01" "52="};
+inline char* write_two_digits(char* out, uint32_t value) {
+    std::memcpy(out, &core::DIGIT_PAIRS[value * 2], 2);
+    return out + 2;
+}
+inline void civil_from_days(int64_t days, int32_t& year, uint32_t& month, uint32_t& day) {
+    days += 719468;
+    const int64_t era = (days >= 0 ? days : days - 146096) / 146097;
+    const uint32_t day_of_era = static_cast<uint32_t>(days - era * 146097);
+    const uint32_t year_of_era = (day_of_era - day_of_era / 1460 + day_of_era / 36524 - day_of_era / 146096) / 365;
+    const uint32_t day_of_year = day_of_era - (365 * year_of_era + year_of_era / 4 - year_of_era / 100);
+    const uint32_t month_index = (5 * day_of_year + 2) / 153;
+    day = day_of_year - (153 * month_index + 2) / 5 + 1;
+    month = month_index < 10 ? month_index + 3 : month_index - 9;
+    year = static_cast<int32_t>(year_of_era + era * 400 + (month <= 2));
+}
+}
+size_t format_fix_timestamp(uint64_t epoch_ns, char* out) {
+    const uint64_t epoch_ms = epoch_ns / 1000000;
+    const uint64_t epoch_s = epoch_ms / 1000;
+    const uint32_t second_of_day = static_cast<uint32_t>(epoch_s % 86400);
+    int32_t year;
+    uint32_t month;
+    uint32_t day;
+    civil_from_days(static_cast<int64_t>(epoch_s / 86400), year, month, day);
+    char* cursor = write_two_digits(out, static_cast<uint32_t>(year / 100));
+    cursor = write_two_digits(cursor, static_cast<uint32_t>(year % 100));
+    cursor = write_two_digits(cursor, month);
+    cursor = write_two_digits(cursor, day);
+    *cursor++ = '-';
+    cursor = write_two_digits(cursor, second_of_day / 3600);
+    *cursor++ = ':';
+    cursor = write_two_digits(cursor, second_of_day / 60 % 60);
+    *cursor++ = ':';
+    cursor = write_two_digits(cursor, second_of_day % 60);
+    *cursor++ = '.';
+    const uint32_t millis = static_cast<uint32_t>(epoch_ms % 1000);
+    *cursor++ = static_cast<char>('0' + millis / 100);
+    cursor = write_two_digits(cursor, millis % 100);
+    return static_cast<size_t>(cursor - out);
+}
+void FixFieldWriter::put_fixed(double value, int decimals) {
+    switch (std::clamp(decimals, 0, 8)) {
+        case 0: put_fixed<0>(value); break;
+        case 1: put_fixed<1>(value); break;
+        case 2: put_fixed<2>(value); break;
+        case 3: put_fixed<3>(value); break;
+        case 4: put_fixed<4>(value); break;
+        case 5: put_fixed<5>(value); break;
+        case 6: put_fixed<6>(value); break;
+        case 7: put_fixed<7>(value); break;
+        default: put_fixed<8>(value); break;
+    }
+}
+void FixFieldWriter::put_timestamp(uint64_t epoch_ns) {
+    const size_t length = format_fix_timestamp(epoch_ns, cursor_);
+    for (size_t i = 0; i < length; ++i) {
+        sum_ += static_cast<uint8_t>(cursor_[i]);
+    }
+    cursor_ += length;
+}
+FixMessageEncoder::FixMessageEncoder(std::string_view sender_comp_id, std::string_view target_comp_id,
+                                     std::string_view begin_string)
+    : begin_prefix_sum_(0), header_sum_(0), cached_second_(UINT64_MAX), cached_timestamp_{},
+      cached_timestamp_sum_(0) {
+    begin_prefix_ = "8=";
+    begin_prefix_ += begin_string;
+    begin_prefix_ += FIX_SOH;
+    begin_prefix_ += "9=";
+    for (char c : begin_prefix_) {
+        begin_prefix_sum_ += static_cast<uint8_t>(c);
+    }
+    header_ = "49=";
+    header_ += sender_comp_id;
+    header_ += FIX_SOH;
+    header_ += "56=";
+    header_ += target_comp_id;
+    header_ += FIX_SOH;
+    header_ += "34=";
+    header_sum_ = static_cast<uint32_t>(core::byte_sum(header_.data(), header_.size()));
+    body_offset_ = begin_prefix_.size() + BODY_LENGTH_DIGITS + 1;
+    const size_t fixed_length = sizeof(FixLiteral::text) + header_.size() + 10 + SENDING_TIME_PREFIX.length +
+                                FIX_TIMESTAMP_LENGTH + 1 + FIX_TRAILER_LENGTH;
+    field_capacity_ = buffer_.size() - std::min(buffer_.size(), body_offset_ + fixed_length);
+}
+void FixMessageEncoder::write_header(FixFieldWriter& writer, uint32_t msg_seq_num, uint64_t sending_time_ns) {
+    writer.put_precomputed(header_, header_sum_);
+    writer.put_uint(msg_seq_num);
+    writer.put_literal(SENDING_TIME_PREFIX);
+    const uint64_t sending_second = sending_time_ns / 1000000000;
+    if (sending_second != cached_second_) {
+        format_fix_timestamp(sending_time_ns, cached_timestamp_.data());
+        cached_second_ = sending_second;
+        cached_timestamp_sum_ = static_cast<uint32_t>(core::byte_sum(cached_timestamp_.data(), FIX_TIMESTAMP_LENGTH - 3));
+    }
+    const uint32_t millis = static_cast<uint32_t>(sending_time_ns / 1000000 % 1000);
+    writer.put_precomputed(std::string_view(cached_timestamp_.data(), FIX_TIMESTAMP_LENGTH - 3), cached_timestamp_sum_);
+    writer.put_char(static_cast<char>('0' + millis / 100));
+    writer.put_char(core::DIGIT_PAIRS[(millis % 100) * 2]);
+    writer.put_char(core::DIGIT_PAIRS[(millis % 100) * 2 + 1]);
+}
+std::string_view FixMessageEncoder::finish(char* body, FixFieldWriter& writer) {
+    writer.put_char(FIX_SOH);
+    const size_t body_length = static_cast<size_t>(writer.cursor() - body);
+    char length_digits[20];
+    const size_t length_digit_count = static_cast<size_t>(core::format_uint(length_digits, body_length) - length_digits);
+    char* const start = body - 1 - length_digit_count - begin_prefix_.size();
+    std::memcpy(start, begin_prefix_.data(), begin_prefix_.size());
+    std::memcpy(start + begin_prefix_.size(), length_digits, length_digit_count);
+    body[-1] = FIX_SOH;
+    uint32_t checksum = begin_prefix_sum_ + static_cast<uint8_t>(FIX_SOH) + writer.sum();
+    for (size_t i = 0; i < length_digit_count; ++i) {
+        checksum += static_cast<uint8_t>(length_digits[i]);
+    }
+    checksum %= 256;
+    char* trailer = writer.cursor();
+    trailer[0] = '1';
+    trailer[1] = '0';
+    trailer[2] = FIX_EQUALS;
+    trailer[3] = static_cast<char>('0' + checksum / 100);
+    write_two_digits(trailer + 4, checksum % 100);
+    trailer[6] = FIX_SOH;
+    return std::string_view(start, static_cast<size_t>(trailer + FIX_TRAILER_LENGTH - start));
+}
+}
+}
@@ -0,0 +1,553 @@
+#include "hft/fix/fix_gateway.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#ifdef __APPLE__
+#include <sys/event.h>
+#else
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#endif
+namespace hft {
+namespace fix {
+namespace {
+constexpr uint64_t LISTEN_TOKEN = FixGateway::MAX_CONNECTIONS;
+constexpr uint64_t WAKE_TOKEN = FixGateway::MAX_CONNECTIONS + 1;
+#ifdef __APPLE__
+constexpr int SEND_FLAGS = 0;
+#else
+constexpr int SEND_FLAGS = MSG_NOSIGNAL;
+#endif
+inline bool set_non_blocking(int fd) {
+    const int flags = fcntl(fd, F_GETFL, 0);
+    return flags >= 0 && fcntl(fd, F_SETFL, flags | O_NONBLOCK) == 0;
+}
+inline bool would_block(int error) {
+    return error == EAGAIN || error == EWOULDBLOCK;
+}
+}
+FixGateway::FixGateway(FixParser& parser, const FixGatewayConfig& config)
+    : owned_codec_(std::make_unique<FixParserCodec>(parser)), codec_(*owned_codec_), config_(config), listen_fd_(-1),
+      poll_fd_(-1), wake_fd_(-1), bound_port_(0), running_(false) {}
+FixGateway::FixGateway(GatewayCodec& codec, const FixGatewayConfig& config)
+    : codec_(codec), config_(config), listen_fd_(-1), poll_fd_(-1), wake_fd_(-1), bound_port_(0), running_(false) {}
+FixGateway::~FixGateway() {
+    stop();
+}
+bool FixGateway::start() {
+    if (running_.load()) {
+        return true;
+    }
+    if (!codec_.ready()) {
+        std::cerr << "FIX gateway requires a ready codec (a running FixParser with an inline handler)" << std::endl;
+        return false;
+    }
+    read_buffer_ = std::make_unique<char[]>(config_.read_buffer_size);
+    if (!connections_) {
+        connections_ = std::make_unique<Connection[]>(MAX_CONNECTIONS);
+    }
+#ifdef __APPLE__
+    poll_fd_ = kqueue();
+#else
+    poll_fd_ = epoll_create1(EPOLL_CLOEXEC);
+#endif
+    if (poll_fd_ < 0) {
+        std::cerr << "Failed to create FIX gateway poller: " << std::strerror(errno) << std::endl;
+        return false;
+    }
+    if (!open_wakeup() || !open_listener() || !watch(listen_fd_, LISTEN_TOKEN, false)) {
+        stop();
+        return false;
+    }
+    running_.store(true);
+    event_thread_ = std::thread([this]() { event_loop(); });
+    return true;
+}
+void FixGateway::stop() {
+    running_.store(false);
+    if (event_thread_.joinable()) {
+        event_thread_.join();
+    }
+    {
+        std::lock_guard<std::mutex> lock(handoff_list_mutex_);
+        close_requests_.clear();
+    }
+    for (FixConnectionId id = 0; connections_ && id < MAX_CONNECTIONS; ++id) {
+        close_now(id);
+    }
+    if (listen_fd_ >= 0) {
+        ::close(listen_fd_);
+        listen_fd_ = -1;
+    }
+    if (wake_fd_ >= 0) {
+        ::close(wake_fd_);
+        wake_fd_ = -1;
+    }
+    if (poll_fd_ >= 0) {
+        ::close(poll_fd_);
+        poll_fd_ = -1;
+    }
+}
+bool FixGateway::open_listener() {
+    listen_fd_ = ::socket(AF_INET, SOCK_STREAM, 0);
+    if (listen_fd_ < 0) {
+        std::cerr << "Failed to create FIX gateway socket: " << std::strerror(errno) << std::endl;
+        return false;
+    }
+    const int enable = 1;
+    setsockopt(listen_fd_, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable));
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(config_.port);
+    if (inet_pton(AF_INET, config_.bind_address.c_str(), &address.sin_addr) != 1) {
+        std::cerr << "Invalid FIX gateway bind address: " << config_.bind_address << std::endl;
+        return false;
+    }
+    if (!set_non_blocking(listen_fd_) ||
+        ::bind(listen_fd_, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+        ::listen(listen_fd_, config_.listen_backlog) != 0) {
+        std::cerr << "Failed to listen on FIX gateway port " << config_.port << ": " << std::strerror(errno)
+                  << std::endl;
+        return false;
+    }
+    socklen_t length = sizeof(address);
+    getsockname(listen_fd_, reinterpret_cast<sockaddr*>(&address), &length);
+    bound_port_ = ntohs(address.sin_port);
+    return true;
+}
+bool FixGateway::watch(int fd, uint64_t token, bool writable) {
+#ifdef __APPLE__
+    struct kevent changes[2];
+    void* const user_data = reinterpret_cast<void*>(static_cast<uintptr_t>(token));
+    EV_SET(&changes[0], fd, EVFILT_READ, EV_ADD | EV_CLEAR, 0, 0, user_data);
+    EV_SET(&changes[1], fd, EVFILT_WRITE, EV_ADD | EV_CLEAR, 0, 0, user_data);
+    return kevent(poll_fd_, changes, writable ? 2 : 1, nullptr, 0, nullptr) == 0;
+#else
+    epoll_event event{};
+    event.events = EPOLLIN | EPOLLRDHUP | EPOLLET | (writable ? static_cast<uint32_t>(EPOLLOUT) : 0u);
+    event.data.u64 = token;
+    return epoll_ctl(poll_fd_, EPOLL_CTL_ADD, fd, &event) == 0;
+#endif
+}
+bool FixGateway::open_wakeup() {
+#ifdef __APPLE__
+    struct kevent change;
+    EV_SET(&change, WAKE_TOKEN, EVFILT_USER, EV_ADD | EV_CLEAR, 0, 0, reinterpret_cast<void*>(WAKE_TOKEN));
+    if (kevent(poll_fd_, &change, 1, nullptr, 0, nullptr) == 0) {
+        return true;
+    }
+#else
+    wake_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (wake_fd_ >= 0 && watch(wake_fd_, WAKE_TOKEN, false)) {
+        return true;
+    }
+#endif
+    std::cerr << "Failed to create FIX gateway wakeup: " << std::strerror(errno) << std::endl;
+    return false;
+}
+void FixGateway::wake() {
+    stats_.handoff_wakeups.fetch_add(1, std::memory_order_relaxed);
+#ifdef __APPLE__
+    struct kevent change;
+    EV_SET(&change, WAKE_TOKEN, EVFILT_USER, 0, NOTE_TRIGGER, 0, reinterpret_cast<void*>(WAKE_TOKEN));
+    kevent(poll_fd_, &change, 1, nullptr, 0, nullptr);
+#else
+    const uint64_t one = 1;
+    [[maybe_unused]] const ssize_t written = ::write(wake_fd_, &one, sizeof(one));
+#endif
+}
+void FixGateway::event_loop() {
+    while (running_.load(std::memory_order_relaxed)) {
+        poll_once(config_.poll_timeout_ms);
+        codec_.on_timer(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count()));
+        flush_batches();
+    }
+}
+size_t FixGateway::poll_once(int timeout_ms) {
+#ifdef __APPLE__
+    struct kevent events[MAX_POLL_EVENTS];
+    const timespec timeout{timeout_ms / 1000, (timeout_ms % 1000) * 1000000L};
+    const int count = kevent(poll_fd_, nullptr, 0, events, MAX_POLL_EVENTS, timeout_ms < 0 ? nullptr : &timeout);
+#else
+    epoll_event events[MAX_POLL_EVENTS];
+    const int count = epoll_wait(poll_fd_, events, MAX_POLL_EVENTS, timeout_ms);
+#endif
+    if (count <= 0) {
+        return 0;
+    }
+    stats_.poll_wakeups.fetch_add(1, std::memory_order_relaxed);
+    for (int i = 0; i < count; ++i) {
+#ifdef __APPLE__
+        const uint64_t token = reinterpret_cast<uintptr_t>(events[i].udata);
+        const bool readable = events[i].filter == EVFILT_READ || (events[i].flags & (EV_EOF | EV_ERROR));
+        const bool writable = events[i].filter == EVFILT_WRITE;
+#else
+        const uint64_t token = events[i].data.u64;
+        const bool readable = events[i].events & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR);
+        const bool writable = events[i].events & EPOLLOUT;
+#endif
+        if (token == LISTEN_TOKEN) {
+            accept_connections();
+            continue;
+        }
+        if (token == WAKE_TOKEN) {
+#ifndef __APPLE__
+            uint64_t value = 0;
+            [[maybe_unused]] const ssize_t drained = ::read(wake_fd_, &value, sizeof(value));
+#endif
+            drain_handoffs();
+            continue;
+        }
+        const FixConnectionId connection_id = static_cast<FixConnectionId>(token);
+        if (readable) {
+            read_connection(connection_id);
+        }
+        if (writable) {
+            flush(connection_id);
+        }
+    }
+    flush_batches();
+    return static_cast<size_t>(count);
+}
+void FixGateway::accept_connections() {
+    for (;;) {
+        const int fd = ::accept(listen_fd_, nullptr, nullptr);
+        if (fd < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (!would_block(errno)) {
+                std::cerr << "FIX gateway accept failed: " << std::strerror(errno) << std::endl;
+            }
+            return;
+        }
+        const int enable = 1;
+        if (config_.tcp_nodelay) {
+            setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+        }
+#ifdef __APPLE__
+        setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &enable, sizeof(enable));
+#endif
+        const FixConnectionId connection_id = set_non_blocking(fd) ? codec_.open_connection() : INVALID_CONNECTION;
+        if (connection_id == INVALID_CONNECTION) {
+            ::close(fd);
+            stats_.connections_rejected.fetch_add(1, std::memory_order_relaxed);
+            continue;
+        }
+        Connection& connection = connections_[connection_id];
+        {
+            std::lock_guard<std::mutex> handoff_lock(connection.handoff_mutex);
+            if (!connection.handoff) {
+                connection.handoff = std::make_unique<core::SpscRing<std::string>>(config_.handoff_capacity);
+            }
+            while (connection.handoff->try_consume([](std::string&) {})) {
+            }
+        }
+        {
+            std::lock_guard<std::mutex> lock(connection.output_mutex);
+            connection.pending_output.clear();
+            connection.pending_offset = 0;
+            connection.batch.clear();
+            connection.fd.store(fd, std::memory_order_relaxed);
+            connection.generation.fetch_add(1, std::memory_order_relaxed);
+            connection.open.store(true, std::memory_order_release);
+        }
+        if (!watch(fd, connection_id, true)) {
+            close_now(connection_id);
+            stats_.connections_rejected.fetch_add(1, std::memory_order_relaxed);
+            continue;
+        }
+        stats_.connections_accepted.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+void FixGateway::read_connection(FixConnectionId connection_id) {
+    Connection* connection = find_connection(connection_id);
+    if (!connection || !connection->open.load(std::memory_order_acquire)) {
+        return;
+    }
+    const int fd = connection->fd.load(std::memory_order_relaxed);
+    for (;;) {
+        const ssize_t received = ::recv(fd, read_buffer_.get(), config_.read_buffer_size, 0);
+        stats_.read_calls.fetch_add(1, std::memory_order_relaxed);
+        if (received > 0) {
+            stats_.bytes_received.fetch_add(static_cast<uint64_t>(received), std::memory_order_relaxed);
+            if (!codec_.on_data(connection_id, read_buffer_.get(), static_cast<size_t>(received))) {
+                close_now(connection_id);
+                break;
+            }
+            if (static_cast<size_t>(received) < config_.read_buffer_size) {
+                break;
+            }
+            continue;
+        }
+        if (received < 0 && errno == EINTR) {
+            continue;
+        }
+        if (received == 0 || !would_block(errno)) {
+            close_now(connection_id);
+        }
+        break;
+    }
+}
+void FixGateway::flush(FixConnectionId connection_id) {
+    Connection* connection = find_connection(connection_id);
+    if (!connection) {
+        return;
+    }
+    bool failed = false;
+    {
+        std::lock_guard<std::mutex> lock(connection->output_mutex);
+        failed = connection->open.load(std::memory_order_relaxed) && !flush_output(*connection);
+    }
+    if (failed && std::this_thread::get_id() == event_thread_.get_id()) {
+        close_now(connection_id);
+    } else if (failed) {
+        close_connection(connection_id);
+    }
+}
+void FixGateway::flush_batches() {
+    for (FixConnectionId connection_id : dirty_connections_) {
+        flush(connection_id);
+    }
+    dirty_connections_.clear();
+}
+bool FixGateway::write_bytes(Connection& connection, const char* data, size_t length, size_t& written) {
+    while (written < length) {
+        const ssize_t result = ::send(connection.fd.load(std::memory_order_relaxed), data + written, length - written,
+                                      SEND_FLAGS);
+        stats_.send_calls.fetch_add(1, std::memory_order_relaxed);
+        if (result > 0) {
+            written += static_cast<size_t>(result);
+            stats_.bytes_sent.fetch_add(static_cast<uint64_t>(result), std::memory_order_relaxed);
+            continue;
+        }
+        if (result < 0 && errno == EINTR) {
+            continue;
+        }
+        if (result < 0 && would_block(errno)) {
+            stats_.send_would_block.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+        stats_.send_errors.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    return true;
+}
+bool FixGateway::flush_output(Connection& connection) {
+    size_t batch_offset = 0;
+    bool ok = true;
+    for (;;) {
+        iovec segments[2];
+        int segment_count = 0;
+        const size_t pending = connection.pending_output.size() - connection.pending_offset;
+        if (pending != 0) {
+            segments[segment_count++] = iovec{connection.pending_output.data() + connection.pending_offset, pending};
+        }
+        if (batch_offset < connection.batch.size()) {
+            segments[segment_count++] = iovec{connection.batch.data() + batch_offset,
+                                              connection.batch.size() - batch_offset};
+        }
+        if (segment_count == 0) {
+            break;
+        }
+        msghdr message{};
+        message.msg_iov = segments;
+        message.msg_iovlen = segment_count;
+        const ssize_t result = ::sendmsg(connection.fd.load(std::memory_order_relaxed), &message, SEND_FLAGS);
+        stats_.send_calls.fetch_add(1, std::memory_order_relaxed);
+        if (result > 0) {
+            const size_t written = static_cast<size_t>(result);
+            const size_t from_pending = std::min(written, pending);
+            connection.pending_offset += from_pending;
+            batch_offset += written - from_pending;
+            stats_.bytes_sent.fetch_add(written, std::memory_order_relaxed);
+            continue;
+        }
+        if (result < 0 && errno == EINTR) {
+            continue;
+        }
+        if (result < 0 && would_block(errno)) {
+            stats_.send_would_block.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            stats_.send_errors.fetch_add(1, std::memory_order_relaxed);
+            ok = false;
+        }
+        break;
+    }
+    connection.pending_output.erase(0, connection.pending_offset);
+    connection.pending_offset = 0;
+    connection.pending_output.append(connection.batch, batch_offset, std::string::npos);
+    connection.batch.clear();
+    if (connection.pending_output.size() > config_.max_pending_output_bytes) {
+        stats_.output_overflows.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    return ok;
+}
+bool FixGateway::send(FixConnectionId connection_id, const char* data, size_t length) {
+    Connection* connection = find_connection(connection_id);
+    if (!connection) {
+        return false;
+    }
+    const bool on_event_thread = std::this_thread::get_id() == event_thread_.get_id();
+    if (config_.batch_writes && !on_event_thread && running_.load(std::memory_order_acquire)) {
+        return hand_off(connection_id, *connection, data, length);
+    }
+    bool sent = false;
+    {
+        std::lock_guard<std::mutex> lock(connection->output_mutex);
+        if (!connection->open.load(std::memory_order_relaxed)) {
+            return false;
+        }
+        if (config_.batch_writes && on_event_thread) {
+            const bool was_empty = connection->batch.empty();
+            consume_handoff(*connection);
+            if (was_empty) {
+                dirty_connections_.push_back(connection_id);
+            }
+            connection->batch.append(data, length);
+            stats_.messages_batched.fetch_add(1, std::memory_order_relaxed);
+            sent = connection->batch.size() < config_.flush_threshold_bytes || flush_output(*connection);
+        } else if (!connection->batch.empty() || !connection->pending_output.empty()) {
+            connection->batch.append(data, length);
+            sent = flush_output(*connection);
+        } else {
+            size_t written = 0;
+            sent = write_bytes(*connection, data, length, written);
+            if (sent) {
+                connection->pending_output.append(data + written, length - written);
+            }
+            if (connection->pending_output.size() > config_.max_pending_output_bytes) {
+                stats_.output_overflows.fetch_add(1, std::memory_order_relaxed);
+                sent = false;
+            }
+        }
+    }
+    if (!sent) {
+        close_connection(connection_id);
+    }
+    return sent;
+}
+bool FixGateway::hand_off(FixConnectionId connection_id, Connection& connection, const char* data, size_t length) {
+    {
+        std::lock_guard<std::mutex> lock(connection.handoff_mutex);
+        if (!connection.open.load(std::memory_order_acquire)) {
+            return false;
+        }
+        auto fill = [data, length](std::string& slot) { slot.assign(data, length); };
+        if (!connection.handoff->try_produce(fill)) {
+            stats_.handoff_full.fetch_add(1, std::memory_order_relaxed);
+            bool sent = false;
+            {
+                std::lock_guard<std::mutex> output_lock(connection.output_mutex);
+                if (!connection.open.load(std::memory_order_relaxed)) {
+                    return false;
+                }
+                consume_handoff(connection);
+                connection.batch.append(data, length);
+                stats_.messages_batched.fetch_add(1, std::memory_order_relaxed);
+                sent = flush_output(connection);
+            }
+            if (!sent) {
+                close_connection(connection_id);
+            }
+            return sent;
+        }
+    }
+    stats_.messages_handed_off.fetch_add(1, std::memory_order_relaxed);
+    if (!connection.handoff_pending.exchange(true)) {
+        {
+            std::lock_guard<std::mutex> lock(handoff_list_mutex_);
+            handoff_connections_.push_back(connection_id);
+        }
+        wake();
+    }
+    return true;
+}
+uint64_t FixGateway::consume_handoff(Connection& connection) {
+    const bool open = connection.open.load(std::memory_order_relaxed);
+    uint64_t batched = 0;
+    while (connection.handoff && connection.handoff->try_consume([&connection, &batched, open](std::string& message) {
+        if (open) {
+            connection.batch.append(message);
+            ++batched;
+        }
+    })) {
+    }
+    if (batched != 0) {
+        stats_.messages_batched.fetch_add(batched, std::memory_order_relaxed);
+    }
+    return batched;
+}
+void FixGateway::drain_handoffs() {
+    {
+        std::lock_guard<std::mutex> lock(handoff_list_mutex_);
+        handoff_scratch_.swap(handoff_connections_);
+        close_scratch_.swap(close_requests_);
+    }
+    for (FixConnectionId connection_id : handoff_scratch_) {
+        Connection& connection = connections_[connection_id];
+        connection.handoff_pending.store(false);
+        std::lock_guard<std::mutex> lock(connection.output_mutex);
+        const bool was_empty = connection.batch.empty();
+        if (consume_handoff(connection) != 0 && was_empty) {
+            dirty_connections_.push_back(connection_id);
+        }
+    }
+    handoff_scratch_.clear();
+    for (const auto& [connection_id, generation] : close_scratch_) {
+        if (connections_[connection_id].generation.load(std::memory_order_relaxed) == generation) {
+            flush(connection_id);
+            close_now(connection_id);
+        }
+    }
+    close_scratch_.clear();
+}
+void FixGateway::close_connection(FixConnectionId connection_id) {
+    Connection* connection = find_connection(connection_id);
+    if (!connection) {
+        return;
+    }
+    if (!running_.load(std::memory_order_acquire)) {
+        close_now(connection_id);
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(handoff_list_mutex_);
+        close_requests_.emplace_back(connection_id, connection->generation.load(std::memory_order_relaxed));
+    }
+    stats_.closes_posted.fetch_add(1, std::memory_order_relaxed);
+    wake();
+}
+void FixGateway::close_now(FixConnectionId connection_id) {
+    Connection* connection = find_connection(connection_id);
+    if (!connection) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(connection->output_mutex);
+        if (!connection->open.load(std::memory_order_relaxed)) {
+            return;
+        }
+        connection->open.store(false, std::memory_order_release);
+        ::close(connection->fd.load(std::memory_order_relaxed));
+        connection->fd.store(-1, std::memory_order_relaxed);
+        connection->pending_output.clear();
+        connection->pending_offset = 0;
+        connection->batch.clear();
+    }
+    codec_.close_connection(connection_id);
+    stats_.connections_closed.fetch_add(1, std::memory_order_relaxed);
+}
+}
+}
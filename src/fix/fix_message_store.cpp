@@ -0,0 +1,135 @@
+#include "hft/fix/fix_message_store.hpp"
+#include <cstring>
+#include <iostream>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+namespace hft {
+namespace fix {
+namespace {
+constexpr char STORE_MAGIC[8] = {'H', 'F', 'T', 'F', 'I', 'X', 'S', '1'};
+constexpr size_t STORE_ALIGNMENT = 64;
+inline size_t align_up(size_t value, size_t alignment) {
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+inline size_t round_up_pow2(size_t value) {
+    size_t result = 1;
+    while (result < value) {
+        result <<= 1;
+    }
+    return result;
+}
+}
+FixMessageStore::FixMessageStore()
+    : fd_(-1), mapping_(nullptr), mapping_size_(0), header_(nullptr), entries_(nullptr), data_(nullptr),
+      index_mask_(0) {}
+FixMessageStore::~FixMessageStore() {
+    close();
+}
+bool FixMessageStore::open(const std::string& path, size_t data_capacity, size_t index_slots) {
+    close();
+    index_slots = round_up_pow2(index_slots);
+    data_capacity = align_up(data_capacity, STORE_ALIGNMENT);
+    const size_t entries_offset = align_up(sizeof(FixStoreHeader), STORE_ALIGNMENT);
+    const size_t data_offset = align_up(entries_offset + index_slots * sizeof(FixStoreEntry), STORE_ALIGNMENT);
+    const size_t mapping_size = data_offset + data_capacity;
+    fd_ = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+    if (fd_ < 0) {
+        std::cerr << "Failed to open FIX message store: " << path << std::endl;
+        return false;
+    }
+    struct stat file_stat;
+    if (fstat(fd_, &file_stat) != 0) {
+        ::close(fd_);
+        fd_ = -1;
+        return false;
+    }
+    const bool existing = static_cast<size_t>(file_stat.st_size) == mapping_size;
+    if (!existing && ftruncate(fd_, static_cast<off_t>(mapping_size)) != 0) {
+        std::cerr << "Failed to size FIX message store: " << path << std::endl;
+        ::close(fd_);
+        fd_ = -1;
+        return false;
+    }
+    void* mapping = mmap(nullptr, mapping_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+    if (mapping == MAP_FAILED) {
+        std::cerr << "Failed to map FIX message store: " << path << std::endl;
+        ::close(fd_);
+        fd_ = -1;
+        return false;
+    }
+    mapping_ = static_cast<char*>(mapping);
+    mapping_size_ = mapping_size;
+    header_ = reinterpret_cast<FixStoreHeader*>(mapping_);
+    entries_ = reinterpret_cast<FixStoreEntry*>(mapping_ + entries_offset);
+    data_ = mapping_ + data_offset;
+    index_mask_ = index_slots - 1;
+    path_ = path;
+    const bool valid = existing && std::memcmp(header_->magic, STORE_MAGIC, sizeof(STORE_MAGIC)) == 0 &&
+                       header_->version == STORE_VERSION && header_->index_slots == index_slots &&
+                       header_->data_capacity == data_capacity;
+    if (!valid) {
+        std::memset(header_, 0, sizeof(FixStoreHeader));
+        std::memcpy(header_->magic, STORE_MAGIC, sizeof(STORE_MAGIC));
+        header_->version = STORE_VERSION;
+        header_->index_slots = static_cast<uint32_t>(index_slots);
+        header_->data_capacity = data_capacity;
+        reset();
+    }
+    return true;
+}
+void FixMessageStore::close() {
+    if (mapping_) {
+        msync(mapping_, mapping_size_, MS_SYNC);
+        munmap(mapping_, mapping_size_);
+        mapping_ = nullptr;
+    }
+    if (fd_ >= 0) {
+        ::close(fd_);
+        fd_ = -1;
+    }
+    header_ = nullptr;
+    entries_ = nullptr;
+    data_ = nullptr;
+    mapping_size_ = 0;
+}
+bool FixMessageStore::store(uint64_t seq, const char* data, size_t length) {
+    const uint64_t capacity = header_->data_capacity;
+    if (length == 0 || length > capacity) {
+        return false;
+    }
+    uint64_t position = header_->write_position;
+    const uint64_t offset = position % capacity;
+    if (offset + length > capacity) {
+        position += capacity - offset;
+    }
+    std::memcpy(data_ + position % capacity, data, length);
+    FixStoreEntry& entry = entries_[seq & index_mask_];
+    entry.seq = seq;
+    entry.position = position;
+    entry.length = static_cast<uint32_t>(length);
+    header_->write_position = position + length;
+    return true;
+}
+std::string_view FixMessageStore::lookup(uint64_t seq) const {
+    const FixStoreEntry& entry = entries_[seq & index_mask_];
+    const uint64_t capacity = header_->data_capacity;
+    if (entry.seq != seq || entry.length == 0 || entry.position + capacity < header_->write_position) {
+        return std::string_view();
+    }
+    return std::string_view(data_ + entry.position % capacity, entry.length);
+}
+void FixMessageStore::reset() {
+    header_->next_sender_seq = 1;
+    header_->next_target_seq = 1;
+    header_->write_position = 0;
+    std::memset(entries_, 0, (index_mask_ + 1) * sizeof(FixStoreEntry));
+}
+void FixMessageStore::flush(bool synchronous) {
+    if (mapping_) {
+        msync(mapping_, mapping_size_, synchronous ? MS_SYNC : MS_ASYNC);
+    }
+}
+}
+}
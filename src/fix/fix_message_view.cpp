@@ -0,0 +1,91 @@
+#include "hft/fix/fix_message_view.hpp"
+#include "hft/core/numeric.hpp"
+namespace hft {
+namespace fix {
+void FixMessageView::clear() {
+    for (uint32_t i = 0; i < field_count_; ++i) {
+        if (fields_[i].tag < HOT_TAG_LIMIT) {
+            hot_index_[fields_[i].tag] = 0;
+        }
+    }
+    field_count_ = 0;
+    data_ = nullptr;
+    length_ = 0;
+}
+bool FixMessageView::parse(const char* data, size_t length) {
+    clear();
+    if (data == nullptr || length == 0 || length > MAX_FIX_MESSAGE_SIZE) {
+        return false;
+    }
+    const int count = scan_fix_fields(data, length, fields_.data(), MAX_FIELDS);
+    if (count <= 0) {
+        return false;
+    }
+    data_ = data;
+    length_ = static_cast<uint32_t>(length);
+    field_count_ = static_cast<uint32_t>(count);
+    for (uint32_t i = 0; i < field_count_; ++i) {
+        const uint32_t tag = fields_[i].tag;
+        bool duplicate = false;
+        if (tag < HOT_TAG_LIMIT) {
+            duplicate = hot_index_[tag] != 0;
+            hot_index_[tag] = static_cast<uint8_t>(i + 1);
+        }
+        for (uint32_t j = 0; j < i && tag >= HOT_TAG_LIMIT && !duplicate; ++j) {
+            duplicate = fields_[j].tag == tag;
+        }
+        if (duplicate) {
+            clear();
+            return false;
+        }
+    }
+    return field_count_ > 0;
+}
+bool FixMessageView::get_uint(uint32_t tag, uint64_t& value) const {
+    const std::string_view text = get_field(tag);
+    return core::parse_uint(text.data(), text.size(), value);
+}
+bool FixMessageView::get_int(uint32_t tag, int64_t& value) const {
+    const std::string_view text = get_field(tag);
+    return core::parse_int(text.data(), text.size(), value);
+}
+bool FixMessageView::get_price(uint32_t tag, double& value) const {
+    const std::string_view text = get_field(tag);
+    return core::parse_price(text.data(), text.size(), value);
+}
+bool FixMessageView::get_char(uint32_t tag, char& value) const {
+    const std::string_view text = get_field(tag);
+    if (text.size() != 1) return false;
+    value = text[0];
+    return true;
+}
+uint32_t FixMessageView::body_length() const {
+    uint64_t value = 0;
+    return get_uint(Tags::BODY_LENGTH, value) ? static_cast<uint32_t>(value) : 0;
+}
+uint32_t FixMessageView::msg_seq_num() const {
+    uint64_t value = 0;
+    return get_uint(Tags::MSG_SEQ_NUM, value) ? static_cast<uint32_t>(value) : 0;
+}
+bool FixMessageView::to_message(FixMessage& message) const {
+    message.clear();
+    if (field_count_ == 0) {
+        return false;
+    }
+    message.ordered_fields.reserve(field_count_);
+    for (uint32_t i = 0; i < field_count_; ++i) {
+        message.set_field(fields_[i].tag, std::string(value_at(i)));
+    }
+    message.begin_string = std::string(begin_string());
+    message.body_length = body_length();
+    message.msg_type = std::string(msg_type());
+    message.msg_seq_num = msg_seq_num();
+    message.sender_comp_id = std::string(get_field(Tags::SENDER_COMP_ID));
+    message.target_comp_id = std::string(get_field(Tags::TARGET_COMP_ID));
+    message.sending_time = std::string(get_field(Tags::SENDING_TIME));
+    uint64_t checksum = 0;
+    message.checksum = get_uint(Tags::CHECK_SUM, checksum) ? static_cast<uint8_t>(checksum) : 0;
+    return true;
+}
+}
+}
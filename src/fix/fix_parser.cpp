@@ -1,13 +1,43 @@
 #include "hft/fix/fix_parser.hpp"
+#include "hft/fix/fix_message_view.hpp"
+#include "hft/fix/fix_scanner.hpp"
+#include "hft/fix/fix_encoder.hpp"
 #include "hft/core/clock.hpp"
-#include <sstream>
-#include <iomanip>
+#include "hft/core/simd_scan.hpp"
+#include "hft/core/numeric.hpp"
 #include <algorithm>
 #include <chrono>
 #include <cstring>
 #include <iostream>
 namespace hft {
 namespace fix {
+namespace {
+struct TagBytes {
+    uint32_t sum;
+    uint32_t length;
+};
+inline std::string format_decimal(double value, int precision) {
+    char text[core::MAX_FIXED_LENGTH];
+    return std::string(text, core::format_fixed(text, value, precision));
+}
+inline std::string format_integer(uint64_t value) {
+    char text[core::MAX_UINT_DIGITS];
+    return std::string(text, core::format_uint(text, value));
+}
+inline std::string format_integer(int64_t value) {
+    char text[core::MAX_UINT_DIGITS + 1];
+    return std::string(text, core::format_int(text, value));
+}
+inline TagBytes tag_bytes(uint32_t tag) {
+    TagBytes bytes{0, 0};
+    do {
+        bytes.sum += '0' + tag % 10;
+        ++bytes.length;
+        tag /= 10;
+    } while (tag != 0);
+    return bytes;
+}
+}
 bool FixMessage::has_field(uint32_t tag) const {
     return fields.find(tag) != fields.end();
 }
@@ -17,37 +47,46 @@ const std::string& FixMessage::get_field(uint32_t tag) const {
     return (it != fields.end()) ? it->second : empty_string;
 }
 void FixMessage::set_field(uint32_t tag, const std::string& value) {
-    fields[tag] = value;
+    auto [map_it, inserted] = fields.insert_or_assign(tag, value);
+    if (inserted) {
+        ordered_fields.emplace_back(tag, value);
+        return;
+    }
     auto it = std::find_if(ordered_fields.begin(), ordered_fields.end(),
         [tag](const FixField& field) { return field.tag == tag; });
     if (it != ordered_fields.end()) {
         it->value = value;
-    } else {
-        ordered_fields.emplace_back(tag, value);
     }
 }
 void FixMessage::set_field(uint32_t tag, std::string&& value) {
+    auto map_it = fields.find(tag);
+    if (map_it == fields.end()) {
+        ordered_fields.emplace_back(tag, value);
+        fields.emplace(tag, std::move(value));
+        return;
+    }
     auto it = std::find_if(ordered_fields.begin(), ordered_fields.end(),
         [tag](const FixField& field) { return field.tag == tag; });
     if (it != ordered_fields.end()) {
         it->value = value;
-        fields[tag] = std::move(value);
-    } else {
-        ordered_fields.emplace_back(tag, value);
-        fields[tag] = std::move(value);
     }
+    map_it->second = std::move(value);
 }
 double FixMessage::get_price(uint32_t tag) const {
     const auto& value = get_field(tag);
-    return value.empty() ? 0.0 : std::stod(value);
+    double price = 0.0;
+    return core::parse_price(value.data(), value.size(), price) ? price : 0.0;
 }
 uint64_t FixMessage::get_quantity(uint32_t tag) const {
     const auto& value = get_field(tag);
-    return value.empty() ? 0 : std::stoull(value);
+    uint64_t quantity = 0;
+    return core::parse_uint(value.data(), value.size(), quantity) ? quantity : 0;
 }
 int FixMessage::get_int(uint32_t tag) const {
     const auto& value = get_field(tag);
-    return value.empty() ? 0 : std::stoi(value);
+    int64_t result = 0;
+    return core::parse_int(value.data(), value.size(), result) && result >= INT32_MIN && result <= INT32_MAX ?
+        static_cast<int>(result) : 0;
 }
 bool FixMessage::is_valid() const {
     return !begin_string.empty() &&
@@ -60,10 +99,8 @@ uint8_t FixMessage::calculate_checksum() const {
     uint32_t sum = 0;
     for (const auto& field : ordered_fields) {
         if (field.tag != Tags::CHECK_SUM) {
-            std::string field_str = std::to_string(field.tag) + "=" + field.value + FIX_SOH;
-            for (char c : field_str) {
-                sum += static_cast<uint8_t>(c);
-            }
+            sum += tag_bytes(field.tag).sum + FIX_EQUALS + FIX_SOH;
+            sum += static_cast<uint32_t>(core::byte_sum(field.value.data(), field.value.size()));
         }
     }
     return static_cast<uint8_t>(sum % 256);
@@ -80,12 +117,21 @@ void FixMessage::clear() {
     fields.clear();
     ordered_fields.clear();
 }
+FixSession::FixSession(FixSessionId session_id, size_t queue_capacity)
+    : id(session_id), worker(0), open(true), generation(0), buffer_generation(0), pending_frame(0),
+      queue(queue_capacity) {
+    buffer.open(FIX_SESSION_BUFFER_SIZE);
+}
+FixSession::~FixSession() = default;
 FixParser::FixParser(size_t num_workers)
-    : num_worker_threads_(std::min(num_workers, MAX_WORKER_THREADS)),
-      buffer_position_(0) {
-    raw_message_queue_ = std::make_unique<core::LockFreeQueue<std::string, PARSER_QUEUE_SIZE>>();
-    parsed_message_queue_ = std::make_unique<core::LockFreeQueue<FixMessage, PARSER_QUEUE_SIZE>>();
-    message_buffer_.reserve(MAX_FIX_MESSAGE_SIZE * 4);
+    : num_worker_threads_(std::max(num_workers, size_t(1))),
+      inline_handler_(nullptr) {
+    wait_config_.type = core::WaitStrategyType::SPIN_YIELD;
+    wait_config_.spin_iterations = 256;
+    wait_config_.enqueue_timeout_ns = 30000;
+    if (open_session() == INVALID_SESSION) {
+        throw std::runtime_error("Failed to allocate default FIX session buffer");
+    }
 }
 FixParser::~FixParser() {
     stop();
@@ -93,22 +139,46 @@ FixParser::~FixParser() {
 void FixParser::set_message_callback(MessageCallback callback) {
     std::lock_guard<std::mutex> lock(callback_mutex_);
     message_callback_ = std::move(callback);
+    callback_version_.fetch_add(1, std::memory_order_release);
 }
 void FixParser::set_error_callback(ErrorCallback callback) {
     std::lock_guard<std::mutex> lock(callback_mutex_);
     error_callback_ = std::move(callback);
 }
+void FixParser::set_inline_handler(FixMessageHandler* handler) {
+    if (running_.load()) {
+        throw std::runtime_error("Cannot change inline handler while parser is running");
+    }
+    std::lock_guard<std::mutex> lock(session_mutex_);
+    inline_handler_ = handler;
+    for (auto& session : sessions_) {
+        if (handler && !session->view) {
+            session->view = std::make_unique<FixMessageView>();
+        }
+    }
+}
+void FixParser::set_wait_strategy(const core::WaitStrategyConfig& config) {
+    if (running_.load()) {
+        throw std::runtime_error("Cannot change wait strategy while parser is running");
+    }
+    wait_config_ = config;
+}
 void FixParser::start() {
     if (running_.load()) return;
     running_.store(true);
-    worker_threads_.reserve(num_worker_threads_);
-    size_t parsing_workers = std::max(size_t(1), num_worker_threads_ / 3);
-    size_t processing_workers = num_worker_threads_ - parsing_workers;
-    for (size_t i = 0; i < parsing_workers; ++i) {
-        worker_threads_.emplace_back(&FixParser::parsing_worker, this);
+    if (inline_handler_) {
+        return;
     }
-    for (size_t i = 0; i < processing_workers; ++i) {
-        worker_threads_.emplace_back(&FixParser::processing_worker, this);
+    {
+        std::lock_guard<std::mutex> lock(session_mutex_);
+        worker_sessions_ = std::make_unique<WorkerSessions[]>(num_worker_threads_);
+        for (auto& session : sessions_) {
+            assign_session(*session);
+        }
+    }
+    worker_threads_.reserve(num_worker_threads_);
+    for (size_t i = 0; i < num_worker_threads_; ++i) {
+        worker_threads_.emplace_back(&FixParser::session_worker, this, i);
     }
 }
 void FixParser::stop() {
@@ -124,53 +194,135 @@ void FixParser::stop() {
         std::lock_guard<std::mutex> lock(callback_mutex_);
         message_callback_ = nullptr;
         error_callback_ = nullptr;
+        callback_version_.fetch_add(1, std::memory_order_release);
     }
     {
-        std::lock_guard<std::mutex> lock(buffer_mutex_);
-        message_buffer_.clear();
-        buffer_position_ = 0;
+        std::lock_guard<std::mutex> buffer_lock(buffer_mutex_);
+        std::lock_guard<std::mutex> lock(session_mutex_);
+        worker_sessions_.reset();
+        for (auto& session : sessions_) {
+            session->buffer.clear();
+            session->pending_frame = 0;
+        }
     }
 }
+FixSessionId FixParser::open_session() {
+    std::lock_guard<std::mutex> lock(session_mutex_);
+    for (auto& session : sessions_) {
+        if (!session->open.load(std::memory_order_relaxed)) {
+            session->open.store(true, std::memory_order_release);
+            return session->id;
+        }
+    }
+    if (sessions_.size() == MAX_SESSIONS) {
+        return INVALID_SESSION;
+    }
+    const FixSessionId session_id = static_cast<FixSessionId>(sessions_.size());
+    auto created = std::make_unique<FixSession>(session_id, SESSION_QUEUE_SIZE);
+    if (!created->buffer.is_open()) {
+        return INVALID_SESSION;
+    }
+    sessions_.push_back(std::move(created));
+    FixSession& session = *sessions_.back();
+    if (inline_handler_) {
+        session.view = std::make_unique<FixMessageView>();
+    }
+    if (worker_sessions_) {
+        assign_session(session);
+    }
+    session_table_[session_id].store(&session, std::memory_order_release);
+    return session_id;
+}
+void FixParser::close_session(FixSessionId session_id) {
+    if (session_id == DEFAULT_SESSION || session_id >= MAX_SESSIONS) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(session_mutex_);
+    FixSession* session = session_table_[session_id].load(std::memory_order_acquire);
+    if (session) {
+        session->open.store(false, std::memory_order_release);
+        session->generation.fetch_add(1, std::memory_order_acq_rel);
+    }
+}
+size_t FixParser::get_session_count() const {
+    std::lock_guard<std::mutex> lock(session_mutex_);
+    return static_cast<size_t>(std::count_if(sessions_.begin(), sessions_.end(),
+        [](const std::unique_ptr<FixSession>& session) { return session->open.load(); }));
+}
+size_t FixParser::get_session_worker(FixSessionId session_id) const {
+    if (session_id >= MAX_SESSIONS) {
+        return SIZE_MAX;
+    }
+    const FixSession* session = session_table_[session_id].load(std::memory_order_acquire);
+    return session ? session->worker : SIZE_MAX;
+}
+void FixParser::assign_session(FixSession& session) {
+    size_t worker = 0;
+    for (size_t i = 1; i < num_worker_threads_; ++i) {
+        if (worker_sessions_[i].count.load(std::memory_order_relaxed) <
+            worker_sessions_[worker].count.load(std::memory_order_relaxed)) {
+            worker = i;
+        }
+    }
+    WorkerSessions& assigned = worker_sessions_[worker];
+    const size_t slot = assigned.count.load(std::memory_order_relaxed);
+    assigned.sessions[slot] = &session;
+    session.worker = worker;
+    assigned.count.store(slot + 1, std::memory_order_release);
+}
 void FixParser::feed_data(const char* data, size_t length) {
     if (!running_.load() || data == nullptr || length == 0) {
         return;
     }
-    stats_.bytes_processed.fetch_add(length);
-    std::string message;
-    int retry_count = 0;
-    const int max_retries = 3;
-    {
-        std::lock_guard<std::mutex> lock(buffer_mutex_);
-        message_buffer_.append(data, length);
-        while (extract_next_message(message)) {
-            if (!running_.load()) break;
-            bool enqueued = false;
-            retry_count = 0;
-            while (!enqueued && retry_count < max_retries && running_.load()) {
-                if (raw_message_queue_->enqueue(std::move(message))) {
-                    enqueued = true;
-                } else {
-                    retry_count++;
-                    if (retry_count < max_retries) {
-                        std::this_thread::sleep_for(std::chrono::microseconds(10));
-                    }
-                }
-            }
-            if (!enqueued) {
-                stats_.queue_full_events.fetch_add(1);
-                stats_.messages_dropped.fetch_add(1);
-                std::lock_guard<std::mutex> cb_lock(callback_mutex_);
-                if (error_callback_) {
-                    error_callback_("QUEUE_FULL", "Raw message queue is full after retries");
-                }
-            }
-            message.clear();
-        }
+    FixSession& session = *session_table_[DEFAULT_SESSION].load(std::memory_order_acquire);
+    if (inline_handler_) {
+        feed_session(session, data, length);
+        return;
     }
+    std::lock_guard<std::mutex> lock(buffer_mutex_);
+    feed_session(session, data, length);
 }
 void FixParser::feed_data(const std::string& data) {
     feed_data(data.c_str(), data.size());
 }
+void FixParser::feed_data(FixSessionId session_id, const char* data, size_t length) {
+    if (!running_.load() || data == nullptr || length == 0 || session_id >= MAX_SESSIONS) {
+        return;
+    }
+    FixSession* session = session_table_[session_id].load(std::memory_order_acquire);
+    if (session && session->open.load(std::memory_order_acquire)) {
+        feed_session(*session, data, length);
+    }
+}
+void FixParser::feed_session(FixSession& session, const char* data, size_t length) {
+    stats_.bytes_processed.fetch_add(length, std::memory_order_relaxed);
+    const uint64_t generation = session.generation.load(std::memory_order_acquire);
+    if (generation != session.buffer_generation) {
+        session.buffer.clear();
+        session.pending_frame = 0;
+        session.buffer_generation = generation;
+    }
+    while (!session.buffer.empty()) {
+        if (length == 0) {
+            return;
+        }
+        const size_t buffered = session.buffer.size();
+        const size_t wanted = session.pending_frame > buffered ? session.pending_frame - buffered : length;
+        const size_t copied = session.buffer.append(data, std::min(wanted, length));
+        data += copied;
+        length -= copied;
+        if (session.buffer.size() < session.pending_frame) {
+            continue;
+        }
+        session.buffer.consume(frame_session(session, session.buffer.read_ptr(), session.buffer.size()));
+    }
+    const size_t consumed = frame_session(session, data, length);
+    session.buffer.append(data + consumed, length - consumed);
+}
+size_t FixParser::frame_session(FixSession& session, const char* data, size_t length) {
+    session.pending_frame = 0;
+    return inline_handler_ ? dispatch_inline(session, data, length) : enqueue_frames(session, data, length);
+}
 bool FixParser::parse_message(const std::string& raw_message, FixMessage& parsed_message) {
     auto start_time = std::chrono::high_resolution_clock::now();
     bool success = parse_message_internal(raw_message, parsed_message);
@@ -184,209 +336,191 @@ bool FixParser::parse_message(const std::string& raw_message, FixMessage& parsed
     update_parse_time(parse_time);
     return success;
 }
+bool FixParser::parse_view(const char* data, size_t length, FixMessageView& view) {
+    if (!verify_frame(data, length) || !view.parse(data, length)) {
+        stats_.parse_errors.fetch_add(1);
+        return false;
+    }
+    stats_.messages_parsed.fetch_add(1);
+    return true;
+}
 void FixParser::set_worker_threads(size_t count) {
     if (running_.load()) {
         throw std::runtime_error("Cannot change worker thread count while parser is running");
     }
-    num_worker_threads_ = std::min(count, MAX_WORKER_THREADS);
+    num_worker_threads_ = std::max(count, size_t(1));
 }
-void FixParser::parsing_worker() {
-    std::string raw_message;
+void FixParser::session_worker(size_t worker_index) {
+    WorkerSessions& assigned = worker_sessions_[worker_index];
+    core::WaitStrategy wait(wait_config_);
     FixMessage parsed_message;
-    while (running_.load()) {
-        try {
-            if (raw_message_queue_->dequeue(raw_message)) {
-                if (raw_message.empty() || raw_message.size() > MAX_FIX_MESSAGE_SIZE) {
-                    raw_message.clear();
-                    continue;
-                }
-                parsed_message.clear();
-                if (parse_message_internal(raw_message, parsed_message)) {
-                    bool enqueued = false;
-                    int retry_count = 0;
-                    const int max_retries = 5;
-                    while (!enqueued && retry_count < max_retries && running_.load()) {
-                        if (parsed_message_queue_->enqueue(std::move(parsed_message))) {
-                            enqueued = true;
-                        } else {
-                            retry_count++;
-                            if (retry_count < max_retries) {
-                                std::this_thread::sleep_for(std::chrono::microseconds(5));
-                            }
-                        }
-                    }
-                    if (!enqueued) {
-                        stats_.queue_full_events.fetch_add(1);
-                        stats_.messages_dropped.fetch_add(1);
-                        std::lock_guard<std::mutex> lock(callback_mutex_);
-                        if (error_callback_ && running_.load()) {
-                            try {
-                                error_callback_("PARSED_QUEUE_FULL", "Parsed message queue is full after retries");
-                            } catch (...) {
-                                stats_.callback_errors.fetch_add(1);
-                            }
-                        }
-                    }
-                } else {
-                    stats_.parse_errors.fetch_add(1);
-                }
-                raw_message.clear();
-            } else {
-                std::this_thread::yield();
-            }
-        } catch (const std::exception& e) {
-            stats_.parse_errors.fetch_add(1);
-            raw_message.clear();
-            std::this_thread::yield();
-        } catch (...) {
-            stats_.parse_errors.fetch_add(1);
-            raw_message.clear();
-            std::this_thread::yield();
+    MessageCallback callback;
+    uint64_t callback_version = ~uint64_t(0);
+    while (running_.load(std::memory_order_relaxed)) {
+        const uint64_t current_version = callback_version_.load(std::memory_order_acquire);
+        if (current_version != callback_version) {
+            std::lock_guard<std::mutex> lock(callback_mutex_);
+            callback = message_callback_;
+            callback_version = current_version;
+        }
+        size_t processed = 0;
+        const size_t session_count = assigned.count.load(std::memory_order_acquire);
+        for (size_t i = 0; i < session_count; ++i) {
+            processed += drain_session(*assigned.sessions[i], parsed_message, callback);
+        }
+        if (processed == 0) {
+            wait.idle();
+        } else {
+            wait.reset();
         }
     }
 }
-void FixParser::processing_worker() {
-    FixMessage parsed_message;
-    static int processing_count = 0;
-    while (running_.load()) {
-        if (parsed_message_queue_->dequeue(parsed_message)) {
-            MessageCallback msg_callback;
-            ErrorCallback err_callback;
-            {
-                std::lock_guard<std::mutex> lock(callback_mutex_);
-                msg_callback = message_callback_;
-                err_callback = error_callback_;
-            }
-            if (msg_callback && running_.load()) {
+size_t FixParser::drain_session(FixSession& session, FixMessage& parsed_message, const MessageCallback& callback) {
+    size_t drained = 0;
+    uint64_t parsed = 0;
+    uint64_t stale = 0;
+    const uint64_t generation = session.generation.load(std::memory_order_acquire);
+    while (drained < SESSION_DRAIN_BATCH && session.queue.try_consume([&](FixSessionFrame& frame) {
+        if (frame.generation != generation) {
+            ++stale;
+            return;
+        }
+        parsed_message.clear();
+        if (!decode_message(frame.data.data(), frame.data.size(), parsed_message)) {
+            return;
+        }
+        ++parsed;
+        if (!callback || !running_.load(std::memory_order_relaxed)) {
+            return;
+        }
+        try {
+            callback(session.id, parsed_message);
+        } catch (const std::exception& e) {
+            stats_.callback_errors.fetch_add(1, std::memory_order_relaxed);
+            std::lock_guard<std::mutex> lock(callback_mutex_);
+            if (error_callback_) {
                 try {
-                    msg_callback(parsed_message);
-                } catch (const std::exception& e) {
-                    stats_.callback_errors.fetch_add(1);
-                    if (err_callback && running_.load()) {
-                        try {
-                            err_callback("CALLBACK_ERROR", e.what());
-                        } catch (...) {
-                            stats_.callback_errors.fetch_add(1);
-                        }
-                    }
+                    error_callback_("CALLBACK_ERROR", e.what());
                 } catch (...) {
-                    stats_.callback_errors.fetch_add(1);
+                    stats_.callback_errors.fetch_add(1, std::memory_order_relaxed);
                 }
             }
-        } else {
-            std::this_thread::yield();
+        } catch (...) {
+            stats_.callback_errors.fetch_add(1, std::memory_order_relaxed);
         }
+    })) {
+        ++drained;
     }
-}
-bool FixParser::extract_next_message(std::string& message) {
-    static int extract_count = 0;
-    bool should_debug = (++extract_count <= 5);
-    if (message_buffer_.size() < 20) {
-        if (should_debug) std::cout << "[DEBUG] extract_next_message: buffer too small" << std::endl;
-        return false;
-    }
-    size_t start_pos = message_buffer_.find("8=FIX", buffer_position_);
-    if (start_pos == std::string::npos) {
-        buffer_position_ = 0;
-        return false;
-    }
-    size_t checksum_pos = message_buffer_.find("10=", start_pos);
-    if (checksum_pos == std::string::npos) {
-        return false;
-    }
-    size_t end_search_start = checksum_pos + 3;
-    size_t message_end = message_buffer_.find(FIX_SOH, end_search_start);
-    if (message_end == std::string::npos) {
-        return false;
+    if (parsed != 0) {
+        stats_.messages_parsed.fetch_add(parsed, std::memory_order_relaxed);
     }
-    message_end += 1;
-    size_t message_length = message_end - start_pos;
-    if (message_length > MAX_FIX_MESSAGE_SIZE) {
-        buffer_position_ = start_pos + 1;
-        return false;
+    if (stale != 0) {
+        stats_.messages_dropped.fetch_add(stale, std::memory_order_relaxed);
     }
-    message = message_buffer_.substr(start_pos, message_length);
-    buffer_position_ = message_end;
-    if (buffer_position_ > message_buffer_.size() / 2 && buffer_position_ > 1024) {
-        message_buffer_.erase(0, buffer_position_);
-        buffer_position_ = 0;
+    if (drained != parsed + stale) {
+        stats_.parse_errors.fetch_add(drained - parsed - stale, std::memory_order_relaxed);
     }
-    return true;
+    return drained;
 }
-bool FixParser::parse_message_internal(const std::string& raw_message, FixMessage& message) {
-    if (raw_message.empty()) return false;
-    message.clear();
-    std::vector<std::string> fields;
-    std::stringstream ss(raw_message);
-    std::string field;
-    size_t pos = 0;
-    while (pos < raw_message.length()) {
-        size_t next_soh = raw_message.find(FIX_SOH, pos);
-        if (next_soh == std::string::npos) {
-            next_soh = raw_message.length();
+size_t FixParser::enqueue_frames(FixSession& session, const char* data, size_t length) {
+    size_t position = 0;
+    while (position < length) {
+        const FixFrame frame = frame_fix_message(data + position, length - position);
+        const char* message = data + position + frame.start;
+        if (frame.status == FixFrameStatus::INCOMPLETE) {
+            session.pending_frame = frame.length;
+            return position + frame.start;
+        }
+        if (frame.status == FixFrameStatus::INVALID) {
+            stats_.invalid_messages.fetch_add(1, std::memory_order_relaxed);
+            position += frame.start + 1;
+            continue;
         }
-        std::string field_str = raw_message.substr(pos, next_soh - pos);
-        if (!field_str.empty()) {
-            fields.push_back(field_str);
+        position += frame.start + frame.length;
+        if (frame.status == FixFrameStatus::BAD_CHECKSUM) {
+            stats_.checksum_errors.fetch_add(1, std::memory_order_relaxed);
+            continue;
+        }
+        auto fill = [message, &frame, &session](FixSessionFrame& slot) {
+            slot.data.assign(message, frame.length);
+            slot.generation = session.buffer_generation;
+        };
+        core::WaitStrategy wait(wait_config_);
+        if (!wait.retry_until([&session, &fill]() { return session.queue.try_produce(fill); },
+                              wait_config_.enqueue_timeout_ns)) {
+            stats_.queue_full_events.fetch_add(1, std::memory_order_relaxed);
+            stats_.messages_dropped.fetch_add(1, std::memory_order_relaxed);
+            std::lock_guard<std::mutex> lock(callback_mutex_);
+            if (error_callback_) {
+                error_callback_("QUEUE_FULL", "Session queue is full after retries");
+            }
         }
-        pos = next_soh + 1;
     }
-    if (fields.empty()) return false;
-    for (const auto& field_str : fields) {
-        uint32_t tag;
-        std::string value;
-        if (!parse_field(field_str, tag, value)) {
+    return position;
+}
+size_t FixParser::dispatch_inline(FixSession& session, const char* data, size_t length) {
+    size_t position = 0;
+    while (position < length) {
+        const FixFrame frame = frame_fix_message(data + position, length - position);
+        const char* message = data + position + frame.start;
+        if (frame.status == FixFrameStatus::INCOMPLETE) {
+            session.pending_frame = frame.length;
+            return position + frame.start;
+        }
+        if (frame.status == FixFrameStatus::INVALID) {
+            stats_.invalid_messages.fetch_add(1, std::memory_order_relaxed);
+            inline_handler_->on_reject(frame.status, message, 1);
+            position += frame.start + 1;
             continue;
         }
-        message.set_field(tag, std::move(value));
-        switch (tag) {
-            case Tags::BEGIN_STRING:
-                message.begin_string = message.get_field(tag);
-                break;
-            case Tags::BODY_LENGTH:
-                try {
-                    message.body_length = std::stoul(message.get_field(tag));
-                } catch (...) {
-                    return false;
-                }
-                break;
-            case Tags::MSG_TYPE:
-                message.msg_type = message.get_field(tag);
-                break;
-            case Tags::MSG_SEQ_NUM:
-                try {
-                    message.msg_seq_num = std::stoul(message.get_field(tag));
-                } catch (...) {
-                    message.msg_seq_num = 0;
-                }
-                break;
-            case Tags::SENDER_COMP_ID:
-                message.sender_comp_id = message.get_field(tag);
-                break;
-            case Tags::TARGET_COMP_ID:
-                message.target_comp_id = message.get_field(tag);
-                break;
-            case Tags::SENDING_TIME:
-                message.sending_time = message.get_field(tag);
-                break;
-            case Tags::CHECK_SUM:
-                try {
-                    message.checksum = std::stoul(message.get_field(tag));
-                } catch (...) {
-                    message.checksum = 0;
-                }
-                break;
+        position += frame.start + frame.length;
+        if (frame.status == FixFrameStatus::BAD_CHECKSUM) {
+            stats_.checksum_errors.fetch_add(1, std::memory_order_relaxed);
+            inline_handler_->on_reject(frame.status, message, frame.length);
+            continue;
         }
+        if (!session.view->parse(message, frame.length)) {
+            stats_.parse_errors.fetch_add(1, std::memory_order_relaxed);
+            inline_handler_->on_reject(FixFrameStatus::INVALID, message, frame.length);
+            continue;
+        }
+        stats_.messages_parsed.fetch_add(1, std::memory_order_relaxed);
+        try {
+            inline_handler_->on_message(session.id, *session.view);
+        } catch (...) {
+            stats_.callback_errors.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+    return position;
+}
+bool FixParser::parse_message_internal(const std::string& raw_message, FixMessage& message) {
+    if (raw_message.empty()) return false;
+    if (!verify_frame(raw_message.data(), raw_message.size())) {
+        return false;
+    }
+    return decode_message(raw_message.data(), raw_message.size(), message);
+}
+bool FixParser::decode_message(const char* data, size_t length, FixMessage& message) {
+    FixMessageView view;
+    if (!view.parse(data, length) || !view.to_message(message)) {
+        return false;
     }
     if (!validate_message_structure(message)) {
         stats_.invalid_messages.fetch_add(1);
         return false;
     }
-    uint8_t calculated_checksum = message.calculate_checksum();
-    if (calculated_checksum != message.checksum) {
+    return true;
+}
+bool FixParser::verify_frame(const char* data, size_t length) {
+    FixFrame frame = frame_fix_message(data, length);
+    if (frame.status == FixFrameStatus::BAD_CHECKSUM) {
         stats_.checksum_errors.fetch_add(1);
         return false;
     }
+    if (frame.status != FixFrameStatus::COMPLETE || frame.start != 0 || frame.length != length) {
+        stats_.invalid_messages.fetch_add(1);
+        return false;
+    }
     return true;
 }
 bool FixParser::parse_field(const std::string& field_str, uint32_t& tag, std::string& value) {
@@ -394,13 +528,13 @@ bool FixParser::parse_field(const std::string& field_str, uint32_t& tag, std::st
     if (equals_pos == std::string::npos || equals_pos == 0) {
         return false;
     }
-    try {
-        tag = std::stoul(field_str.substr(0, equals_pos));
-        value = field_str.substr(equals_pos + 1);
-        return true;
-    } catch (...) {
+    uint64_t parsed_tag = 0;
+    if (!core::parse_uint(field_str.data(), equals_pos, parsed_tag) || parsed_tag == 0 || parsed_tag > UINT32_MAX) {
         return false;
     }
+    tag = static_cast<uint32_t>(parsed_tag);
+    value = field_str.substr(equals_pos + 1);
+    return true;
 }
 bool FixParser::validate_message_structure(const FixMessage& message) {
     return !message.begin_string.empty() &&
@@ -410,11 +544,7 @@ bool FixParser::validate_message_structure(const FixMessage& message) {
            message.body_length > 0;
 }
 uint8_t FixParser::calculate_checksum(const std::string& message_without_checksum) {
-    uint32_t sum = 0;
-    for (char c : message_without_checksum) {
-        sum += static_cast<uint8_t>(c);
-    }
-    return static_cast<uint8_t>(sum % 256);
+    return fix_checksum(message_without_checksum.data(), message_without_checksum.size());
 }
 void FixParser::update_parse_time(double parse_time_ns) {
     double current_avg = stats_.avg_parse_time_ns.load();
@@ -437,7 +567,7 @@ FixMessageBuilder& FixMessageBuilder::msg_type(const std::string& type) {
     return *this;
 }
 FixMessageBuilder& FixMessageBuilder::msg_seq_num(uint32_t seq_num) {
-    message_.set_field(Tags::MSG_SEQ_NUM, std::to_string(seq_num));
+    message_.set_field(Tags::MSG_SEQ_NUM, format_integer(static_cast<uint64_t>(seq_num)));
     message_.msg_seq_num = seq_num;
     next_seq_num_ = seq_num + 1;
     return *this;
@@ -458,17 +588,15 @@ FixMessageBuilder& FixMessageBuilder::field(uint32_t tag, const std::string& val
     return *this;
 }
 FixMessageBuilder& FixMessageBuilder::field(uint32_t tag, double value, int precision) {
-    std::ostringstream ss;
-    ss << std::fixed << std::setprecision(precision) << value;
-    message_.set_field(tag, ss.str());
+    message_.set_field(tag, format_decimal(value, precision));
     return *this;
 }
 FixMessageBuilder& FixMessageBuilder::field(uint32_t tag, int64_t value) {
-    message_.set_field(tag, std::to_string(value));
+    message_.set_field(tag, format_integer(value));
     return *this;
 }
 FixMessageBuilder& FixMessageBuilder::field(uint32_t tag, uint64_t value) {
-    message_.set_field(tag, std::to_string(value));
+    message_.set_field(tag, format_integer(value));
     return *this;
 }
 FixMessageBuilder& FixMessageBuilder::cl_ord_id(const std::string& client_order_id) {
@@ -488,13 +616,11 @@ FixMessageBuilder& FixMessageBuilder::side(char side) {
     return *this;
 }
 FixMessageBuilder& FixMessageBuilder::order_qty(uint64_t quantity) {
-    message_.set_field(Tags::ORDER_QTY, std::to_string(quantity));
+    message_.set_field(Tags::ORDER_QTY, format_integer(quantity));
     return *this;
 }
 FixMessageBuilder& FixMessageBuilder::price(double price, int precision) {
-    std::ostringstream ss;
-    ss << std::fixed << std::setprecision(precision) << price;
-    message_.set_field(Tags::PRICE, ss.str());
+    message_.set_field(Tags::PRICE, format_decimal(price, precision));
     return *this;
 }
 FixMessageBuilder& FixMessageBuilder::ord_type(char type) {
@@ -544,18 +670,18 @@ void FixMessageBuilder::calculate_and_set_body_length() {
         if (field.tag != Tags::BEGIN_STRING &&
             field.tag != Tags::BODY_LENGTH &&
             field.tag != Tags::CHECK_SUM) {
-            std::string field_str = std::to_string(field.tag) + "=" + field.value + FIX_SOH;
-            body_length += field_str.length();
+            body_length += tag_bytes(field.tag).length + static_cast<uint32_t>(field.value.size()) + 2;
         }
     }
-    message_.set_field(Tags::BODY_LENGTH, std::to_string(body_length));
+    message_.set_field(Tags::BODY_LENGTH, format_integer(static_cast<uint64_t>(body_length)));
     message_.body_length = body_length;
 }
 void FixMessageBuilder::calculate_and_set_checksum() {
     uint8_t checksum = message_.calculate_checksum();
-    std::ostringstream ss;
-    ss << std::setfill('0') << std::setw(3) << static_cast<int>(checksum);
-    message_.set_field(Tags::CHECK_SUM, ss.str());
+    const char digits[3] = {static_cast<char>('0' + checksum / 100),
+                            static_cast<char>('0' + checksum / 10 % 10),
+                            static_cast<char>('0' + checksum % 10)};
+    message_.set_field(Tags::CHECK_SUM, std::string(digits, sizeof(digits)));
     message_.checksum = checksum;
 }
 std::string generate_fix_timestamp() {
@@ -563,24 +689,45 @@ std::string generate_fix_timestamp() {
 }
 std::string generate_fix_timestamp(const core::TimePoint& time) {
     auto system_time = std::chrono::system_clock::now();
-    auto time_t_val = std::chrono::system_clock::to_time_t(system_time);
-    std::ostringstream ss;
-    ss << std::put_time(std::gmtime(&time_t_val), "%Y%m%d-%H:%M:%S");
-    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
-        system_time.time_since_epoch()) % 1000;
-    ss << "." << std::setfill('0') << std::setw(3) << ms.count();
-    return ss.str();
+    const auto epoch_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        system_time.time_since_epoch()).count();
+    char text[FIX_TIMESTAMP_LENGTH];
+    return std::string(text, format_fix_timestamp(static_cast<uint64_t>(epoch_ns), text));
 }
 std::string serialize_fix_message(const FixMessage& message) {
-    std::ostringstream ss;
+    std::string output;
+    output.reserve(message.body_length + 64);
+    auto append_field = [&output](const FixField& field) {
+        char tag[core::MAX_UINT_DIGITS];
+        output.append(tag, core::format_uint(tag, field.tag));
+        output += FIX_EQUALS;
+        output += field.value;
+        output += FIX_SOH;
+    };
+    const FixField* checksum = nullptr;
+    for (uint32_t tag : {Tags::BEGIN_STRING, Tags::BODY_LENGTH}) {
+        for (const auto& field : message.ordered_fields) {
+            if (field.tag == tag) {
+                append_field(field);
+                break;
+            }
+        }
+    }
     for (const auto& field : message.ordered_fields) {
-        ss << field.tag << "=" << field.value << FIX_SOH;
+        if (field.tag == Tags::CHECK_SUM) {
+            checksum = &field;
+        } else if (field.tag != Tags::BEGIN_STRING && field.tag != Tags::BODY_LENGTH) {
+            append_field(field);
+        }
+    }
+    if (checksum) {
+        append_field(*checksum);
     }
-    return ss.str();
+    return output;
 }
 bool is_admin_message(const std::string& msg_type) {
     return msg_type == "0" || msg_type == "1" || msg_type == "2" ||
-           msg_type == "3" || msg_type == "4" || msg_type == "5";
+           msg_type == "3" || msg_type == "4" || msg_type == "5" || msg_type == "A";
 }
 bool is_application_message(const std::string& msg_type) {
     return !is_admin_message(msg_type);
@@ -0,0 +1,106 @@
+#include "hft/fix/fix_scanner.hpp"
+#include "hft/fix/fix_parser.hpp"
+#include "hft/core/simd_scan.hpp"
+#include <algorithm>
+#include <cstring>
+namespace hft {
+namespace fix {
+namespace {
+constexpr char FIX_PREFIX[] = "8=FIX";
+constexpr size_t FIX_PREFIX_LENGTH = sizeof(FIX_PREFIX) - 1;
+constexpr size_t MAX_BEGIN_STRING_LENGTH = 16;
+inline bool is_digit(char c) {
+    return static_cast<unsigned>(c - '0') <= 9;
+}
+}
+int scan_fix_fields(const char* data, size_t length, FixFieldRef* fields, size_t max_fields) {
+    size_t count = 0;
+    const bool ok = visit_fix_fields(data, length, [&](uint32_t tag, uint32_t offset, uint32_t value_length) {
+        if (count == max_fields) {
+            return false;
+        }
+        fields[count++] = FixFieldRef{tag, offset, value_length};
+        return true;
+    });
+    return ok ? static_cast<int>(count) : -1;
+}
+uint8_t fix_checksum(const char* data, size_t length) {
+    return static_cast<uint8_t>(core::byte_sum(data, length) % 256);
+}
+FixFrame frame_fix_message(const char* data, size_t length) {
+    FixFrame frame{FixFrameStatus::INCOMPLETE, 0, 0, 0, 0};
+    const char* const end = data + length;
+    const char* start = data;
+    for (;;) {
+        start = core::find_byte(start, end, FIX_PREFIX[0]);
+        if (start == end) {
+            frame.start = length;
+            return frame;
+        }
+        if (static_cast<size_t>(end - start) < FIX_PREFIX_LENGTH) {
+            frame.start = static_cast<size_t>(start - data);
+            return frame;
+        }
+        if (std::memcmp(start, FIX_PREFIX, FIX_PREFIX_LENGTH) == 0) {
+            break;
+        }
+        ++start;
+    }
+    frame.start = static_cast<size_t>(start - data);
+    const char* begin_string_end = core::find_byte(start + FIX_PREFIX_LENGTH, end, FIX_SOH);
+    if (static_cast<size_t>(begin_string_end - start) > MAX_BEGIN_STRING_LENGTH) {
+        frame.status = FixFrameStatus::INVALID;
+        return frame;
+    }
+    if (begin_string_end == end) {
+        return frame;
+    }
+    const char* cursor = begin_string_end + 1;
+    if (end - cursor < 2) {
+        return frame;
+    }
+    if (cursor[0] != '9' || cursor[1] != FIX_EQUALS) {
+        frame.status = FixFrameStatus::INVALID;
+        return frame;
+    }
+    cursor += 2;
+    const char* digits_start = cursor;
+    uint32_t body_length = 0;
+    while (cursor < end && is_digit(*cursor) && cursor - digits_start < 6) {
+        body_length = body_length * 10 + static_cast<uint32_t>(*cursor - '0');
+        ++cursor;
+    }
+    if (cursor == end) {
+        return frame;
+    }
+    if (cursor == digits_start || *cursor != FIX_SOH) {
+        frame.status = FixFrameStatus::INVALID;
+        return frame;
+    }
+    const char* body_start = cursor + 1;
+    const size_t total_length = static_cast<size_t>(body_start - start) + body_length + FIX_TRAILER_LENGTH;
+    if (total_length > MAX_FIX_MESSAGE_SIZE) {
+        frame.status = FixFrameStatus::INVALID;
+        return frame;
+    }
+    if (static_cast<size_t>(end - start) < total_length) {
+        frame.length = total_length;
+        return frame;
+    }
+    const char* trailer = body_start + body_length;
+    if (trailer[0] != '1' || trailer[1] != '0' || trailer[2] != FIX_EQUALS ||
+        !is_digit(trailer[3]) || !is_digit(trailer[4]) || !is_digit(trailer[5]) || trailer[6] != FIX_SOH) {
+        frame.status = FixFrameStatus::INVALID;
+        return frame;
+    }
+    frame.length = total_length;
+    frame.body_length = body_length;
+    frame.checksum = fix_checksum(start, static_cast<size_t>(trailer - start));
+    const uint32_t declared = static_cast<uint32_t>(trailer[3] - '0') * 100 +
+                              static_cast<uint32_t>(trailer[4] - '0') * 10 +
+                              static_cast<uint32_t>(trailer[5] - '0');
+    frame.status = declared == frame.checksum ? FixFrameStatus::COMPLETE : FixFrameStatus::BAD_CHECKSUM;
+    return frame;
+}
+}
+}
@@ -0,0 +1,321 @@
+#include "hft/fix/fix_session.hpp"
+#include "hft/core/numeric.hpp"
+#include <algorithm>
+#include <iostream>
+namespace hft {
+namespace fix {
+FixSessionEngine::FixSessionEngine(const FixSessionConfig& config, FixTransport* transport,
+                                   FixMessageHandler* application)
+    : config_(config), transport_(transport), application_(application),
+      encoder_(config.sender_comp_id, config.target_comp_id, config.begin_string),
+      state_(FixSessionState::DISCONNECTED),
+      heartbeat_interval_ns_(static_cast<uint64_t>(config.heartbeat_interval_s) * 1000000000ull), clock_ns_(0),
+      last_sent_ns_(0), last_received_ns_(0), resend_pending_(false), resend_target_seq_(0),
+      test_request_pending_(false), test_request_counter_(0), test_req_id_{}, test_req_id_length_(0) {}
+bool FixSessionEngine::open() {
+    if (!store_.open(config_.store_path, config_.store_capacity, config_.store_index_slots)) {
+        std::cerr << "Failed to open FIX session " << config_.sender_comp_id << "->" << config_.target_comp_id
+                  << std::endl;
+        return false;
+    }
+    return true;
+}
+bool FixSessionEngine::logon(uint64_t now_ns) {
+    if (state_ != FixSessionState::DISCONNECTED || !store_.is_open()) {
+        return false;
+    }
+    clock_ns_ = now_ns;
+    last_sent_ns_ = now_ns;
+    last_received_ns_ = now_ns;
+    if (config_.reset_on_logon) {
+        store_.reset();
+    }
+    Logon message{};
+    message.heart_bt_int = config_.heartbeat_interval_s;
+    message.reset_seq_num_flag = config_.reset_on_logon ? 'Y' : '\0';
+    state_ = FixSessionState::LOGON_SENT;
+    return send(message);
+}
+bool FixSessionEngine::logout(std::string_view text) {
+    if (state_ != FixSessionState::ACTIVE) {
+        return false;
+    }
+    state_ = FixSessionState::LOGOUT_SENT;
+    return send(Logout{text});
+}
+void FixSessionEngine::on_disconnect() {
+    state_ = FixSessionState::DISCONNECTED;
+    resend_pending_ = false;
+    test_request_pending_ = false;
+    if (store_.is_open()) {
+        store_.flush();
+    }
+}
+void FixSessionEngine::on_timer(uint64_t now_ns) {
+    clock_ns_ = now_ns;
+    if (state_ == FixSessionState::DISCONNECTED || heartbeat_interval_ns_ == 0) {
+        return;
+    }
+    const uint64_t idle_in = now_ns - std::min(now_ns, last_received_ns_);
+    if (test_request_pending_ && idle_in >= 2 * heartbeat_interval_ns_) {
+        std::cerr << "FIX session " << config_.sender_comp_id << "->" << config_.target_comp_id
+                  << " heartbeat timeout" << std::endl;
+        on_disconnect();
+        disconnect_transport();
+        return;
+    }
+    if (!test_request_pending_ && idle_in >= heartbeat_interval_ns_ + heartbeat_interval_ns_ / 5) {
+        test_req_id_length_ = static_cast<size_t>(core::format_uint(test_req_id_, ++test_request_counter_) - test_req_id_);
+        test_request_pending_ = true;
+        stats_.test_requests_sent.fetch_add(1);
+        send(TestRequest{std::string_view(test_req_id_, test_req_id_length_)});
+    }
+    if (now_ns - std::min(now_ns, last_sent_ns_) >= heartbeat_interval_ns_) {
+        stats_.heartbeats_sent.fetch_add(1);
+        send(Heartbeat{});
+    }
+}
+void FixSessionEngine::on_message(FixSessionId session_id, const FixMessageView& message) {
+    stats_.messages_received.fetch_add(1);
+    last_received_ns_ = clock_ns_;
+    if (!check_comp_ids(message)) {
+        stats_.comp_id_rejects.fetch_add(1);
+        terminate("CompID problem");
+        return;
+    }
+    const FixMsgType type = classify_msg_type(message.msg_type());
+    const uint64_t seq = message.msg_seq_num();
+    if (type == FixMsgType::LOGON) {
+        if (!on_logon(message, seq)) {
+            return;
+        }
+    } else if (state_ == FixSessionState::DISCONNECTED) {
+        stats_.rejects_received.fetch_add(1);
+        return;
+    }
+    if (type == FixMsgType::SEQUENCE_RESET) {
+        on_sequence_reset(message, seq);
+        return;
+    }
+    if (!check_sequence(message, type, seq)) {
+        return;
+    }
+    switch (type) {
+        case FixMsgType::HEARTBEAT: on_heartbeat(message); break;
+        case FixMsgType::TEST_REQUEST: on_test_request(message); break;
+        case FixMsgType::RESEND_REQUEST: on_resend_request(message); break;
+        case FixMsgType::REJECT: stats_.rejects_received.fetch_add(1); break;
+        case FixMsgType::LOGOUT: on_logout(); break;
+        case FixMsgType::LOGON: break;
+        default:
+            stats_.application_messages.fetch_add(1);
+            if (application_) {
+                application_->on_message(session_id, message);
+            }
+            break;
+    }
+}
+bool FixSessionEngine::transmit(const char* data, size_t length) {
+    last_sent_ns_ = clock_ns_;
+    if (!transport_ || !transport_->send(data, length)) {
+        stats_.send_failures.fetch_add(1);
+        return false;
+    }
+    stats_.messages_sent.fetch_add(1);
+    return true;
+}
+void FixSessionEngine::disconnect_transport() {
+    if (transport_) {
+        transport_->disconnect();
+    }
+}
+void FixSessionEngine::advance_target_seq(uint64_t seq) {
+    store_.set_next_target_seq(seq);
+    if (resend_pending_ && seq > resend_target_seq_) {
+        resend_pending_ = false;
+    }
+}
+bool FixSessionEngine::check_comp_ids(const FixMessageView& message) const {
+    return message.get_field(Tags::SENDER_COMP_ID) == config_.target_comp_id &&
+           message.get_field(Tags::TARGET_COMP_ID) == config_.sender_comp_id;
+}
+bool FixSessionEngine::check_sequence(const FixMessageView& message, FixMsgType type, uint64_t seq) {
+    const uint64_t expected = store_.next_target_seq();
+    if (seq == expected) {
+        advance_target_seq(seq + 1);
+        return true;
+    }
+    if (seq > expected) {
+        stats_.sequence_gaps.fetch_add(1);
+        request_resend(seq);
+        return is_admin_msg_type(type) && type != FixMsgType::SEQUENCE_RESET;
+    }
+    char poss_dup = '\0';
+    if (message.get_char(Tags::POSS_DUP_FLAG, poss_dup) && poss_dup == 'Y') {
+        stats_.duplicates_ignored.fetch_add(1);
+        return false;
+    }
+    terminate("MsgSeqNum too low");
+    return false;
+}
+bool FixSessionEngine::on_logon(const FixMessageView& message, uint64_t seq) {
+    Logon logon{};
+    if (!decode_fix_message(message, logon).ok()) {
+        terminate("Invalid Logon");
+        return false;
+    }
+    if (state_ == FixSessionState::DISCONNECTED) {
+        if (logon.reset_seq_num_flag == 'Y') {
+            store_.reset();
+        }
+        if (seq < store_.next_target_seq()) {
+            terminate("MsgSeqNum too low");
+            return false;
+        }
+        if (logon.heart_bt_int != 0) {
+            heartbeat_interval_ns_ = logon.heart_bt_int * 1000000000ull;
+        }
+        last_received_ns_ = clock_ns_;
+        Logon response{};
+        response.heart_bt_int = heartbeat_interval_ns_ / 1000000000ull;
+        response.reset_seq_num_flag = logon.reset_seq_num_flag == 'Y' ? 'Y' : '\0';
+        state_ = FixSessionState::ACTIVE;
+        return send(response);
+    }
+    if (state_ == FixSessionState::LOGON_SENT) {
+        state_ = FixSessionState::ACTIVE;
+    }
+    return true;
+}
+void FixSessionEngine::on_sequence_reset(const FixMessageView& message, uint64_t seq) {
+    SequenceReset reset{};
+    if (!decode_fix_message(message, reset).ok()) {
+        stats_.rejects_received.fetch_add(1);
+        return;
+    }
+    if (reset.gap_fill_flag != 'Y') {
+        if (reset.new_seq_no >= store_.next_target_seq()) {
+            advance_target_seq(reset.new_seq_no);
+        }
+        return;
+    }
+    if (check_sequence(message, FixMsgType::SEQUENCE_RESET, seq) && reset.new_seq_no > store_.next_target_seq()) {
+        advance_target_seq(reset.new_seq_no);
+    }
+}
+void FixSessionEngine::on_resend_request(const FixMessageView& message) {
+    ResendRequest request{};
+    if (!decode_fix_message(message, request).ok()) {
+        stats_.rejects_received.fetch_add(1);
+        return;
+    }
+    stats_.resend_requests_served.fetch_add(1);
+    const uint64_t last = store_.next_sender_seq() - 1;
+    const uint64_t begin = std::max<uint64_t>(request.begin_seq_no, 1);
+    const uint64_t end = request.end_seq_no == 0 || request.end_seq_no > last ? last : request.end_seq_no;
+    uint64_t gap_start = 0;
+    for (uint64_t seq = begin; seq <= end; ++seq) {
+        const std::string_view stored = store_.lookup(seq);
+        const bool replay = !stored.empty() && resend_view_.parse(stored) &&
+                            !is_admin_msg_type(classify_msg_type(resend_view_.msg_type()));
+        if (!replay) {
+            gap_start = gap_start ? gap_start : seq;
+            continue;
+        }
+        if (gap_start != 0) {
+            send_gap_fill(gap_start, seq);
+        }
+        gap_start = resend_stored(stored) ? 0 : seq;
+    }
+    if (gap_start != 0) {
+        send_gap_fill(gap_start, end + 1);
+    }
+}
+void FixSessionEngine::on_test_request(const FixMessageView& message) {
+    TestRequest request{};
+    if (!decode_fix_message(message, request).ok()) {
+        stats_.rejects_received.fetch_add(1);
+        return;
+    }
+    stats_.heartbeats_sent.fetch_add(1);
+    send(Heartbeat{request.test_req_id});
+}
+void FixSessionEngine::on_heartbeat(const FixMessageView& message) {
+    if (test_request_pending_ &&
+        message.get_field(Tags::TEST_REQ_ID) == std::string_view(test_req_id_, test_req_id_length_)) {
+        test_request_pending_ = false;
+    }
+}
+void FixSessionEngine::on_logout() {
+    if (state_ != FixSessionState::LOGOUT_SENT) {
+        send(Logout{});
+    }
+    on_disconnect();
+    disconnect_transport();
+}
+void FixSessionEngine::request_resend(uint64_t seq) {
+    resend_target_seq_ = std::max(resend_target_seq_, seq);
+    if (resend_pending_) {
+        return;
+    }
+    resend_pending_ = true;
+    stats_.resend_requests_sent.fetch_add(1);
+    send(ResendRequest{store_.next_target_seq(), 0});
+}
+bool FixSessionEngine::send_gap_fill(uint64_t seq, uint64_t new_seq_no) {
+    const std::string_view wire = encoder_.encode(SequenceReset{'Y', 'Y', new_seq_no}, static_cast<uint32_t>(seq),
+                                                  sending_time_ns());
+    if (wire.empty()) {
+        stats_.send_failures.fetch_add(1);
+        return false;
+    }
+    stats_.gap_fills_sent.fetch_add(1);
+    return transmit(wire.data(), wire.size());
+}
+bool FixSessionEngine::resend_stored(std::string_view stored) {
+    const FixFieldRef* msg_type = resend_view_.find(Tags::MSG_TYPE);
+    const FixFieldRef* sending_time = resend_view_.find(Tags::SENDING_TIME);
+    const FixFieldRef* checksum = resend_view_.find(Tags::CHECK_SUM);
+    if (!msg_type || !sending_time || !checksum || msg_type->offset < 3 || checksum->offset < 3) {
+        return false;
+    }
+    const size_t body_begin = msg_type->offset - 3;
+    const size_t time_end = sending_time->offset + sending_time->length;
+    const size_t trailer_begin = checksum->offset - 3;
+    char timestamp[FIX_TIMESTAMP_LENGTH];
+    const size_t timestamp_length = format_fix_timestamp(sending_time_ns(), timestamp);
+    resend_body_.assign(stored.data() + body_begin, sending_time->offset - body_begin);
+    resend_body_.append(timestamp, timestamp_length);
+    resend_body_ += FIX_SOH;
+    resend_body_ += "43=Y";
+    resend_body_ += FIX_SOH;
+    resend_body_ += "122=";
+    resend_body_.append(stored.data() + sending_time->offset, sending_time->length);
+    resend_body_.append(stored.data() + time_end, trailer_begin - time_end);
+    char digits[core::MAX_UINT_DIGITS];
+    resend_buffer_ = "8=";
+    resend_buffer_ += config_.begin_string;
+    resend_buffer_ += FIX_SOH;
+    resend_buffer_ += "9=";
+    resend_buffer_.append(digits, static_cast<size_t>(core::format_uint(digits, resend_body_.size()) - digits));
+    resend_buffer_ += FIX_SOH;
+    resend_buffer_ += resend_body_;
+    const uint32_t sum = fix_checksum(resend_buffer_.data(), resend_buffer_.size());
+    resend_buffer_ += "10=";
+    resend_buffer_ += static_cast<char>('0' + sum / 100);
+    resend_buffer_.append(&core::DIGIT_PAIRS[(sum % 100) * 2], 2);
+    resend_buffer_ += FIX_SOH;
+    stats_.messages_resent.fetch_add(1);
+    return transmit(resend_buffer_.data(), resend_buffer_.size());
+}
+void FixSessionEngine::terminate(std::string_view text) {
+    std::cerr << "FIX session " << config_.sender_comp_id << "->" << config_.target_comp_id << " terminated: " << text
+              << std::endl;
+    if (state_ != FixSessionState::DISCONNECTED) {
+        send(Logout{text});
+    }
+    on_disconnect();
+    disconnect_transport();
+}
+}
+}
@@ -0,0 +1,105 @@
+#include "hft/fix/fix_session_codec.hpp"
+#include <chrono>
+#include <string>
+namespace hft {
+namespace fix {
+FixSessionCodec::FixSessionCodec(FixParser& parser, const FixSessionConfig& config, FixMessageHandler& application,
+                                 FixDropCopyLog* drop_copy)
+    : parser_(parser), config_(config), application_(application), drop_copy_(drop_copy), gateway_(nullptr),
+      sessions_(std::make_unique<Session[]>(FixGateway::MAX_CONNECTIONS)), next_timer_ns_(0) {}
+FixConnectionId FixSessionCodec::open_connection() {
+    const FixConnectionId connection_id = parser_.open_session();
+    Session* session = find_session(connection_id);
+    if (!session) {
+        stats_.sessions_rejected.fetch_add(1, std::memory_order_relaxed);
+        return FixGateway::INVALID_CONNECTION;
+    }
+    {
+        std::lock_guard<std::recursive_mutex> lock(session->mutex);
+        if (!session->engine) {
+            FixSessionConfig config = config_;
+            config.store_path = config_.store_path + "." + std::to_string(connection_id);
+            session->transport = std::make_unique<Transport>(*this, connection_id);
+            session->engine = std::make_unique<FixSessionEngine>(config, session->transport.get(), &application_);
+        }
+        if (session->engine->store().is_open() || session->engine->open()) {
+            session->engine->store().reset();
+            session->engine->on_timer(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count()));
+            session->open.store(true, std::memory_order_release);
+            stats_.sessions_opened.fetch_add(1, std::memory_order_relaxed);
+            return connection_id;
+        }
+    }
+    parser_.close_session(connection_id);
+    stats_.sessions_rejected.fetch_add(1, std::memory_order_relaxed);
+    return FixGateway::INVALID_CONNECTION;
+}
+bool FixSessionCodec::on_data(FixConnectionId connection_id, const char* data, size_t length) {
+    parser_.feed_data(connection_id, data, length);
+    return true;
+}
+void FixSessionCodec::close_connection(FixConnectionId connection_id) {
+    Session* session = find_session(connection_id);
+    if (!session) {
+        return;
+    }
+    {
+        std::lock_guard<std::recursive_mutex> lock(session->mutex);
+        if (!session->open.exchange(false)) {
+            return;
+        }
+        session->engine->on_disconnect();
+    }
+    parser_.close_session(connection_id);
+    application_.on_session_closed(connection_id);
+    stats_.sessions_closed.fetch_add(1, std::memory_order_relaxed);
+}
+void FixSessionCodec::on_timer(uint64_t now_ns) {
+    if (now_ns < next_timer_ns_) {
+        return;
+    }
+    next_timer_ns_ = now_ns + TIMER_INTERVAL_NS;
+    for (FixConnectionId connection_id = 0; connection_id < FixGateway::MAX_CONNECTIONS; ++connection_id) {
+        Session& session = sessions_[connection_id];
+        if (!session.open.load(std::memory_order_acquire)) {
+            continue;
+        }
+        std::lock_guard<std::recursive_mutex> lock(session.mutex);
+        if (session.open.load(std::memory_order_relaxed)) {
+            session.engine->on_timer(now_ns);
+        }
+    }
+}
+void FixSessionCodec::on_message(FixSessionId session_id, const FixMessageView& message) {
+    Session* session = find_session(session_id);
+    if (!session) {
+        return;
+    }
+    std::lock_guard<std::recursive_mutex> lock(session->mutex);
+    if (!session->open.load(std::memory_order_relaxed)) {
+        return;
+    }
+    if (drop_copy_) {
+        drop_copy_->append(FixDropCopyDirection::INBOUND, session_id, message.data(), message.size());
+    }
+    session->engine->on_message(session_id, message);
+}
+bool FixSessionCodec::transmit(FixConnectionId connection_id, const char* data, size_t length) {
+    FixGateway* gateway = gateway_.load(std::memory_order_acquire);
+    if (!gateway) {
+        return false;
+    }
+    if (drop_copy_) {
+        drop_copy_->append(FixDropCopyDirection::OUTBOUND, connection_id, data, length);
+    }
+    return gateway->send(connection_id, data, length);
+}
+void FixSessionCodec::disconnect(FixConnectionId connection_id) {
+    FixGateway* gateway = gateway_.load(std::memory_order_acquire);
+    if (gateway) {
+        gateway->close_connection(connection_id);
+    }
+}
+}
+}
@@ -0,0 +1,1153 @@
+#include "hft/fix/fix_parser.hpp"
+#include "hft/fix/fix_scanner.hpp"
+#include "hft/fix/fix_message_view.hpp"
+#include "hft/fix/fix_dictionary.hpp"
+#include "hft/fix/fix_drop_copy.hpp"
+#include "hft/fix/fix_encoder.hpp"
+#include "hft/core/simd_scan.hpp"
+#include "hft/core/numeric.hpp"
+#include "hft/core/mirrored_ring_buffer.hpp"
+#include <algorithm>
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <filesystem>
+#include <chrono>
+#include <atomic>
+#include <thread>
+#include <random>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <charconv>
+#include <cmath>
+#include <new>
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+using hft::fix::FIX_SOH;
+namespace {
+std::atomic<uint64_t> heap_allocations{0};
+}
+void* operator new(size_t size) {
+    heap_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* memory = std::malloc(size ? size : 1)) {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+void operator delete(void* memory) noexcept {
+    std::free(memory);
+}
+void operator delete(void* memory, size_t) noexcept {
+    std::free(memory);
+}
+class CacheMissCounter {
+private:
+    int fd_;
+public:
+    CacheMissCounter() : fd_(-1) {
+#ifdef __linux__
+        perf_event_attr attr{};
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.size = sizeof(attr);
+        attr.config = PERF_COUNT_HW_CACHE_MISSES;
+        attr.disabled = 1;
+        attr.inherit = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        fd_ = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+#endif
+    }
+    ~CacheMissCounter() {
+#ifdef __linux__
+        if (fd_ >= 0) {
+            close(fd_);
+        }
+#endif
+    }
+    CacheMissCounter(const CacheMissCounter&) = delete;
+    CacheMissCounter& operator=(const CacheMissCounter&) = delete;
+    bool available() const { return fd_ >= 0; }
+    void start() {
+#ifdef __linux__
+        if (fd_ >= 0) {
+            ioctl(fd_, PERF_EVENT_IOC_RESET, 0);
+            ioctl(fd_, PERF_EVENT_IOC_ENABLE, 0);
+        }
+#endif
+    }
+    int64_t stop() {
+#ifdef __linux__
+        uint64_t count = 0;
+        if (fd_ >= 0 && ioctl(fd_, PERF_EVENT_IOC_DISABLE, 0) == 0 && read(fd_, &count, sizeof(count)) == sizeof(count)) {
+            return static_cast<int64_t>(count);
+        }
+#endif
+        return -1;
+    }
+};
+class FixScanBenchmark {
+private:
+    struct BenchResult {
+        std::string name;
+        double seconds;
+        uint64_t bytes;
+        uint64_t messages;
+        uint64_t sink;
+    };
+    class CountingHandler : public hft::fix::FixMessageHandler {
+    public:
+        uint64_t messages = 0;
+        uint64_t rejects = 0;
+        void on_message(hft::fix::FixSessionId, const hft::fix::FixMessageView& message) override {
+            messages += message.field_count() != 0;
+        }
+        void on_reject(hft::fix::FixFrameStatus, const char*, size_t) override {
+            ++rejects;
+        }
+    };
+    struct PathResult {
+        BenchResult bench;
+        uint64_t allocations;
+        int64_t cache_misses;
+    };
+    struct ScalingResult {
+        size_t workers;
+        size_t feeders;
+        double seconds;
+        uint64_t messages;
+    };
+    static constexpr size_t FEED_CHUNK_SIZE = 4096;
+    static constexpr size_t MAX_SPLIT_READ = 1500;
+    static constexpr size_t SCALING_SESSIONS = 256;
+    static constexpr size_t NUMERIC_FUZZ_CASES = 1000000;
+    static constexpr size_t DECODER_FUZZ_CASES = 200000;
+    static constexpr size_t DROP_COPY_SEGMENT_SIZE = 4 * 1024 * 1024;
+    static constexpr size_t DROP_COPY_PRODUCERS = 4;
+    static constexpr uint64_t DROP_COPY_PRODUCER_SHIFT = 40;
+    std::string corpus_;
+    std::vector<std::string> numeric_fields_;
+    std::vector<double> price_values_;
+    std::vector<std::pair<size_t, size_t>> spans_;
+    std::string mixed_corpus_;
+    std::vector<std::pair<size_t, size_t>> mixed_spans_;
+    std::vector<size_t> split_reads_;
+    size_t iterations_;
+public:
+    FixScanBenchmark(size_t message_count, size_t iterations) : iterations_(iterations) {
+        build_corpus(message_count);
+    }
+    void run() {
+        std::cout << "FIX SCANNER BENCHMARK" << std::endl;
+        std::cout << "=====================" << std::endl;
+        std::cout << "Backend:    " << hft::core::simd_scan_backend() << std::endl;
+        std::cout << "Messages:   " << spans_.size() << std::endl;
+        std::cout << "Corpus:     " << corpus_.size() << " bytes" << std::endl;
+        std::cout << "Iterations: " << iterations_ << std::endl;
+        BenchResult legacy_framing = run_legacy_framing();
+        BenchResult simd_framing = run_simd_framing();
+        BenchResult legacy_split = run_legacy_split();
+        BenchResult simd_split = run_simd_split();
+        BenchResult legacy_decode = run_legacy_decode();
+        BenchResult typed_decode = run_typed_decode();
+        BenchResult extractor_decode = run_legacy_extractor();
+        BenchResult raw_decode = run_raw_decode();
+        const uint64_t decoder_mismatches = fuzz_order_decoder();
+        BenchResult legacy_encode = run_legacy_encode();
+        BenchResult template_encode = run_template_encode();
+        BenchResult legacy_numeric_parse = run_legacy_numeric_parse();
+        BenchResult kernel_numeric_parse = run_kernel_numeric_parse();
+        BenchResult legacy_numeric_format = run_legacy_numeric_format();
+        BenchResult kernel_numeric_format = run_kernel_numeric_format();
+        const uint64_t numeric_mismatches = fuzz_numeric_kernels();
+        BenchResult queued_pipeline = run_queued_pipeline();
+        BenchResult inline_pipeline = run_inline_pipeline();
+        BenchResult string_buffer_feed = run_string_buffer_feed();
+        BenchResult ring_buffer_feed = run_ring_buffer_feed();
+        BenchResult session_split_feed = run_session_split_feed();
+        std::cout << "\nFraming" << std::endl;
+        print_result(legacy_framing);
+        print_result(simd_framing);
+        print_speedup(legacy_framing, simd_framing);
+        std::cout << "\nField splitting" << std::endl;
+        print_result(legacy_split);
+        print_result(simd_split);
+        print_speedup(legacy_split, simd_split);
+        std::cout << "\nNewOrderSingle decoding" << std::endl;
+        print_result(legacy_decode);
+        print_result(typed_decode);
+        print_speedup(legacy_decode, typed_decode);
+        print_result(extractor_decode);
+        print_result(raw_decode);
+        print_speedup(extractor_decode, raw_decode);
+        std::cout << "  fuzz cross-check: " << DECODER_FUZZ_CASES << " cases, " << decoder_mismatches
+                  << " mismatches" << std::endl;
+        std::cout << "\nExecutionReport encoding" << std::endl;
+        print_encode_result(legacy_encode);
+        print_encode_result(template_encode);
+        print_speedup(legacy_encode, template_encode);
+        std::cout << "\nNumeric parsing" << std::endl;
+        print_result(legacy_numeric_parse);
+        print_result(kernel_numeric_parse);
+        print_speedup(legacy_numeric_parse, kernel_numeric_parse);
+        std::cout << "\nNumeric formatting" << std::endl;
+        print_result(legacy_numeric_format);
+        print_result(kernel_numeric_format);
+        print_speedup(legacy_numeric_format, kernel_numeric_format);
+        std::cout << "  fuzz cross-check: " << NUMERIC_FUZZ_CASES << " cases, " << numeric_mismatches
+                  << " mismatches" << std::endl;
+        std::cout << "\nFixParser feed_data (" << FEED_CHUNK_SIZE << " byte reads)" << std::endl;
+        print_result(queued_pipeline);
+        print_result(inline_pipeline);
+        print_speedup(queued_pipeline, inline_pipeline);
+        std::cout << "\nSession buffering (1-" << MAX_SPLIT_READ << " byte reads)" << std::endl;
+        print_result(string_buffer_feed);
+        print_result(ring_buffer_feed);
+        print_speedup(string_buffer_feed, ring_buffer_feed);
+        print_result(session_split_feed);
+        const bool paths_ok = run_parse_paths();
+        run_session_scaling();
+        const bool drop_copy_ok = run_drop_copy();
+        if (!paths_ok || !drop_copy_ok || legacy_framing.messages != simd_framing.messages || legacy_split.sink != simd_split.sink ||
+            legacy_decode.sink != typed_decode.sink || legacy_decode.sink != raw_decode.sink ||
+            legacy_decode.sink != extractor_decode.sink || string_buffer_feed.messages != ring_buffer_feed.messages ||
+            ring_buffer_feed.messages != spans_.size() * iterations_ ||
+            session_split_feed.messages != ring_buffer_feed.messages ||
+            legacy_numeric_parse.sink != kernel_numeric_parse.sink || numeric_mismatches != 0 ||
+            decoder_mismatches != 0) {
+            std::cout << "\nWARNING: legacy and SIMD results disagree" << std::endl;
+        }
+    }
+private:
+    static std::string make_new_order_single(uint64_t seq_num, uint64_t order_id, const std::string& symbol,
+                                             char side, uint64_t quantity, double price) {
+        char price_text[32];
+        std::snprintf(price_text, sizeof(price_text), "%.2f", price);
+        std::string body;
+        body.reserve(192);
+        body += "35=D\x01" "49=CLIENT01\x01" "56=HFTENGINE\x01" "34=";
+        body += std::to_string(seq_num);
+        body += "\x01" "52=20240115-14:30:00.123456\x01" "11=";
+        body += std::to_string(order_id);
+        body += "\x01" "55=";
+        body += symbol;
+        body += "\x01" "54=";
+        body += side;
+        body += "\x01" "38=";
+        body += std::to_string(quantity);
+        body += "\x01" "44=";
+        body += price_text;
+        body += "\x01" "40=2\x01" "59=0\x01" "60=20240115-14:30:00.123456\x01";
+        std::string message = "8=FIX.4.4\x01" "9=" + std::to_string(body.size()) + FIX_SOH + body;
+        uint32_t sum = 0;
+        for (unsigned char c : message) {
+            sum += c;
+        }
+        char trailer[8];
+        std::snprintf(trailer, sizeof(trailer), "10=%03u\x01", sum % 256);
+        message += trailer;
+        return message;
+    }
+    void build_corpus(size_t message_count) {
+        static const char* symbols[] = {"AAPL", "MSFT", "GOOGL", "AMZN", "TSLA", "NVDA", "META", "JPM"};
+        std::mt19937_64 rng(42);
+        std::uniform_int_distribution<uint64_t> quantity_dist(1, 5000);
+        std::uniform_real_distribution<double> price_dist(10.0, 1000.0);
+        corpus_.reserve(message_count * 200);
+        spans_.reserve(message_count);
+        for (size_t i = 0; i < message_count; ++i) {
+            std::string message = make_new_order_single(i + 1, 1000000 + i, symbols[i % 8],
+                                                        (i & 1) ? '2' : '1', quantity_dist(rng), price_dist(rng));
+            spans_.emplace_back(corpus_.size(), message.size());
+            corpus_ += message;
+        }
+        numeric_fields_.reserve(message_count * 2);
+        price_values_.reserve(message_count);
+        for (size_t i = 0; i < message_count; ++i) {
+            const double price = price_dist(rng);
+            char price_text[32];
+            std::snprintf(price_text, sizeof(price_text), "%.*f", static_cast<int>(i % 5), price);
+            numeric_fields_.push_back(std::to_string(quantity_dist(rng) * (1 + i % 1000)));
+            numeric_fields_.push_back(price_text);
+            price_values_.push_back(price);
+        }
+        build_mixed_corpus(message_count);
+        std::uniform_int_distribution<size_t> read_dist(1, MAX_SPLIT_READ);
+        for (size_t covered = 0; covered < corpus_.size();) {
+            split_reads_.push_back(std::min(read_dist(rng), corpus_.size() - covered));
+            covered += split_reads_.back();
+        }
+    }
+    void build_mixed_corpus(size_t message_count) {
+        static const char* symbols[] = {"AAPL", "MSFT", "GOOGL", "AMZN", "TSLA", "NVDA", "META", "JPM"};
+        hft::fix::FixMessageEncoder client("CLIENT01", "HFTENGINE");
+        hft::fix::FixMessageEncoder engine("HFTENGINE", "CLIENT01");
+        const uint64_t sending_time = 1705329000123456000ull;
+        mixed_corpus_.reserve(message_count * 200);
+        mixed_spans_.reserve(message_count);
+        for (size_t i = 0; i < message_count; ++i) {
+            const uint64_t order_id = 2000000 + i / 4 * 4;
+            const char* symbol = symbols[i / 4 % 8];
+            const char side = (i / 4 & 1) ? '2' : '1';
+            const uint64_t quantity = 100 + i % 900;
+            const double price = 100.0 + static_cast<double>(i % 500) * 0.01;
+            std::string_view encoded;
+            if (i % 4 == 0) {
+                hft::fix::NewOrderSingle order{order_id, symbol, side, quantity, '2', price, '0',
+                                               "20240115-14:30:00.123456"};
+                encoded = client.encode(order, static_cast<uint32_t>(i + 1), sending_time);
+            } else if (i % 4 == 2) {
+                hft::fix::OrderCancelRequest cancel{order_id, order_id + 2, order_id, symbol, side, quantity,
+                                                    "20240115-14:30:00.223456"};
+                encoded = client.encode(cancel, static_cast<uint32_t>(i + 1), sending_time);
+            } else {
+                const bool canceled = i % 4 == 3;
+                hft::fix::ExecutionReport report{order_id, order_id + (canceled ? 2 : 0), i, canceled ? '4' : '0',
+                                                 canceled ? '4' : '0', symbol, side, quantity, price, 0, 0.0,
+                                                 canceled ? 0 : quantity, 0, 0.0};
+                encoded = engine.encode(report, static_cast<uint32_t>(i + 1), sending_time);
+            }
+            mixed_spans_.emplace_back(mixed_corpus_.size(), encoded.size());
+            mixed_corpus_.append(encoded.data(), encoded.size());
+        }
+    }
+    template <typename Body>
+    PathResult profile(const std::string& name, Body&& body) {
+        BenchResult result{name, 0.0, 0, 0, 0};
+        body(result);
+        result = BenchResult{name, 0.0, 0, 0, 0};
+        CacheMissCounter cache_misses;
+        const uint64_t allocations = heap_allocations.load();
+        cache_misses.start();
+        auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < iterations_; ++i) {
+            body(result);
+        }
+        auto end = std::chrono::steady_clock::now();
+        const int64_t misses = cache_misses.stop();
+        result.seconds = std::chrono::duration<double>(end - start).count();
+        return PathResult{result, heap_allocations.load() - allocations, misses};
+    }
+    template <typename Body>
+    BenchResult measure(const std::string& name, Body&& body) {
+        BenchResult result{name, 0.0, 0, 0, 0};
+        body(result);
+        result = BenchResult{name, 0.0, 0, 0, 0};
+        auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < iterations_; ++i) {
+            body(result);
+        }
+        auto end = std::chrono::steady_clock::now();
+        result.seconds = std::chrono::duration<double>(end - start).count();
+        return result;
+    }
+    BenchResult run_legacy_framing() {
+        return measure("legacy string::find", [this](BenchResult& result) {
+            size_t position = 0;
+            for (;;) {
+                size_t start_pos = corpus_.find("8=FIX", position);
+                if (start_pos == std::string::npos) break;
+                size_t checksum_pos = corpus_.find("10=", start_pos);
+                if (checksum_pos == std::string::npos) break;
+                size_t message_end = corpus_.find(FIX_SOH, checksum_pos + 3);
+                if (message_end == std::string::npos) break;
+                message_end += 1;
+                result.bytes += message_end - start_pos;
+                ++result.messages;
+                position = message_end;
+            }
+        });
+    }
+    BenchResult run_simd_framing() {
+        return measure("simd frame_fix_message", [this](BenchResult& result) {
+            size_t position = 0;
+            while (position < corpus_.size()) {
+                hft::fix::FixFrame frame = hft::fix::frame_fix_message(corpus_.data() + position,
+                                                                       corpus_.size() - position);
+                if (frame.status != hft::fix::FixFrameStatus::COMPLETE) break;
+                result.bytes += frame.length;
+                ++result.messages;
+                position += frame.start + frame.length;
+            }
+        });
+    }
+    BenchResult run_legacy_split() {
+        return measure("legacy substr split", [this](BenchResult& result) {
+            std::vector<size_t> field_positions;
+            for (const auto& span : spans_) {
+                const std::string message = corpus_.substr(span.first, span.second);
+                field_positions.clear();
+                for (size_t i = 0; i < message.size(); ++i) {
+                    if (message[i] == FIX_SOH) {
+                        field_positions.push_back(i);
+                    }
+                }
+                size_t start = 0;
+                for (size_t end_pos : field_positions) {
+                    const std::string field_str = message.substr(start, end_pos - start);
+                    const size_t equals_pos = field_str.find('=');
+                    if (equals_pos != std::string::npos && equals_pos > 0) {
+                        const uint32_t tag = static_cast<uint32_t>(std::stoul(field_str.substr(0, equals_pos)));
+                        const std::string value = field_str.substr(equals_pos + 1);
+                        result.sink += tag + value.size();
+                    }
+                    start = end_pos + 1;
+                }
+                result.bytes += span.second;
+                ++result.messages;
+            }
+        });
+    }
+    BenchResult run_simd_split() {
+        return measure("simd scan_fix_fields", [this](BenchResult& result) {
+            hft::fix::FixFieldRef fields[128];
+            for (const auto& span : spans_) {
+                const int count = hft::fix::scan_fix_fields(corpus_.data() + span.first, span.second, fields, 128);
+                for (int i = 0; i < count; ++i) {
+                    result.sink += fields[i].tag + fields[i].length;
+                }
+                result.bytes += span.second;
+                ++result.messages;
+            }
+        });
+    }
+    BenchResult run_legacy_decode() {
+        hft::fix::FixParser parser(1);
+        return measure("FixMessage string getters", [&](BenchResult& result) {
+            hft::fix::FixMessage message;
+            for (const auto& span : spans_) {
+                if (parser.parse_message(corpus_.substr(span.first, span.second), message) && message.msg_type == "D") {
+                    result.sink += std::stoull(message.get_field(hft::fix::Tags::CL_ORD_ID)) +
+                                   message.get_quantity(hft::fix::Tags::ORDER_QTY) +
+                                   static_cast<uint64_t>(message.get_price(hft::fix::Tags::PRICE) * 100.0 + 0.5) +
+                                   message.get_field(hft::fix::Tags::SYMBOL).size();
+                }
+                result.bytes += span.second;
+                ++result.messages;
+            }
+        });
+    }
+    BenchResult run_typed_decode() {
+        return measure("typed dictionary decode", [this](BenchResult& result) {
+            hft::fix::FixMessageView view;
+            hft::fix::NewOrderSingle order;
+            for (const auto& span : spans_) {
+                if (view.parse(corpus_.data() + span.first, span.second) &&
+                    hft::fix::classify_msg_type(view.msg_type()) == hft::fix::FixMsgType::NEW_ORDER_SINGLE &&
+                    hft::fix::decode_fix_message(view, order).ok()) {
+                    result.sink += order.cl_ord_id + order.order_qty +
+                                   static_cast<uint64_t>(order.price * 100.0 + 0.5) + order.symbol.size();
+                }
+                result.bytes += span.second;
+                ++result.messages;
+            }
+        });
+    }
+    BenchResult run_legacy_extractor() {
+        return measure("two-char prefix extractor", [this](BenchResult& result) {
+            std::vector<size_t> field_positions;
+            for (const auto& span : spans_) {
+                const char* data = corpus_.data() + span.first;
+                field_positions.clear();
+                for (size_t i = 0; i < span.second; ++i) {
+                    if (data[i] == FIX_SOH) {
+                        field_positions.push_back(i);
+                    }
+                }
+                uint64_t order_id = 0;
+                size_t symbol_length = 0;
+                double price = 0.0;
+                uint64_t quantity = 0;
+                size_t start = 0;
+                for (size_t end : field_positions) {
+                    if (end > start + 3) {
+                        if (data[start] == '1' && data[start + 1] == '1' && data[start + 2] == '=') {
+                            hft::core::parse_uint(data + start + 3, end - start - 3, order_id);
+                        } else if (data[start] == '5' && data[start + 1] == '5' && data[start + 2] == '=') {
+                            symbol_length = end - start - 3;
+                        } else if (data[start] == '4' && data[start + 1] == '4' && data[start + 2] == '=') {
+                            hft::core::parse_price(data + start + 3, end - start - 3, price);
+                        } else if (data[start] == '3' && data[start + 1] == '8' && data[start + 2] == '=') {
+                            hft::core::parse_uint(data + start + 3, end - start - 3, quantity);
+                        }
+                    }
+                    start = end + 1;
+                }
+                if (order_id != 0 && symbol_length != 0 && quantity != 0) {
+                    result.sink += order_id + quantity + static_cast<uint64_t>(price * 100.0 + 0.5) + symbol_length;
+                }
+                result.bytes += span.second;
+                ++result.messages;
+            }
+        });
+    }
+    BenchResult run_raw_decode() {
+        return measure("fused raw decode", [this](BenchResult& result) {
+            hft::fix::NewOrderSingle order;
+            for (const auto& span : spans_) {
+                if (hft::fix::decode_fix_message(corpus_.data() + span.first, span.second, order).ok()) {
+                    result.sink += order.cl_ord_id + order.order_qty +
+                                   static_cast<uint64_t>(order.price * 100.0 + 0.5) + order.symbol.size();
+                }
+                result.bytes += span.second;
+                ++result.messages;
+            }
+        });
+    }
+    uint64_t fuzz_order_decoder() const {
+        static const char* confusable_fields[] = {"110=77\x01", "1=ACCT\x01", "111=5\x01", "550=ZZZZ\x01",
+                                                  "5=x\x01", "380=9\x01", "0011=42\x01", "4=1\x01"};
+        static const char mutation_bytes[] = "0123456789=\x01" "ADx.";
+        std::mt19937_64 rng(11);
+        hft::fix::FixMessageView view;
+        hft::fix::NewOrderSingle raw;
+        hft::fix::NewOrderSingle typed;
+        std::string message;
+        uint64_t mismatches = 0;
+        for (size_t i = 0; i < DECODER_FUZZ_CASES && !spans_.empty(); ++i) {
+            const size_t index = rng() % spans_.size();
+            message.assign(corpus_, spans_[index].first, spans_[index].second);
+            const unsigned mutation = static_cast<unsigned>(rng() % 5);
+            if (mutation == 1) {
+                message[rng() % message.size()] = mutation_bytes[rng() % (sizeof(mutation_bytes) - 1)];
+            } else if (mutation == 2) {
+                const size_t boundary = message.find(FIX_SOH, rng() % message.size());
+                message.insert(boundary == std::string::npos ? message.size() : boundary + 1,
+                               confusable_fields[rng() % 8]);
+            } else if (mutation == 3) {
+                message.resize(rng() % message.size());
+            } else if (mutation == 4) {
+                const size_t start = message.rfind(FIX_SOH, rng() % message.size());
+                const size_t field_start = start == std::string::npos ? 0 : start + 1;
+                const size_t field_end = message.find(FIX_SOH, field_start);
+                if (field_end != std::string::npos) {
+                    message.insert(field_end + 1, message.substr(field_start, field_end + 1 - field_start));
+                }
+            }
+            const bool raw_ok = hft::fix::decode_fix_message(message.data(), message.size(), raw).ok();
+            const bool typed_ok = view.parse(message) && hft::fix::decode_fix_message(view, typed).ok();
+            if (raw_ok != typed_ok) {
+                ++mismatches;
+                continue;
+            }
+            if (raw_ok) {
+                mismatches += raw.cl_ord_id != typed.cl_ord_id || raw.symbol != typed.symbol || raw.side != typed.side ||
+                              raw.order_qty != typed.order_qty || raw.ord_type != typed.ord_type ||
+                              raw.price != typed.price || raw.time_in_force != typed.time_in_force ||
+                              raw.transact_time != typed.transact_time;
+                mismatches += mutation == 2 && raw.cl_ord_id != 1000000 + index;
+            }
+        }
+        return mismatches;
+    }
+    BenchResult run_legacy_encode() {
+        return measure("legacy string append", [this](BenchResult& result) {
+            std::string exec_report;
+            for (size_t i = 0; i < spans_.size(); ++i) {
+                exec_report.clear();
+                exec_report.reserve(512);
+                exec_report = "8=FIX.4.4\x01";
+                exec_report += "35=8\x01";
+                exec_report += "49=HFT_ENGINE\x01";
+                exec_report += "56=CLIENT\x01";
+                exec_report += "34=" + std::to_string(i + 1) + "\x01";
+                exec_report += "52=" + std::to_string(std::chrono::system_clock::now().time_since_epoch().count()) + "\x01";
+                exec_report += "37=" + std::to_string(1000000 + i) + "\x01";
+                exec_report += "11=" + std::to_string(1000000 + i) + "\x01";
+                exec_report += "17=" + std::to_string(i) + "\x01";
+                exec_report += std::string("150=") + ((i & 1) ? "F" : "0") + "\x01";
+                exec_report += std::string("39=") + ((i & 1) ? "2" : "0") + "\x01";
+                exec_report += std::string("54=") + ((i & 1) ? "1" : "2") + "\x01";
+                result.bytes += exec_report.size();
+                result.sink += static_cast<uint8_t>(exec_report.back());
+                ++result.messages;
+            }
+        });
+    }
+    BenchResult run_template_encode() {
+        hft::fix::FixMessageEncoder encoder("HFT_ENGINE", "CLIENT");
+        uint64_t invalid = 0;
+        BenchResult result = measure("template encoder", [&](BenchResult& result) {
+            hft::fix::ExecutionReport fields{};
+            fields.symbol = "AAPL";
+            fields.side = '1';
+            for (size_t i = 0; i < spans_.size(); ++i) {
+                const auto now = std::chrono::system_clock::now().time_since_epoch();
+                fields.order_id = 1000000 + i;
+                fields.cl_ord_id = 1000000 + i;
+                fields.exec_id = i;
+                fields.exec_type = (i & 1) ? 'F' : '0';
+                fields.ord_status = (i & 1) ? '2' : '0';
+                fields.order_qty = 100 + (i & 1023);
+                fields.price = 150.25 + static_cast<double>(i & 255) * 0.01;
+                fields.last_qty = fields.order_qty;
+                fields.last_px = fields.price;
+                fields.cum_qty = fields.order_qty;
+                fields.avg_px = fields.price;
+                std::string_view encoded = encoder.encode(fields, static_cast<uint32_t>(i + 1),
+                    static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(now).count()));
+                if ((i & 4095) == 0 &&
+                    hft::fix::frame_fix_message(encoded.data(), encoded.size()).status != hft::fix::FixFrameStatus::COMPLETE) {
+                    ++invalid;
+                }
+                result.bytes += encoded.size();
+                result.sink += static_cast<uint8_t>(encoded.back());
+                ++result.messages;
+            }
+        });
+        if (invalid != 0) {
+            std::cout << "WARNING: " << invalid << " encoded reports failed framing validation" << std::endl;
+        }
+        return result;
+    }
+    static uint64_t price_bits(double value) {
+        uint64_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        return bits;
+    }
+    BenchResult run_legacy_numeric_parse() {
+        return measure("std::stoull / std::stod", [this](BenchResult& result) {
+            for (size_t i = 0; i < numeric_fields_.size(); i += 2) {
+                result.sink += std::stoull(numeric_fields_[i]) + price_bits(std::stod(numeric_fields_[i + 1]));
+                result.bytes += numeric_fields_[i].size() + numeric_fields_[i + 1].size();
+                result.messages += 2;
+            }
+        });
+    }
+    BenchResult run_kernel_numeric_parse() {
+        return measure("swar parse_uint / price", [this](BenchResult& result) {
+            for (size_t i = 0; i < numeric_fields_.size(); i += 2) {
+                const std::string& quantity_text = numeric_fields_[i];
+                const std::string& price_text = numeric_fields_[i + 1];
+                uint64_t quantity = 0;
+                double price = 0.0;
+                hft::core::parse_uint(quantity_text.data(), quantity_text.size(), quantity);
+                hft::core::parse_price(price_text.data(), price_text.size(), price);
+                result.sink += quantity + price_bits(price);
+                result.bytes += quantity_text.size() + price_text.size();
+                result.messages += 2;
+            }
+        });
+    }
+    BenchResult run_legacy_numeric_format() {
+        return measure("snprintf / to_string", [this](BenchResult& result) {
+            char text[64];
+            for (size_t i = 0; i < price_values_.size(); ++i) {
+                const int length = std::snprintf(text, sizeof(text), "%.4f", price_values_[i]);
+                const std::string quantity = std::to_string(1000000 + i);
+                result.sink += static_cast<uint8_t>(text[length - 1]) + static_cast<uint8_t>(quantity.back());
+                result.bytes += static_cast<size_t>(length) + quantity.size();
+                result.messages += 2;
+            }
+        });
+    }
+    BenchResult run_kernel_numeric_format() {
+        return measure("format_fixed / format_uint", [this](BenchResult& result) {
+            char text[hft::core::MAX_FIXED_LENGTH];
+            char quantity[hft::core::MAX_UINT_DIGITS];
+            for (size_t i = 0; i < price_values_.size(); ++i) {
+                const char* price_end = hft::core::format_fixed<4>(text, price_values_[i]);
+                const char* quantity_end = hft::core::format_uint(quantity, 1000000 + i);
+                result.sink += static_cast<uint8_t>(price_end[-1]) + static_cast<uint8_t>(quantity_end[-1]);
+                result.bytes += static_cast<size_t>(price_end - text) + static_cast<size_t>(quantity_end - quantity);
+                result.messages += 2;
+            }
+        });
+    }
+    static uint64_t fuzz_numeric_kernels() {
+        std::mt19937_64 rng(7);
+        uint64_t mismatches = 0;
+        char text[64];
+        char reference[64];
+        for (size_t i = 0; i < NUMERIC_FUZZ_CASES; ++i) {
+            const uint64_t integer = rng() >> (rng() % 64);
+            const char* end = hft::core::format_uint(text, integer);
+            uint64_t parsed_integer = 0;
+            mismatches += !hft::core::parse_uint(text, static_cast<size_t>(end - text), parsed_integer) ||
+                          parsed_integer != integer ||
+                          std::string_view(text, static_cast<size_t>(end - text)) != std::to_string(integer);
+            const int decimals = static_cast<int>(rng() % 9);
+            const double price = static_cast<double>(rng() % 10000000000ull) /
+                                 hft::core::EXACT_POWERS_OF_TEN[rng() % 9] * ((rng() & 1) ? 1.0 : -1.0);
+            const int length = std::snprintf(reference, sizeof(reference), "%.*f", decimals, price);
+            double kernel_price = 0.0;
+            double reference_price = 0.0;
+            hft::core::parse_price(reference, static_cast<size_t>(length), kernel_price);
+            std::from_chars(reference, reference + length, reference_price);
+            mismatches += kernel_price != reference_price;
+            int64_t scaled = 0;
+            int64_t reference_scaled = 0;
+            end = hft::core::format_fixed(text, kernel_price, decimals);
+            const int reference_length = std::snprintf(reference, sizeof(reference), "%.*f", decimals, kernel_price);
+            mismatches += !hft::core::parse_fixed(text, static_cast<size_t>(end - text), decimals, scaled) ||
+                          !hft::core::parse_fixed(reference, static_cast<size_t>(reference_length), decimals,
+                                                  reference_scaled) ||
+                          std::abs(scaled - reference_scaled) > 1;
+            if (rng() % 4 == 0) {
+                text[rng() % static_cast<size_t>(end - text)] = "x.-+e:/"[rng() % 7];
+                mismatches += hft::core::parse_uint(text, static_cast<size_t>(end - text), parsed_integer) &&
+                              std::from_chars(text, end, parsed_integer).ec != std::errc();
+            }
+        }
+        return mismatches;
+    }
+    template <typename Parser>
+    void feed_corpus(Parser& parser) {
+        for (size_t offset = 0; offset < corpus_.size(); offset += FEED_CHUNK_SIZE) {
+            parser.feed_data(corpus_.data() + offset, std::min(FEED_CHUNK_SIZE, corpus_.size() - offset));
+        }
+    }
+    BenchResult run_queued_pipeline() {
+        return measure("queued workers", [this](BenchResult& result) {
+            hft::fix::FixParser parser(4);
+            std::atomic<uint64_t> delivered{0};
+            parser.set_message_callback([&delivered](hft::fix::FixSessionId, const hft::fix::FixMessage&) {
+                delivered.fetch_add(1, std::memory_order_relaxed);
+            });
+            parser.start();
+            feed_corpus(parser);
+            const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+            while (delivered.load() + parser.get_stats().messages_dropped.load() +
+                   parser.get_stats().parse_errors.load() < spans_.size() &&
+                   std::chrono::steady_clock::now() < deadline) {
+                std::this_thread::yield();
+            }
+            parser.stop();
+            result.messages += delivered.load();
+            result.bytes += corpus_.size();
+        });
+    }
+    BenchResult run_inline_pipeline() {
+        return measure("inline handler", [this](BenchResult& result) {
+            hft::fix::FixParser parser(1);
+            CountingHandler handler;
+            parser.set_inline_handler(&handler);
+            parser.start();
+            feed_corpus(parser);
+            parser.stop();
+            result.messages += handler.messages;
+            result.bytes += corpus_.size();
+        });
+    }
+    template <typename Feed>
+    size_t feed_split_reads(Feed&& feed) {
+        size_t offset = 0;
+        for (size_t read : split_reads_) {
+            feed(corpus_.data() + offset, read);
+            offset += read;
+        }
+        return offset;
+    }
+    static size_t dispatch_frames(hft::fix::FixMessageView& view, const char* data, size_t length, size_t& pending,
+                                  uint64_t& messages) {
+        size_t position = 0;
+        pending = 0;
+        while (position < length) {
+            const hft::fix::FixFrame frame = hft::fix::frame_fix_message(data + position, length - position);
+            if (frame.status == hft::fix::FixFrameStatus::INCOMPLETE) {
+                pending = frame.length;
+                return position + frame.start;
+            }
+            if (frame.status == hft::fix::FixFrameStatus::INVALID) {
+                position += frame.start + 1;
+                continue;
+            }
+            if (frame.status == hft::fix::FixFrameStatus::COMPLETE &&
+                view.parse(data + position + frame.start, frame.length)) {
+                ++messages;
+            }
+            position += frame.start + frame.length;
+        }
+        return position;
+    }
+    BenchResult run_string_buffer_feed() {
+        return measure("string append + erase", [this](BenchResult& result) {
+            hft::fix::FixMessageView view;
+            std::string buffer;
+            buffer.reserve(hft::fix::MAX_FIX_MESSAGE_SIZE);
+            size_t position = 0;
+            size_t pending = 0;
+            result.bytes += feed_split_reads([&](const char* data, size_t length) {
+                if (position == buffer.size()) {
+                    buffer.clear();
+                    position = 0;
+                    const size_t consumed = dispatch_frames(view, data, length, pending, result.messages);
+                    buffer.append(data + consumed, length - consumed);
+                    return;
+                }
+                buffer.append(data, length);
+                position += dispatch_frames(view, buffer.data() + position, buffer.size() - position, pending,
+                                            result.messages);
+                if (position == buffer.size()) {
+                    buffer.clear();
+                    position = 0;
+                } else if (position > 1024 && position > buffer.size() / 2) {
+                    buffer.erase(0, position);
+                    position = 0;
+                }
+            });
+        });
+    }
+    BenchResult run_ring_buffer_feed() {
+        return measure("mirrored ring buffer", [this](BenchResult& result) {
+            hft::fix::FixMessageView view;
+            hft::core::MirroredRingBuffer buffer;
+            buffer.open(hft::fix::FIX_SESSION_BUFFER_SIZE);
+            size_t pending = 0;
+            result.bytes += feed_split_reads([&](const char* data, size_t length) {
+                while (!buffer.empty()) {
+                    if (length == 0) {
+                        return;
+                    }
+                    const size_t wanted = pending > buffer.size() ? pending - buffer.size() : length;
+                    const size_t copied = buffer.append(data, std::min(wanted, length));
+                    data += copied;
+                    length -= copied;
+                    if (buffer.size() < pending) {
+                        continue;
+                    }
+                    buffer.consume(dispatch_frames(view, buffer.read_ptr(), buffer.size(), pending, result.messages));
+                }
+                const size_t consumed = dispatch_frames(view, data, length, pending, result.messages);
+                buffer.append(data + consumed, length - consumed);
+            });
+        });
+    }
+    BenchResult run_session_split_feed() {
+        return measure("FixParser inline session", [this](BenchResult& result) {
+            hft::fix::FixParser parser(1);
+            CountingHandler handler;
+            parser.set_inline_handler(&handler);
+            parser.start();
+            result.bytes += feed_split_reads([&parser](const char* data, size_t length) {
+                parser.feed_data(data, length);
+            });
+            parser.stop();
+            result.messages += handler.messages;
+        });
+    }
+    template <typename Parser>
+    void feed_mixed_corpus(Parser& parser) {
+        for (size_t offset = 0; offset < mixed_corpus_.size(); offset += FEED_CHUNK_SIZE) {
+            parser.feed_data(mixed_corpus_.data() + offset, std::min(FEED_CHUNK_SIZE, mixed_corpus_.size() - offset));
+        }
+    }
+    static uint64_t decode_typed(const hft::fix::FixMessageView& view) {
+        const std::string_view msg_type = view.msg_type();
+        if (msg_type == "D") {
+            hft::fix::NewOrderSingle order;
+            return hft::fix::decode_fix_message(view, order).ok() ? order.order_qty : 0;
+        }
+        if (msg_type == "F") {
+            hft::fix::OrderCancelRequest cancel;
+            return hft::fix::decode_fix_message(view, cancel).ok() ? cancel.order_qty : 0;
+        }
+        if (msg_type == "8") {
+            hft::fix::ExecutionReport report;
+            return hft::fix::decode_fix_message(view, report).ok() ? report.order_qty : 0;
+        }
+        return 0;
+    }
+    bool run_parse_paths() {
+        const size_t message_count = mixed_spans_.size();
+        std::vector<PathResult> paths;
+        hft::fix::FixParser string_parser(1);
+        paths.push_back(profile("parse_message", [&](BenchResult& result) {
+            hft::fix::FixMessage message;
+            std::string raw;
+            for (const auto& span : mixed_spans_) {
+                raw.assign(mixed_corpus_, span.first, span.second);
+                if (string_parser.parse_message(raw, message)) {
+                    result.sink += message.get_quantity(hft::fix::Tags::ORDER_QTY);
+                    ++result.messages;
+                }
+                result.bytes += span.second;
+            }
+        }));
+        paths.push_back(profile("queued workers", [&](BenchResult& result) {
+            hft::fix::FixParser parser(4);
+            std::atomic<uint64_t> delivered{0};
+            parser.set_message_callback([&delivered](hft::fix::FixSessionId, const hft::fix::FixMessage&) {
+                delivered.fetch_add(1, std::memory_order_relaxed);
+            });
+            parser.start();
+            feed_mixed_corpus(parser);
+            const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+            while (delivered.load() + parser.get_stats().messages_dropped.load() +
+                   parser.get_stats().parse_errors.load() < message_count &&
+                   std::chrono::steady_clock::now() < deadline) {
+                std::this_thread::yield();
+            }
+            parser.stop();
+            result.messages += delivered.load();
+            result.bytes += mixed_corpus_.size();
+        }));
+        paths.push_back(profile("inline view handler", [&](BenchResult& result) {
+            hft::fix::FixParser parser(1);
+            CountingHandler handler;
+            parser.set_inline_handler(&handler);
+            parser.start();
+            feed_mixed_corpus(parser);
+            parser.stop();
+            result.messages += handler.messages;
+            result.bytes += mixed_corpus_.size();
+        }));
+        paths.push_back(profile("view + typed decode", [&](BenchResult& result) {
+            hft::fix::FixMessageView view;
+            for (const auto& span : mixed_spans_) {
+                if (view.parse(mixed_corpus_.data() + span.first, span.second)) {
+                    const uint64_t decoded = decode_typed(view);
+                    result.sink += decoded;
+                    result.messages += decoded != 0;
+                }
+                result.bytes += span.second;
+            }
+        }));
+        std::cout << "\nParse paths (" << message_count << " mixed D/F/8 messages)" << std::endl;
+        bool consistent = true;
+        for (const PathResult& path : paths) {
+            const BenchResult& result = path.bench;
+            const double per_message = result.messages ? 1.0 / result.messages : 0.0;
+            std::cout << "  " << std::left << std::setw(26) << result.name << std::right << std::fixed
+                      << std::setprecision(2) << std::setw(8)
+                      << (result.seconds > 0.0 ? result.messages / result.seconds / 1e6 : 0.0) << " M msg/s"
+                      << std::setprecision(1) << std::setw(9) << result.seconds * 1e9 * per_message << " ns/msg"
+                      << std::setprecision(2) << std::setw(8) << path.allocations * per_message << " allocs/msg";
+            if (path.cache_misses >= 0) {
+                std::cout << std::setw(8) << path.cache_misses * per_message << " misses/msg";
+            } else {
+                std::cout << "     n/a misses/msg";
+            }
+            std::cout << std::endl;
+            consistent &= result.messages == message_count * iterations_;
+        }
+        return consistent && paths[0].bench.sink == paths[3].bench.sink;
+    }
+    ScalingResult run_sessions(size_t workers, const std::vector<std::string>& streams) {
+        hft::fix::FixParser parser(workers);
+        std::vector<hft::fix::FixSessionId> sessions;
+        sessions.reserve(streams.size());
+        for (size_t i = 0; i < streams.size(); ++i) {
+            sessions.push_back(parser.open_session());
+        }
+        parser.set_message_callback([](hft::fix::FixSessionId, const hft::fix::FixMessage&) {});
+        parser.start();
+        const size_t feeders = std::max(size_t(1), workers / 4);
+        const auto start = std::chrono::steady_clock::now();
+        std::vector<std::thread> feeder_threads;
+        for (size_t f = 0; f < feeders; ++f) {
+            feeder_threads.emplace_back([&, f]() {
+                bool pending = true;
+                for (size_t offset = 0; pending; offset += FEED_CHUNK_SIZE) {
+                    pending = false;
+                    for (size_t s = f; s < streams.size(); s += feeders) {
+                        if (offset < streams[s].size()) {
+                            parser.feed_data(sessions[s], streams[s].data() + offset,
+                                             std::min(FEED_CHUNK_SIZE, streams[s].size() - offset));
+                            pending = true;
+                        }
+                    }
+                }
+            });
+        }
+        for (auto& thread : feeder_threads) {
+            thread.join();
+        }
+        const auto& stats = parser.get_stats();
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(30);
+        while (stats.messages_parsed.load() + stats.parse_errors.load() + stats.messages_dropped.load() < spans_.size() &&
+               std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::yield();
+        }
+        const auto end = std::chrono::steady_clock::now();
+        const uint64_t parsed = stats.messages_parsed.load();
+        parser.stop();
+        return ScalingResult{workers, feeders, std::chrono::duration<double>(end - start).count(), parsed};
+    }
+    void run_session_scaling() {
+        std::vector<std::string> streams(SCALING_SESSIONS);
+        for (size_t i = 0; i < spans_.size(); ++i) {
+            streams[i % SCALING_SESSIONS].append(corpus_, spans_[i].first, spans_[i].second);
+        }
+        const size_t cores = std::max(1u, std::thread::hardware_concurrency());
+        std::vector<size_t> worker_counts;
+        for (size_t workers = 1; workers < cores; workers *= 2) {
+            worker_counts.push_back(workers);
+        }
+        worker_counts.push_back(cores);
+        std::cout << "\nSession sharding (" << SCALING_SESSIONS << " sessions, " << cores << " cores)" << std::endl;
+        double baseline_rate = 0.0;
+        for (size_t workers : worker_counts) {
+            ScalingResult result = run_sessions(workers, streams);
+            const double rate = result.seconds > 0.0 ? result.messages / result.seconds : 0.0;
+            if (baseline_rate == 0.0) {
+                baseline_rate = rate;
+            }
+            std::cout << "  workers " << std::setw(3) << result.workers
+                      << "  feeders " << std::setw(2) << result.feeders
+                      << std::fixed << std::setprecision(2)
+                      << std::setw(9) << rate / 1e6 << " M msg/s"
+                      << "  scaling " << (baseline_rate > 0.0 ? rate / baseline_rate : 0.0) << "x";
+            if (result.messages != spans_.size()) {
+                std::cout << "  (" << spans_.size() - result.messages << " not parsed)";
+            }
+            std::cout << std::endl;
+        }
+    }
+    bool run_drop_copy() {
+        hft::fix::FixDropCopyConfig config;
+        config.directory = (std::filesystem::temp_directory_path() / "fix_bench_dropcopy").string();
+        config.prefix = "bench";
+        config.segment_size = DROP_COPY_SEGMENT_SIZE;
+        std::filesystem::remove_all(config.directory);
+        std::cout << "\nDrop-copy log (" << DROP_COPY_SEGMENT_SIZE / (1024 * 1024) << " MB segments)" << std::endl;
+        std::vector<uint64_t> ingress_ns(spans_.size());
+        hft::fix::FixDropCopyLog log(config);
+        if (!log.open()) {
+            return false;
+        }
+        const auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < spans_.size(); ++i) {
+            const auto append_start = std::chrono::steady_clock::now();
+            log.append(i & 1 ? hft::fix::FixDropCopyDirection::OUTBOUND : hft::fix::FixDropCopyDirection::INBOUND,
+                       static_cast<uint32_t>(i % SCALING_SESSIONS), corpus_.data() + spans_[i].first,
+                       spans_[i].second, i);
+            ingress_ns[i] = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - append_start).count());
+        }
+        const auto end = std::chrono::steady_clock::now();
+        log.close();
+        const auto& stats = log.get_stats();
+        const double seconds = std::chrono::duration<double>(end - start).count();
+        uint64_t records_read = 0;
+        uint64_t mismatches = 0;
+        size_t found = 0;
+        const std::string probe = std::to_string(1000000 + spans_.size() / 2);
+        hft::fix::FixDropCopyReader reader;
+        hft::fix::FixDropCopyRecord record;
+        std::vector<hft::fix::FixDropCopyRecord> matches;
+        for (uint32_t segment = 0;
+             std::filesystem::exists(log.segment_path(segment)) && reader.open(log.segment_path(segment)); ++segment) {
+            while (reader.next(record)) {
+                mismatches += record.timestamp_ns != records_read ||
+                              record.data != std::string_view(corpus_.data() + spans_[records_read].first,
+                                                              spans_[records_read].second);
+                ++records_read;
+            }
+            found += reader.find(probe, matches);
+        }
+        std::filesystem::remove_all(config.directory);
+        std::sort(ingress_ns.begin(), ingress_ns.end());
+        std::cout << "  append          " << std::fixed << std::setprecision(1) << std::setw(10)
+                  << (spans_.empty() ? 0.0 : seconds * 1e9 / spans_.size()) << " ns/record  "
+                  << std::setprecision(3) << (seconds > 0.0 ? stats.bytes_written.load() / seconds / 1e9 : 0.0)
+                  << " GB/s" << std::endl;
+        if (!ingress_ns.empty()) {
+            std::cout << "  ingress latency " << std::setw(10) << ingress_ns[ingress_ns.size() / 2] << " ns p50  "
+                      << ingress_ns[ingress_ns.size() * 99 / 100] << " ns p99  "
+                      << ingress_ns[ingress_ns.size() * 999 / 1000] << " ns p99.9  " << ingress_ns.back()
+                      << " ns max" << std::endl;
+        }
+        std::cout << "  segments rolled " << std::setw(10) << stats.segments_rolled.load() << "  writer creates "
+                  << stats.writer_segment_creates.load() << "  ingress stalls " << stats.ingress_stalls.load()
+                  << "  doorbell rings " << stats.doorbell_rings.load() << "  syncs " << stats.syncs.load() << std::endl;
+        std::cout << "  read back       " << std::setw(10) << records_read << "  mismatches " << mismatches
+                  << "  indexed " << stats.records_indexed.load() << "  ClOrdID " << probe << " found " << found
+                  << std::endl;
+        const bool concurrent_ok = run_drop_copy_producers(config);
+        return records_read == spans_.size() && mismatches == 0 && stats.records_dropped.load() == 0 &&
+               stats.records_indexed.load() == spans_.size() && found == 1 && concurrent_ok;
+    }
+    bool run_drop_copy_producers(const hft::fix::FixDropCopyConfig& config) {
+        std::filesystem::remove_all(config.directory);
+        hft::fix::FixDropCopyLog log(config);
+        if (!log.open()) {
+            return false;
+        }
+        std::vector<std::thread> producers;
+        const auto start = std::chrono::steady_clock::now();
+        for (size_t producer = 0; producer < DROP_COPY_PRODUCERS; ++producer) {
+            producers.emplace_back([this, &log, producer]() {
+                for (size_t i = 0; i < spans_.size(); ++i) {
+                    log.append(hft::fix::FixDropCopyDirection::OUTBOUND, static_cast<uint32_t>(producer),
+                               corpus_.data() + spans_[i].first, spans_[i].second,
+                               (uint64_t(producer) << DROP_COPY_PRODUCER_SHIFT) | i);
+                }
+            });
+        }
+        for (auto& thread : producers) {
+            thread.join();
+        }
+        const auto end = std::chrono::steady_clock::now();
+        log.close();
+        const auto& stats = log.get_stats();
+        const double seconds = std::chrono::duration<double>(end - start).count();
+        std::vector<uint64_t> next_sequence(DROP_COPY_PRODUCERS, 0);
+        uint64_t records_read = 0;
+        uint64_t mismatches = 0;
+        hft::fix::FixDropCopyReader reader;
+        hft::fix::FixDropCopyRecord record;
+        for (uint32_t segment = 0;
+             std::filesystem::exists(log.segment_path(segment)) && reader.open(log.segment_path(segment)); ++segment) {
+            while (reader.next(record)) {
+                const uint64_t producer = record.timestamp_ns >> DROP_COPY_PRODUCER_SHIFT;
+                const uint64_t sequence = record.timestamp_ns & ((uint64_t(1) << DROP_COPY_PRODUCER_SHIFT) - 1);
+                const bool valid = producer < DROP_COPY_PRODUCERS && record.session == producer &&
+                                   sequence == next_sequence[producer] && sequence < spans_.size() &&
+                                   record.data == std::string_view(corpus_.data() + spans_[sequence].first,
+                                                                   spans_[sequence].second);
+                mismatches += !valid;
+                if (valid) {
+                    ++next_sequence[producer];
+                }
+                ++records_read;
+            }
+        }
+        std::filesystem::remove_all(config.directory);
+        const uint64_t expected = static_cast<uint64_t>(spans_.size()) * DROP_COPY_PRODUCERS;
+        std::cout << "  " << DROP_COPY_PRODUCERS << " producers     " << std::fixed << std::setprecision(2)
+                  << std::setw(10) << (seconds > 0.0 ? records_read / seconds / 1e6 : 0.0) << " M rec/s  read back "
+                  << records_read << "  mismatches " << mismatches << "  ingress stalls "
+                  << stats.ingress_stalls.load() << "  doorbell rings " << stats.doorbell_rings.load() << std::endl;
+        return records_read == expected && mismatches == 0 && stats.records_dropped.load() == 0;
+    }
+    static double gigabytes_per_second(const BenchResult& result) {
+        return result.seconds > 0.0 ? static_cast<double>(result.bytes) / result.seconds / 1e9 : 0.0;
+    }
+    static void print_result(const BenchResult& result) {
+        const double messages_per_sec = result.seconds > 0.0 ? result.messages / result.seconds : 0.0;
+        std::cout << "  " << std::left << std::setw(26) << result.name << std::right
+                  << std::fixed << std::setprecision(3) << std::setw(9) << gigabytes_per_second(result) << " GB/s  "
+                  << std::setprecision(2) << std::setw(8) << messages_per_sec / 1e6 << " M msg/s" << std::endl;
+    }
+    static void print_encode_result(const BenchResult& result) {
+        const double ns_per_message = result.messages ? result.seconds * 1e9 / result.messages : 0.0;
+        std::cout << "  " << std::left << std::setw(26) << result.name << std::right
+                  << std::fixed << std::setprecision(1) << std::setw(9) << ns_per_message << " ns/report  "
+                  << std::setprecision(3) << gigabytes_per_second(result) << " GB/s" << std::endl;
+    }
+    static void print_speedup(const BenchResult& baseline, const BenchResult& candidate) {
+        const double baseline_rate = baseline.seconds > 0.0 ? baseline.messages / baseline.seconds : 0.0;
+        if (baseline_rate > 0.0 && candidate.seconds > 0.0) {
+            std::cout << "  speedup: " << std::fixed << std::setprecision(2)
+                      << candidate.messages / candidate.seconds / baseline_rate << "x" << std::endl;
+        }
+    }
+};
+int main(int argc, char* argv[]) {
+    try {
+        const size_t message_count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 100000;
+        const size_t iterations = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 20;
+        FixScanBenchmark benchmark(message_count, iterations);
+        benchmark.run();
+        return 0;
+    } catch (const std::exception& e) {
+        std::cout << "❌ Error: " << e.what() << std::endl;
+        return 1;
+    }
+}
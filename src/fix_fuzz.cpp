@@ -0,0 +1,272 @@
+#include "hft/fix/fix_parser.hpp"
+#include "hft/fix/fix_scanner.hpp"
+#include "hft/fix/fix_message_view.hpp"
+#include "hft/fix/fix_dictionary.hpp"
+#include "hft/fix/fix_encoder.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <string>
+#include <vector>
+namespace {
+class RecordingHandler : public hft::fix::FixMessageHandler {
+public:
+    std::string log;
+    void on_message(hft::fix::FixSessionId, const hft::fix::FixMessageView& message) override {
+        log += 'M';
+        log.append(message.data(), message.size());
+    }
+    void on_reject(hft::fix::FixFrameStatus status, const char* data, size_t length) override {
+        log += static_cast<char>('0' + static_cast<int>(status));
+        log.append(data, length);
+    }
+};
+class StreamingParser {
+private:
+    hft::fix::FixParser parser_;
+    RecordingHandler handler_;
+public:
+    StreamingParser() : parser_(1) {
+        parser_.set_inline_handler(&handler_);
+    }
+    const std::string& replay(const char* data, size_t length, const std::vector<size_t>& reads) {
+        handler_.log.clear();
+        parser_.start();
+        size_t offset = 0;
+        for (size_t read : reads) {
+            read = std::min(read, length - offset);
+            parser_.feed_data(data + offset, read);
+            offset += read;
+        }
+        parser_.feed_data(data + offset, length - offset);
+        parser_.stop();
+        return handler_.log;
+    }
+};
+[[noreturn]] void fail(const char* invariant, const char* data, size_t length) {
+    std::cerr << "FIX fuzz invariant violated: " << invariant << " (" << length << " byte input)" << std::endl;
+    std::fwrite(data, 1, std::min<size_t>(length, 512), stderr);
+    std::cerr << std::endl;
+    std::abort();
+}
+bool same(const hft::fix::NewOrderSingle& a, const hft::fix::NewOrderSingle& b) {
+    return a.cl_ord_id == b.cl_ord_id && a.symbol == b.symbol && a.side == b.side && a.order_qty == b.order_qty &&
+           a.ord_type == b.ord_type && a.price == b.price && a.time_in_force == b.time_in_force &&
+           a.transact_time == b.transact_time;
+}
+bool same(const hft::fix::OrderCancelRequest& a, const hft::fix::OrderCancelRequest& b) {
+    return a.orig_cl_ord_id == b.orig_cl_ord_id && a.cl_ord_id == b.cl_ord_id && a.order_id == b.order_id &&
+           a.symbol == b.symbol && a.side == b.side && a.order_qty == b.order_qty &&
+           a.transact_time == b.transact_time;
+}
+bool same(const hft::fix::ExecutionReport& a, const hft::fix::ExecutionReport& b) {
+    return a.order_id == b.order_id && a.cl_ord_id == b.cl_ord_id && a.exec_id == b.exec_id &&
+           a.exec_type == b.exec_type && a.ord_status == b.ord_status && a.symbol == b.symbol && a.side == b.side &&
+           a.order_qty == b.order_qty && a.price == b.price && a.last_qty == b.last_qty && a.last_px == b.last_px &&
+           a.leaves_qty == b.leaves_qty && a.cum_qty == b.cum_qty && a.avg_px == b.avg_px;
+}
+template<typename Message>
+void check_decoders(const char* data, size_t length, const hft::fix::FixMessageView* view) {
+    Message raw{};
+    Message typed{};
+    const bool raw_ok = hft::fix::decode_fix_message(data, length, raw).ok();
+    const bool typed_ok = view && hft::fix::decode_fix_message(*view, typed).ok();
+    if (raw_ok != typed_ok || (raw_ok && !same(raw, typed))) {
+        fail("raw and view decoders disagree", data, length);
+    }
+}
+void check_frame(const char* data, size_t length) {
+    const hft::fix::FixFrame frame = hft::fix::frame_fix_message(data, length);
+    switch (frame.status) {
+        case hft::fix::FixFrameStatus::COMPLETE:
+        case hft::fix::FixFrameStatus::BAD_CHECKSUM:
+            if (frame.length == 0 || frame.start + frame.length > length ||
+                frame.length > hft::fix::MAX_FIX_MESSAGE_SIZE) {
+                fail("complete frame exceeds input", data, length);
+            }
+            break;
+        case hft::fix::FixFrameStatus::INCOMPLETE:
+            if (frame.start > length || (frame.length != 0 && frame.start + frame.length <= length)) {
+                fail("incomplete frame inconsistent with input", data, length);
+            }
+            break;
+        case hft::fix::FixFrameStatus::INVALID:
+            if (frame.start >= length) {
+                fail("invalid frame outside input", data, length);
+            }
+            break;
+    }
+}
+void check_input(const char* data, size_t length) {
+    static hft::fix::FixParser string_parser(1);
+    static hft::fix::FixMessageView view;
+    static StreamingParser whole;
+    static StreamingParser split;
+    check_frame(data, length);
+    hft::fix::FixFieldRef fields[hft::fix::FixMessageView::MAX_FIELDS];
+    const int count = hft::fix::scan_fix_fields(data, length, fields, hft::fix::FixMessageView::MAX_FIELDS);
+    for (int i = 0; i < count; ++i) {
+        if (fields[i].tag == 0 || static_cast<size_t>(fields[i].offset) + fields[i].length > length) {
+            fail("scanned field outside input", data, length);
+        }
+    }
+    const bool parsed = view.parse(data, length);
+    if (parsed && (count < 0 || view.field_count() != static_cast<size_t>(count))) {
+        fail("view and scanner field counts disagree", data, length);
+    }
+    const hft::fix::FixMessageView* parsed_view = parsed ? &view : nullptr;
+    check_decoders<hft::fix::NewOrderSingle>(data, length, parsed_view);
+    check_decoders<hft::fix::OrderCancelRequest>(data, length, parsed_view);
+    check_decoders<hft::fix::ExecutionReport>(data, length, parsed_view);
+    hft::fix::FixMessage message;
+    if (string_parser.parse_message(std::string(data, length), message) &&
+        hft::fix::frame_fix_message(data, length).length != length) {
+        fail("parse_message accepted a partial frame", data, length);
+    }
+    std::vector<size_t> reads;
+    for (size_t i = 0; i < std::min<size_t>(length, 16); ++i) {
+        reads.push_back(static_cast<unsigned char>(data[i]) % 64 + 1);
+    }
+    if (whole.replay(data, length, {}) != split.replay(data, length, reads)) {
+        fail("split reads framed differently from a single read", data, length);
+    }
+}
+}
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+    check_input(reinterpret_cast<const char*>(data), size);
+    return 0;
+}
+#ifndef HFT_LIBFUZZER
+namespace {
+std::vector<std::string> seed_corpus() {
+    hft::fix::FixMessageEncoder client("CLIENT01", "HFTENGINE");
+    hft::fix::FixMessageEncoder engine("HFTENGINE", "CLIENT01");
+    const uint64_t sending_time = 1705329000123456000ull;
+    std::vector<std::string> seeds;
+    hft::fix::NewOrderSingle order{1000001, "AAPL", '1', 100, '2', 150.25, '0', "20240115-14:30:00.123456"};
+    seeds.emplace_back(client.encode(order, 1, sending_time));
+    hft::fix::OrderCancelRequest cancel{1000001, 1000002, 1000001, "AAPL", '1', 100, "20240115-14:30:00.223456"};
+    seeds.emplace_back(client.encode(cancel, 2, sending_time));
+    hft::fix::OrderCancelReplaceRequest replace{1000002, 1000003, 1000001, "AAPL", '1', 200, '2', 150.5, '0',
+                                                "20240115-14:30:00.323456"};
+    seeds.emplace_back(client.encode(replace, 3, sending_time));
+    hft::fix::ExecutionReport report{1000001, 1000001, 7, 'F', '1', "AAPL", '1', 100, 150.25, 40, 150.25, 60, 40,
+                                     150.25};
+    seeds.emplace_back(engine.encode(report, 4, sending_time));
+    hft::fix::Heartbeat heartbeat{"TEST1"};
+    seeds.emplace_back(engine.encode(heartbeat, 5, sending_time));
+    return seeds;
+}
+void reframe(std::string& message) {
+    const size_t body_start = message.find("\0019=");
+    const size_t body_end = message.rfind("\00110=");
+    if (body_start == std::string::npos || body_end == std::string::npos || body_end <= body_start) {
+        return;
+    }
+    const size_t digits_end = message.find('\001', body_start + 3);
+    if (digits_end == std::string::npos || digits_end >= body_end) {
+        return;
+    }
+    std::string framed = message.substr(0, body_start + 3) + std::to_string(body_end - digits_end) +
+                         message.substr(digits_end, body_end - digits_end + 1);
+    uint32_t sum = 0;
+    for (unsigned char c : framed) {
+        sum += c;
+    }
+    char trailer[8];
+    std::snprintf(trailer, sizeof(trailer), "10=%03u\001", sum % 256);
+    message = framed + trailer;
+}
+void mutate(std::string& input, const std::vector<std::string>& seeds, std::mt19937_64& rng) {
+    static const char* fields[] = {"110=77\001", "35=D\001", "11=\001", "44=-0.5\001", "38=99999999999999999999\001",
+                                   "9=5\001", "8=FIX.4.4\001", "10=000\001", "55=\001", "0=1\001"};
+    static const char bytes[] = "0123456789=\001" "8FIX.-+eD";
+    const unsigned rounds = 1 + static_cast<unsigned>(rng() % 4);
+    for (unsigned round = 0; round < rounds; ++round) {
+        const size_t position = input.empty() ? 0 : rng() % input.size();
+        switch (rng() % 7) {
+            case 0:
+                if (!input.empty()) {
+                    input[position] = bytes[rng() % (sizeof(bytes) - 1)];
+                }
+                break;
+            case 1:
+                input.insert(position, fields[rng() % (sizeof(fields) / sizeof(fields[0]))]);
+                break;
+            case 2:
+                input.resize(position);
+                break;
+            case 3:
+                input.erase(position, 1 + rng() % 16);
+                break;
+            case 4:
+                input += seeds[rng() % seeds.size()];
+                break;
+            case 5:
+                input.insert(position, input.substr(position, rng() % 32));
+                break;
+            default:
+                reframe(input);
+                break;
+        }
+    }
+}
+bool run_file(const std::filesystem::path& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        std::cerr << "Failed to open fuzz input: " << path << std::endl;
+        return false;
+    }
+    const std::string input((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    check_input(input.data(), input.size());
+    return true;
+}
+}
+int main(int argc, char* argv[]) {
+    size_t runs = 200000;
+    uint64_t seed = 1;
+    std::vector<std::filesystem::path> inputs;
+    for (int i = 1; i < argc; ++i) {
+        const std::string argument = argv[i];
+        if (argument.rfind("-runs=", 0) == 0) {
+            runs = std::strtoull(argument.c_str() + 6, nullptr, 10);
+        } else if (argument.rfind("-seed=", 0) == 0) {
+            seed = std::strtoull(argument.c_str() + 6, nullptr, 10);
+        } else {
+            inputs.emplace_back(argument);
+        }
+    }
+    if (!inputs.empty()) {
+        size_t executed = 0;
+        for (const auto& input : inputs) {
+            if (std::filesystem::is_directory(input)) {
+                for (const auto& entry : std::filesystem::recursive_directory_iterator(input)) {
+                    executed += entry.is_regular_file() && run_file(entry.path());
+                }
+            } else {
+                executed += run_file(input);
+            }
+        }
+        std::cout << "Executed " << executed << " inputs" << std::endl;
+        return 0;
+    }
+    const std::vector<std::string> seeds = seed_corpus();
+    std::mt19937_64 rng(seed);
+    std::string input;
+    for (size_t i = 0; i < runs; ++i) {
+        input = seeds[rng() % seeds.size()];
+        mutate(input, seeds, rng);
+        check_input(input.data(), input.size());
+    }
+    std::cout << "Executed " << runs << " mutated inputs from " << seeds.size() << " seeds (seed " << seed << ")"
+              << std::endl;
+    return 0;
+}
+#endif
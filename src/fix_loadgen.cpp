@@ -0,0 +1,303 @@
+#include "hft/fix/fix_gateway.hpp"
+#include "hft/fix/fix_dictionary.hpp"
+#include "hft/fix/fix_encoder.hpp"
+#include "hft/fix/fix_message_view.hpp"
+#include "hft/fix/fix_scanner.hpp"
+#include "hft/core/spsc_ring.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+class FixLoadGenerator {
+private:
+    class AckHandler : public hft::fix::FixMessageHandler {
+    public:
+        hft::fix::FixGateway* gateway = nullptr;
+        hft::core::SpscRing<std::pair<hft::fix::FixSessionId, std::string>>* relay = nullptr;
+        hft::fix::FixMessageEncoder encoder{"HFTENGINE", "LOADGEN"};
+        uint64_t sequence = 1;
+        uint64_t rejects = 0;
+        void on_message(hft::fix::FixSessionId session_id, const hft::fix::FixMessageView& message) override {
+            hft::fix::NewOrderSingle order{};
+            if (!hft::fix::decode_fix_message(message, order).ok()) {
+                ++rejects;
+                return;
+            }
+            hft::fix::ExecutionReport ack{};
+            ack.order_id = order.cl_ord_id;
+            ack.cl_ord_id = order.cl_ord_id;
+            ack.exec_id = sequence;
+            ack.exec_type = '0';
+            ack.ord_status = '0';
+            ack.symbol = order.symbol;
+            ack.side = order.side;
+            ack.order_qty = order.order_qty;
+            ack.price = order.price;
+            ack.leaves_qty = order.order_qty;
+            const std::string_view wire = encoder.encode(ack, static_cast<uint32_t>(sequence++), wall_clock_ns());
+            if (!relay) {
+                gateway->send(session_id, wire.data(), wire.size());
+                return;
+            }
+            while (!relay->try_produce([session_id, wire](std::pair<hft::fix::FixSessionId, std::string>& slot) {
+                slot.first = session_id;
+                slot.second.assign(wire.data(), wire.size());
+            })) {
+                std::this_thread::yield();
+            }
+        }
+        void on_reject(hft::fix::FixFrameStatus, const char*, size_t) override {
+            ++rejects;
+        }
+    };
+    struct ClientResult {
+        uint64_t sent = 0;
+        uint64_t acked = 0;
+        std::vector<uint32_t> latencies_ns;
+    };
+    static constexpr size_t CLIENT_BUFFER_SIZE = 256 * 1024;
+    static constexpr size_t RELAY_CAPACITY = 64 * 1024;
+    size_t connections_;
+    size_t messages_per_connection_;
+    size_t window_;
+    uint16_t port_;
+    bool batch_writes_;
+    bool relay_acks_;
+public:
+    FixLoadGenerator(size_t connections, size_t messages_per_connection, size_t window, uint16_t port,
+                     bool batch_writes, bool relay_acks)
+        : connections_(connections), messages_per_connection_(messages_per_connection), window_(window), port_(port),
+          batch_writes_(batch_writes), relay_acks_(relay_acks) {}
+    bool run() {
+        hft::fix::FixParser parser(1);
+        AckHandler handler;
+        std::unique_ptr<hft::fix::FixGateway> gateway;
+        hft::core::SpscRing<std::pair<hft::fix::FixSessionId, std::string>> relay(RELAY_CAPACITY);
+        std::atomic<bool> relay_running{false};
+        std::thread relay_thread;
+        uint16_t port = port_;
+        if (port == 0) {
+            hft::fix::FixGatewayConfig config;
+            config.bind_address = "127.0.0.1";
+            config.port = 0;
+            config.batch_writes = batch_writes_;
+            gateway = std::make_unique<hft::fix::FixGateway>(parser, config);
+            handler.gateway = gateway.get();
+            parser.set_inline_handler(&handler);
+            parser.start();
+            if (!gateway->start()) {
+                parser.stop();
+                return false;
+            }
+            port = gateway->port();
+            if (relay_acks_) {
+                handler.relay = &relay;
+                relay_running.store(true);
+                relay_thread = std::thread([&relay, &relay_running, &gateway]() {
+                    std::pair<hft::fix::FixSessionId, std::string> ack;
+                    while (relay_running.load(std::memory_order_relaxed) || !relay.empty()) {
+                        if (!relay.try_pop(ack)) {
+                            std::this_thread::yield();
+                            continue;
+                        }
+                        gateway->send(ack.first, ack.second.data(), ack.second.size());
+                    }
+                });
+            }
+        }
+        std::cout << "FIX GATEWAY LOAD GENERATOR" << std::endl;
+        std::cout << "==========================" << std::endl;
+        std::cout << "Target:      127.0.0.1:" << port << (gateway ? " (in-process gateway)" : "") << std::endl;
+        std::cout << "Connections: " << connections_ << std::endl;
+        std::cout << "Messages:    " << messages_per_connection_ << " per connection" << std::endl;
+        std::cout << "Window:      " << window_ << " in flight" << std::endl;
+        std::cout << "Writes:      " << (batch_writes_ ? "batched per wakeup" : "one send per ack") << std::endl;
+        std::cout << "Acks:        " << (gateway && relay_acks_ ? "sent from a relay thread" : "sent from the event loop")
+                  << std::endl;
+        std::vector<ClientResult> results(connections_);
+        std::vector<std::thread> clients;
+        const auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < connections_; ++i) {
+            clients.emplace_back([this, port, i, &results]() { run_client(port, i, results[i]); });
+        }
+        for (auto& client : clients) {
+            client.join();
+        }
+        const auto end = std::chrono::steady_clock::now();
+        relay_running.store(false);
+        if (relay_thread.joinable()) {
+            relay_thread.join();
+        }
+        if (gateway) {
+            gateway->stop();
+            parser.stop();
+            parser.set_inline_handler(nullptr);
+        }
+        uint64_t sent = 0;
+        uint64_t acked = 0;
+        std::vector<uint32_t> latencies;
+        for (auto& result : results) {
+            sent += result.sent;
+            acked += result.acked;
+            latencies.insert(latencies.end(), result.latencies_ns.begin(), result.latencies_ns.end());
+        }
+        std::sort(latencies.begin(), latencies.end());
+        const double seconds = std::chrono::duration<double>(end - start).count();
+        std::cout << "\nWire-to-ack" << std::endl;
+        std::cout << "  sent " << sent << "  acked " << acked << std::endl;
+        std::cout << "  throughput " << std::fixed << std::setprecision(2)
+                  << (seconds > 0.0 ? acked / seconds / 1e6 : 0.0) << " M msg/s" << std::endl;
+        print_percentile("p50", latencies, 0.50);
+        print_percentile("p99", latencies, 0.99);
+        print_percentile("p99.9", latencies, 0.999);
+        print_percentile("max", latencies, 1.0);
+        if (gateway) {
+            const auto& stats = gateway->get_stats();
+            const double per_message = acked ? 1.0 / acked : 0.0;
+            std::cout << "\nGateway" << std::endl;
+            std::cout << "  connections " << stats.connections_accepted.load() << "  rejected "
+                      << stats.connections_rejected.load() << "  decode rejects " << handler.rejects << std::endl;
+            std::cout << "  wakeups/msg " << std::setprecision(3) << stats.poll_wakeups.load() * per_message
+                      << "  reads/msg " << stats.read_calls.load() * per_message
+                      << "  sends/msg " << stats.send_calls.load() * per_message
+                      << "  acks/send " << std::setprecision(1)
+                      << (stats.send_calls.load() ? static_cast<double>(acked) / stats.send_calls.load() : 0.0)
+                      << std::endl;
+            std::cout << "  handed off " << stats.messages_handed_off.load() << "  handoff wakeups "
+                      << stats.handoff_wakeups.load() << "  handoff full " << stats.handoff_full.load() << std::endl;
+        }
+        return acked == sent && sent == connections_ * messages_per_connection_;
+    }
+private:
+    static uint64_t wall_clock_ns() {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count());
+    }
+    static uint64_t steady_ns() {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+    static void print_percentile(const char* label, const std::vector<uint32_t>& sorted, double quantile) {
+        if (sorted.empty()) {
+            return;
+        }
+        const size_t index = std::min(sorted.size() - 1, static_cast<size_t>(sorted.size() * quantile));
+        std::cout << "  " << std::left << std::setw(6) << label << std::right << std::fixed << std::setprecision(2)
+                  << std::setw(10) << sorted[index] / 1000.0 << " us" << std::endl;
+    }
+    static bool write_all(int fd, const char* data, size_t length) {
+        while (length != 0) {
+            const ssize_t written = ::send(fd, data, length, 0);
+            if (written <= 0) {
+                return false;
+            }
+            data += written;
+            length -= static_cast<size_t>(written);
+        }
+        return true;
+    }
+    void run_client(uint16_t port, size_t client_index, ClientResult& result) {
+        const int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_port = htons(port);
+        inet_pton(AF_INET, "127.0.0.1", &address.sin_addr);
+        if (fd < 0 || ::connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+            std::cerr << "Load generator client " << client_index << " failed to connect" << std::endl;
+            if (fd >= 0) {
+                ::close(fd);
+            }
+            return;
+        }
+        const int enable = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+        static const char* symbols[] = {"AAPL", "MSFT", "GOOGL", "AMZN", "TSLA", "NVDA", "META", "JPM"};
+        hft::fix::FixMessageEncoder encoder("LOADGEN", "HFTENGINE");
+        hft::fix::FixMessageView view;
+        std::vector<uint64_t> send_ns(messages_per_connection_);
+        std::vector<char> input(CLIENT_BUFFER_SIZE);
+        std::string output;
+        size_t buffered = 0;
+        result.latencies_ns.reserve(messages_per_connection_);
+        while (result.acked < messages_per_connection_) {
+            output.clear();
+            const uint64_t first = result.sent;
+            while (result.sent < messages_per_connection_ && result.sent - result.acked < window_) {
+                hft::fix::NewOrderSingle order{};
+                order.cl_ord_id = result.sent;
+                order.symbol = symbols[(client_index + result.sent) % 8];
+                order.side = result.sent % 2 ? '2' : '1';
+                order.order_qty = 100 + result.sent % 900;
+                order.ord_type = '2';
+                order.price = 100.0 + static_cast<double>(result.sent % 500) * 0.01;
+                const std::string_view wire = encoder.encode(order, static_cast<uint32_t>(result.sent + 1),
+                                                             wall_clock_ns());
+                output.append(wire.data(), wire.size());
+                ++result.sent;
+            }
+            const uint64_t now = steady_ns();
+            std::fill(send_ns.begin() + first, send_ns.begin() + result.sent, now);
+            if (!output.empty() && !write_all(fd, output.data(), output.size())) {
+                break;
+            }
+            const ssize_t received = ::recv(fd, input.data() + buffered, input.size() - buffered, 0);
+            if (received <= 0) {
+                break;
+            }
+            buffered += static_cast<size_t>(received);
+            const uint64_t received_ns = steady_ns();
+            size_t position = 0;
+            while (position < buffered) {
+                const hft::fix::FixFrame frame = hft::fix::frame_fix_message(input.data() + position,
+                                                                             buffered - position);
+                if (frame.status == hft::fix::FixFrameStatus::INCOMPLETE) {
+                    position += frame.start;
+                    break;
+                }
+                if (frame.status == hft::fix::FixFrameStatus::INVALID) {
+                    position += frame.start + 1;
+                    continue;
+                }
+                hft::fix::ExecutionReport ack{};
+                if (frame.status == hft::fix::FixFrameStatus::COMPLETE &&
+                    view.parse(input.data() + position + frame.start, frame.length) &&
+                    hft::fix::decode_fix_message(view, ack).ok() && ack.cl_ord_id < result.sent) {
+                    result.latencies_ns.push_back(static_cast<uint32_t>(
+                        std::min<uint64_t>(received_ns - send_ns[ack.cl_ord_id], UINT32_MAX)));
+                    ++result.acked;
+                }
+                position += frame.start + frame.length;
+            }
+            std::memmove(input.data(), input.data() + position, buffered - position);
+            buffered -= position;
+        }
+        ::close(fd);
+    }
+};
+int main(int argc, char* argv[]) {
+    const size_t connections = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 4;
+    const size_t messages = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 100000;
+    const size_t window = argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 32;
+    const uint16_t port = argc > 4 ? static_cast<uint16_t>(std::strtoul(argv[4], nullptr, 10)) : 0;
+    const bool batch_writes = argc > 5 ? std::strtoul(argv[5], nullptr, 10) != 0 : true;
+    const bool relay_acks = argc > 6 ? std::strtoul(argv[6], nullptr, 10) != 0 : false;
+    if (connections == 0 || messages == 0 || window == 0) {
+        std::cout << "Usage: " << argv[0]
+                  << " [connections] [messages_per_connection] [window] [port] [batch_writes] [relay_acks]" << std::endl;
+        return 1;
+    }
+    FixLoadGenerator generator(connections, messages, window, port, batch_writes, relay_acks);
+    return generator.run() ? 0 : 1;
+}
@@ -0,0 +1,281 @@
+#include "hft/fix/fix_session.hpp"
+#include "hft/fix/fix_parser.hpp"
+#include "hft/fix/fix_dictionary.hpp"
+#include "hft/fix/fix_encoder.hpp"
+#include "hft/fix/fix_message_view.hpp"
+#include <cstdlib>
+#include <deque>
+#include <filesystem>
+#include <iostream>
+#include <string>
+class FixSessionTest {
+private:
+    class LoopbackTransport : public hft::fix::FixTransport {
+    public:
+        std::deque<std::string> queue;
+        size_t drop_interval = 0;
+        uint64_t sent = 0;
+        uint64_t dropped = 0;
+        uint64_t disconnects = 0;
+        bool send(const char* data, size_t length) override {
+            if (drop_interval != 0 && ++sent % drop_interval == 0) {
+                ++dropped;
+                return true;
+            }
+            queue.emplace_back(data, length);
+            return true;
+        }
+        void disconnect() override {
+            ++disconnects;
+        }
+    };
+    class SequenceCheckHandler : public hft::fix::FixMessageHandler {
+    public:
+        uint64_t delivered = 0;
+        uint64_t out_of_order = 0;
+        void on_message(hft::fix::FixSessionId, const hft::fix::FixMessageView& message) override {
+            hft::fix::NewOrderSingle order{};
+            if (!hft::fix::decode_fix_message(message, order).ok() || order.order_qty != delivered + 1) {
+                ++out_of_order;
+            }
+            ++delivered;
+        }
+    };
+    struct SessionPair {
+        hft::fix::FixSessionConfig initiator_config;
+        hft::fix::FixSessionConfig acceptor_config;
+        LoopbackTransport to_acceptor;
+        LoopbackTransport to_initiator;
+        SequenceCheckHandler initiator_app;
+        SequenceCheckHandler acceptor_app;
+        hft::fix::FixSessionEngine initiator;
+        hft::fix::FixSessionEngine acceptor;
+        SessionPair(const hft::fix::FixSessionConfig& initiator_settings,
+                    const hft::fix::FixSessionConfig& acceptor_settings)
+            : initiator_config(initiator_settings), acceptor_config(acceptor_settings),
+              initiator(initiator_config, &to_acceptor, &initiator_app),
+              acceptor(acceptor_config, &to_initiator, &acceptor_app) {}
+        ~SessionPair() {
+            initiator.store().close();
+            acceptor.store().close();
+            std::filesystem::remove(initiator_config.store_path);
+            std::filesystem::remove(acceptor_config.store_path);
+        }
+    };
+    static constexpr size_t LOOPBACK_ORDERS = 100000;
+    static constexpr size_t LOOPBACK_DROP_INTERVAL = 997;
+    static constexpr size_t LOOPBACK_BATCH = 4096;
+    static constexpr uint64_t SENDING_TIME_NS = 1705329000123456000ull;
+    size_t failures_ = 0;
+public:
+    int run() {
+        std::cout << "FIX SESSION TEST" << std::endl;
+        std::cout << "================" << std::endl;
+        check("loopback recovers dropped messages in order", test_loopback_recovery());
+        check("acceptor rejects Logon with unexpected SenderCompID", test_logon_comp_id_mismatch());
+        check("active session terminates on unexpected TargetCompID", test_active_comp_id_mismatch());
+        check("acceptor rejects Logon with MsgSeqNum too low", test_logon_sequence_too_low());
+        check("session without a transport terminates cleanly", test_detached_transport());
+        check("view and raw decoder reject duplicate tags", test_duplicate_tags());
+        std::cout << (failures_ == 0 ? "All FIX session tests passed" : "FIX session tests FAILED") << std::endl;
+        return failures_ == 0 ? 0 : 1;
+    }
+private:
+    void check(const char* name, bool passed) {
+        std::cout << (passed ? "  PASS  " : "  FAIL  ") << name << std::endl;
+        failures_ += passed ? 0 : 1;
+    }
+    static hft::fix::FixSessionConfig make_config(const char* sender, const char* target, const char* store_name) {
+        hft::fix::FixSessionConfig config;
+        config.sender_comp_id = sender;
+        config.target_comp_id = target;
+        config.store_path = (std::filesystem::temp_directory_path() / store_name).string();
+        config.store_capacity = 64 * 1024 * 1024;
+        config.store_index_slots = 1 << 20;
+        return config;
+    }
+    static hft::fix::FixSessionConfig initiator_config() {
+        hft::fix::FixSessionConfig config = make_config("CLIENT01", "HFTENGINE", "fix_session_test_initiator.store");
+        config.reset_on_logon = true;
+        return config;
+    }
+    static hft::fix::FixSessionConfig acceptor_config() {
+        return make_config("HFTENGINE", "CLIENT01", "fix_session_test_acceptor.store");
+    }
+    static void pump_sessions(SessionPair& pair) {
+        hft::fix::FixMessageView view;
+        while (!pair.to_initiator.queue.empty() || !pair.to_acceptor.queue.empty()) {
+            while (!pair.to_acceptor.queue.empty()) {
+                const std::string message = std::move(pair.to_acceptor.queue.front());
+                pair.to_acceptor.queue.pop_front();
+                if (view.parse(message)) {
+                    pair.acceptor.on_message(hft::fix::FixParser::DEFAULT_SESSION, view);
+                }
+            }
+            while (!pair.to_initiator.queue.empty()) {
+                const std::string message = std::move(pair.to_initiator.queue.front());
+                pair.to_initiator.queue.pop_front();
+                if (view.parse(message)) {
+                    pair.initiator.on_message(hft::fix::FixParser::DEFAULT_SESSION, view);
+                }
+            }
+        }
+    }
+    static void deliver(hft::fix::FixSessionEngine& session, std::string_view wire) {
+        hft::fix::FixMessageView view;
+        if (view.parse(wire)) {
+            session.on_message(hft::fix::FixParser::DEFAULT_SESSION, view);
+        }
+    }
+    static std::string with_field(std::string_view wire, std::string_view field) {
+        std::string message(wire);
+        message.insert(message.rfind("\00110=") + 1, field);
+        return message;
+    }
+    static bool log_on(SessionPair& pair) {
+        if (!pair.initiator.open() || !pair.acceptor.open()) {
+            return false;
+        }
+        pair.initiator.logon(0);
+        pump_sessions(pair);
+        return pair.initiator.is_active() && pair.acceptor.is_active();
+    }
+    bool test_loopback_recovery() {
+        SessionPair pair(initiator_config(), acceptor_config());
+        const bool logged_on = log_on(pair);
+        static const char* symbols[] = {"AAPL", "MSFT", "GOOGL", "AMZN"};
+        pair.to_acceptor.drop_interval = LOOPBACK_DROP_INTERVAL;
+        for (size_t i = 0; i < LOOPBACK_ORDERS && logged_on; ++i) {
+            hft::fix::NewOrderSingle order{};
+            order.cl_ord_id = i + 1;
+            order.symbol = symbols[i % 4];
+            order.side = i % 2 ? '2' : '1';
+            order.order_qty = i + 1;
+            order.ord_type = '2';
+            order.price = 100.0 + static_cast<double>(i % 100) * 0.01;
+            pair.initiator.send(order);
+            if ((i + 1) % LOOPBACK_BATCH == 0 || i + 1 == LOOPBACK_ORDERS) {
+                pair.to_acceptor.drop_interval = 0;
+                pump_sessions(pair);
+                pair.to_acceptor.drop_interval = LOOPBACK_DROP_INTERVAL;
+            }
+        }
+        pair.to_acceptor.drop_interval = 0;
+        const uint64_t heartbeat_ns = uint64_t(pair.initiator_config.heartbeat_interval_s) * 1000000000ull;
+        pair.acceptor.on_timer(heartbeat_ns + heartbeat_ns / 4);
+        pump_sessions(pair);
+        const auto& initiator_stats = pair.initiator.get_stats();
+        const auto& acceptor_stats = pair.acceptor.get_stats();
+        const bool recovered = pair.to_acceptor.dropped != 0 && acceptor_stats.resend_requests_sent.load() != 0 &&
+                               initiator_stats.messages_resent.load() != 0;
+        const bool heartbeat_answered = acceptor_stats.test_requests_sent.load() != 0 &&
+                                        initiator_stats.heartbeats_sent.load() != 0;
+        pair.initiator.logout("test complete");
+        pump_sessions(pair);
+        const bool logged_out = pair.initiator.state() == hft::fix::FixSessionState::DISCONNECTED &&
+                                pair.acceptor.state() == hft::fix::FixSessionState::DISCONNECTED;
+        return logged_on && recovered && heartbeat_answered && logged_out &&
+               pair.acceptor_app.delivered == LOOPBACK_ORDERS && pair.acceptor_app.out_of_order == 0 &&
+               pair.acceptor.next_target_seq() == pair.initiator.next_sender_seq();
+    }
+    bool test_logon_comp_id_mismatch() {
+        SessionPair pair(initiator_config(), acceptor_config());
+        if (!pair.acceptor.open()) {
+            return false;
+        }
+        hft::fix::FixMessageEncoder impostor("CLIENT99", "HFTENGINE");
+        deliver(pair.acceptor, impostor.encode(hft::fix::Logon{0, 30, 'Y'}, 1, SENDING_TIME_NS));
+        return pair.acceptor.state() == hft::fix::FixSessionState::DISCONNECTED && pair.to_initiator.queue.empty() &&
+               pair.acceptor.get_stats().comp_id_rejects.load() == 1 && pair.to_initiator.disconnects == 1;
+    }
+    bool test_active_comp_id_mismatch() {
+        SessionPair pair(initiator_config(), acceptor_config());
+        if (!log_on(pair)) {
+            return false;
+        }
+        hft::fix::FixMessageEncoder misrouted("CLIENT01", "OTHERENGINE");
+        hft::fix::NewOrderSingle order{};
+        order.cl_ord_id = 1;
+        order.symbol = "AAPL";
+        order.side = '1';
+        order.order_qty = 1;
+        order.ord_type = '2';
+        order.price = 100.0;
+        deliver(pair.acceptor, misrouted.encode(order, static_cast<uint32_t>(pair.acceptor.next_target_seq()),
+                                                SENDING_TIME_NS));
+        return pair.acceptor.state() == hft::fix::FixSessionState::DISCONNECTED &&
+               pair.acceptor_app.delivered == 0 && pair.acceptor.get_stats().comp_id_rejects.load() == 1;
+    }
+    bool test_logon_sequence_too_low() {
+        SessionPair pair(initiator_config(), acceptor_config());
+        if (!log_on(pair)) {
+            return false;
+        }
+        pair.initiator.logout("reconnect");
+        pump_sessions(pair);
+        const uint64_t expected = pair.acceptor.next_target_seq();
+        const uint64_t messages_sent = pair.acceptor.get_stats().messages_sent.load();
+        hft::fix::FixMessageEncoder client("CLIENT01", "HFTENGINE");
+        deliver(pair.acceptor, client.encode(hft::fix::Logon{0, 30, '\0'}, 1, SENDING_TIME_NS));
+        return expected > 1 && pair.acceptor.state() == hft::fix::FixSessionState::DISCONNECTED &&
+               pair.to_initiator.queue.empty() && pair.acceptor.get_stats().messages_sent.load() == messages_sent;
+    }
+    bool test_detached_transport() {
+        const hft::fix::FixSessionConfig config = acceptor_config();
+        bool terminated = false;
+        {
+            hft::fix::FixSessionEngine session(config, nullptr, nullptr);
+            if (!session.open()) {
+                return false;
+            }
+            hft::fix::FixMessageEncoder client("CLIENT01", "HFTENGINE");
+            deliver(session, client.encode(hft::fix::Logon{0, 30, 'Y'}, 1, SENDING_TIME_NS));
+            deliver(session, client.encode(hft::fix::Logout{}, 2, SENDING_TIME_NS));
+            const bool logged_out = session.state() == hft::fix::FixSessionState::DISCONNECTED;
+            deliver(session, client.encode(hft::fix::Logon{0, 30, 'Y'}, 1, SENDING_TIME_NS));
+            hft::fix::FixMessageEncoder impostor("CLIENT99", "HFTENGINE");
+            deliver(session, impostor.encode(hft::fix::Heartbeat{}, 2, SENDING_TIME_NS));
+            terminated = logged_out && session.state() == hft::fix::FixSessionState::DISCONNECTED &&
+                         session.get_stats().comp_id_rejects.load() == 1;
+            session.store().close();
+        }
+        std::filesystem::remove(config.store_path);
+        return terminated;
+    }
+    bool test_duplicate_tags() {
+        hft::fix::FixMessageEncoder client("CLIENT01", "HFTENGINE");
+        hft::fix::NewOrderSingle order{};
+        order.cl_ord_id = 1;
+        order.symbol = "AAPL";
+        order.side = '1';
+        order.order_qty = 100;
+        order.ord_type = '2';
+        order.price = 100.0;
+        const std::string unique = with_field(client.encode(order, 1, SENDING_TIME_NS), "5000=A\001");
+        const std::string hot_duplicate = with_field(unique, "11=2\001");
+        const std::string cold_duplicate = with_field(unique, "5000=B\001");
+        hft::fix::FixMessageView view;
+        hft::fix::NewOrderSingle decoded{};
+        const bool accepted = view.parse(unique) && view.get_field(5000) == "A" &&
+                              hft::fix::decode_fix_message(view, decoded).ok() &&
+                              hft::fix::decode_fix_message(unique.data(), unique.size(), decoded).ok();
+        const bool hot_rejected =
+            !view.parse(hot_duplicate) && !view.has_field(hft::fix::Tags::CL_ORD_ID) &&
+            hft::fix::decode_fix_message(hot_duplicate.data(), hot_duplicate.size(), decoded).status ==
+                hft::fix::FixDecodeStatus::DUPLICATE_FIELD;
+        const bool cold_rejected =
+            !view.parse(cold_duplicate) && view.field_count() == 0 &&
+            hft::fix::decode_fix_message(cold_duplicate.data(), cold_duplicate.size(), decoded).status ==
+                hft::fix::FixDecodeStatus::DUPLICATE_FIELD;
+        return accepted && hot_rejected && cold_rejected;
+    }
+};
+int main() {
+    try {
+        FixSessionTest test;
+        return test.run();
+    } catch (const std::exception& e) {
+        std::cout << "❌ Error: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -2,8 +2,15 @@
 #include "hft/order/order_book.hpp"
 #include "hft/matching/matching_engine.hpp"
 #include "hft/core/clock.hpp"
+#include "hft/core/numeric.hpp"
 #include "hft/core/redis_client.hpp"
 #include "hft/fix/fix_parser.hpp"
+#include "hft/fix/fix_dictionary.hpp"
+#include "hft/fix/fix_gateway.hpp"
+#include "hft/fix/fix_session_codec.hpp"
+#include "hft/fix/fix_drop_copy.hpp"
+#include "hft/binary/binary_order_entry.hpp"
+#include "hft/binary/binary_gateway_codec.hpp"
 #include "hft/core/admission_control.hpp"
 #include "hft/analytics/pnl_calculator.hpp"
 #include "hft/core/numa_lock_free_queue.hpp"
@@ -22,6 +29,8 @@
 #include <memory_resource>
 #include <array>
 #include <filesystem>
+#include <cstdlib>
+#include <cstring>
 #if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
 #include <immintrin.h>
 #endif
@@ -73,17 +82,89 @@ inline size_t get_cpu_count() {
 }
 class UltraHighPerformanceHFTEngine {
 private:
+    class OrderEntryHandler : public hft::fix::FixMessageHandler {
+    private:
+        UltraHighPerformanceHFTEngine& engine_;
+    public:
+        explicit OrderEntryHandler(UltraHighPerformanceHFTEngine& engine) : engine_(engine) {}
+        void on_message(hft::fix::FixSessionId session_id, const hft::fix::FixMessageView& message) override {
+            engine_.handle_order_entry(session_id, message);
+        }
+        void on_session_closed(hft::fix::FixSessionId session_id) override {
+            engine_.release_session_orders(session_id);
+        }
+    };
+    class BinaryOrderEntryHandler : public hft::binary::BinaryOrderHandler {
+    private:
+        UltraHighPerformanceHFTEngine& engine_;
+    public:
+        explicit BinaryOrderEntryHandler(UltraHighPerformanceHFTEngine& engine) : engine_(engine) {}
+        void on_new_order(hft::binary::BinarySessionId session_id, const hft::binary::BinaryNewOrder& order) override {
+            if (engine_.stopped_.load(std::memory_order_relaxed)) {
+                return;
+            }
+            hft::fix::NewOrderSingle fields{};
+            fields.cl_ord_id = order.cl_ord_id;
+            fields.symbol = hft::binary::binary_symbol(order.symbol);
+            fields.side = order.side;
+            fields.order_qty = order.order_qty;
+            fields.ord_type = order.ord_type;
+            fields.price = hft::binary::from_binary_price(order.price);
+            fields.time_in_force = order.time_in_force;
+            engine_.process_new_order_single_optimized(fields, session_id | ROUTE_BINARY_FLAG);
+        }
+        void on_cancel(hft::binary::BinarySessionId session_id, const hft::binary::BinaryCancel& cancel) override {
+            if (engine_.stopped_.load(std::memory_order_relaxed)) {
+                return;
+            }
+            const hft::core::OrderID order_id =
+                engine_.find_session_order(session_id | ROUTE_BINARY_FLAG, cancel.orig_cl_ord_id);
+            if (order_id != 0) {
+                engine_.matching_engine_->cancel_order(order_id);
+            } else {
+                engine_.reject_binary_cancel(session_id, cancel.cl_ord_id, cancel.symbol, cancel.side);
+            }
+        }
+        void on_replace(hft::binary::BinarySessionId session_id, const hft::binary::BinaryReplace& replace) override {
+            if (engine_.stopped_.load(std::memory_order_relaxed)) {
+                return;
+            }
+            const hft::core::OrderID order_id = engine_.rename_session_order(
+                session_id | ROUTE_BINARY_FLAG, replace.orig_cl_ord_id, replace.cl_ord_id);
+            if (order_id != 0) {
+                engine_.matching_engine_->modify_order(order_id, hft::binary::from_binary_price(replace.price),
+                                                       replace.order_qty);
+            } else {
+                engine_.reject_binary_cancel(session_id, replace.cl_ord_id, replace.symbol, replace.side);
+            }
+        }
+        void on_session_closed(hft::binary::BinarySessionId session_id) override {
+            engine_.release_session_orders(session_id | ROUTE_BINARY_FLAG);
+        }
+    };
     std::unique_ptr<hft::matching::MatchingEngine> matching_engine_;
     std::unique_ptr<hft::fix::FixParser> fix_parser_;
+    std::unique_ptr<OrderEntryHandler> order_entry_handler_;
+    std::unique_ptr<hft::fix::FixSessionCodec> fix_session_codec_;
+    std::unique_ptr<hft::fix::FixGateway> fix_gateway_;
+    std::unique_ptr<BinaryOrderEntryHandler> binary_order_entry_handler_;
+    std::unique_ptr<hft::binary::BinaryGatewayCodec> binary_codec_;
+    std::unique_ptr<hft::fix::FixGateway> binary_gateway_;
+    std::unique_ptr<hft::fix::FixDropCopyLog> drop_copy_;
     std::unique_ptr<hft::core::HighPerformanceRedisClient> redis_client_;
     std::unique_ptr<hft::core::AdmissionControlEngine> admission_controller_;
     std::unique_ptr<hft::analytics::PnLCalculator> pnl_calculator_;
     std::unique_ptr<hft::analytics::SlippageAnalyzer> slippage_analyzer_;
+    std::unique_ptr<hft::matching::TopOfBookSampler> top_of_book_sampler_;
     CacheLineAlignedCounter total_executions_;
     CacheLineAlignedCounter total_orders_sent_;
     CacheLineAlignedCounter total_messages_processed_;
     CacheLineAlignedCounter total_orders_created_;
     CacheLineAlignedCounter total_orders_submitted_;
+    CacheLineAlignedCounter backpressure_releases_;
+    CacheLineAlignedCounter unrouted_execution_reports_;
+    CacheLineAlignedCounter fix_decode_rejects_;
+    CacheLineAlignedCounter order_ownership_rejects_;
     std::vector<double> latency_samples_;
     std::mutex latency_mutex_;
     hft::core::HighResolutionClock clock_;
@@ -113,7 +194,16 @@ private:
     std::array<OrderPool, NUM_POOLS> order_pools_;
     using MessageQueue = hft::core::NumaLockFreeQueue<std::string, 2097152>;
     std::unique_ptr<MessageQueue> inbound_fix_queue_;
-    std::unique_ptr<MessageQueue> outbound_fix_queue_;
+    static constexpr uint64_t ROUTE_CONNECTION_BITS = 12;
+    static constexpr uint32_t ROUTE_BINARY_FLAG = hft::fix::FixGateway::MAX_CONNECTIONS;
+    static constexpr size_t ROUTE_SLOTS = 2 * hft::fix::FixGateway::MAX_CONNECTIONS + 1;
+    struct alignas(64) SessionOrders {
+        std::mutex mutex;
+        std::unordered_map<uint64_t, hft::core::OrderID> order_ids;
+        std::unordered_map<hft::core::OrderID, uint64_t> cl_ord_ids;
+    };
+    std::unique_ptr<SessionOrders[]> session_orders_;
+    std::atomic<uint64_t> next_order_sequence_{1};
     static constexpr size_t NUM_MESSAGE_QUEUES = 16;
     std::array<std::unique_ptr<MessageQueue>, NUM_MESSAGE_QUEUES> parallel_fix_queues_;
     thread_local static std::vector<hft::order::Order> batch_buffer_;
@@ -166,7 +256,12 @@ private:
             admission_controller_->record_queue_enqueue();
         }
         try {
-            if (fix_msg.size() < 15 || fix_msg.find("35=D") == std::string::npos) [[unlikely]] {
+            hft::fix::NewOrderSingle fields;
+            if (!hft::fix::decode_fix_message(fix_msg.data(), fix_msg.size(), fields).ok()) [[unlikely]] {
+                fix_decode_rejects_.value.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            if (!valid_new_order(fields)) [[unlikely]] {
                 return;
             }
             size_t pool_idx = std::hash<std::thread::id>{}(std::this_thread::get_id()) % NUM_POOLS;
@@ -178,14 +273,7 @@ private:
                 }
                 return;
             }
-            if (!extract_order_fields_optimized_to_ptr(fix_msg, order_ptr)) [[unlikely]] {
-                static std::atomic<int> debug_count{0};
-                if (debug_count.fetch_add(1) < 5) {
-                    std::cout << "[DEBUG] Failed to parse FIX message: " << fix_msg.substr(0, std::min(fix_msg.size(), size_t(100))) << std::endl;
-                }
-                order_pools_[pool_idx].pool.deallocate(order_ptr);
-                return;
-            }
+            build_order(fields, assign_order_id(hft::fix::FixGateway::INVALID_CONNECTION, fields.cl_ord_id), order_ptr);
             total_orders_created_.value.fetch_add(1, std::memory_order_relaxed);
             matching_engine_->submit_order(*order_ptr);
             total_orders_submitted_.value.fetch_add(1, std::memory_order_relaxed);
@@ -204,107 +292,14 @@ private:
             update_p99_latency_tracking(static_cast<double>(latency_ns) / 1000.0);
         }
     }
-    bool extract_order_fields_optimized(const std::string& fix_msg, hft::order::Order& order) {
-        thread_local static std::vector<size_t> field_positions;
-        field_positions.clear();
-        const char* data = fix_msg.data();
-        const size_t size = fix_msg.size();
-        for (size_t i = 0; i < size; ++i) {
-            if (data[i] == '\x01') {
-                field_positions.push_back(i);
-            }
-        }
-        uint64_t order_id = 0;
-        const char* symbol_ptr = nullptr;
-        size_t symbol_len = 0;
-        bool is_buy = true;
-        double price = 0.0;
-        uint64_t quantity = 0;
-        size_t start = 0;
-        for (size_t end_pos : field_positions) {
-            if (end_pos <= start + 3) { start = end_pos + 1; continue; }
-            if (data[start] == '1' && data[start+1] == '1' && data[start+2] == '=') {
-                order_id = fast_parse_uint64(data + start + 3, end_pos - start - 3);
-            } else if (data[start] == '5' && data[start+1] == '5' && data[start+2] == '=') {
-                symbol_ptr = data + start + 3;
-                symbol_len = end_pos - start - 3;
-            } else if (data[start] == '5' && data[start+1] == '4' && data[start+2] == '=') {
-                is_buy = (data[start+3] == '1');
-            } else if (data[start] == '4' && data[start+1] == '4' && data[start+2] == '=') {
-                price = fast_parse_double(data + start + 3, end_pos - start - 3);
-            } else if (data[start] == '3' && data[start+1] == '8' && data[start+2] == '=') {
-                quantity = fast_parse_uint64(data + start + 3, end_pos - start - 3);
-            }
-            start = end_pos + 1;
-        }
-        if (order_id == 0 || !symbol_ptr || symbol_len == 0 || quantity == 0) {
-            return false;
-        }
-        order.id = order_id;
-        order.symbol.assign(symbol_ptr, symbol_len);
-        order.side = is_buy ? hft::core::Side::BUY : hft::core::Side::SELL;
-        order.type = hft::core::OrderType::LIMIT;
-        order.price = price;
-        order.quantity = quantity;
-        order.filled_quantity = 0;
-        order.status = hft::core::OrderStatus::PENDING;
-        order.timestamp = std::chrono::high_resolution_clock::now();
-        return true;
-    }
-    bool extract_order_fields_optimized_to_ptr(const std::string& fix_msg, hft::order::Order* order) {
-        thread_local static std::vector<size_t> field_positions;
-        field_positions.clear();
-        const char* data = fix_msg.data();
-        const size_t size = fix_msg.size();
-        for (size_t i = 0; i < size; ++i) {
-            if (data[i] == '\x01') {
-                field_positions.push_back(i);
-            }
-        }
-        uint64_t order_id = 0;
-        const char* symbol_ptr = nullptr;
-        size_t symbol_len = 0;
-        bool is_buy = true;
-        double price = 0.0;
-        uint64_t quantity = 0;
-        size_t start = 0;
-        for (size_t end_pos : field_positions) {
-            if (end_pos <= start + 3) { start = end_pos + 1; continue; }
-            if (data[start] == '1' && data[start+1] == '1' && data[start+2] == '=') {
-                order_id = fast_parse_uint64(data + start + 3, end_pos - start - 3);
-            } else if (data[start] == '5' && data[start+1] == '5' && data[start+2] == '=') {
-                symbol_ptr = data + start + 3;
-                symbol_len = end_pos - start - 3;
-            } else if (data[start] == '5' && data[start+1] == '4' && data[start+2] == '=') {
-                is_buy = (data[start+3] == '1');
-            } else if (data[start] == '4' && data[start+1] == '4' && data[start+2] == '=') {
-                price = fast_parse_double(data + start + 3, end_pos - start - 3);
-            } else if (data[start] == '3' && data[start+1] == '8' && data[start+2] == '=') {
-                quantity = fast_parse_uint64(data + start + 3, end_pos - start - 3);
-            }
-            start = end_pos + 1;
-        }
-        if (order_id == 0 || !symbol_ptr || symbol_len == 0 || quantity == 0) {
-            return false;
-        }
-        new (order) hft::order::Order();
-        order->id = order_id;
-        order->symbol.assign(symbol_ptr, symbol_len);
-        order->side = is_buy ? hft::core::Side::BUY : hft::core::Side::SELL;
-        order->type = hft::core::OrderType::LIMIT;
-        order->price = price;
-        order->quantity = quantity;
-        order->filled_quantity = 0;
-        order->status = hft::core::OrderStatus::PENDING;
-        order->timestamp = std::chrono::high_resolution_clock::now();
-        return true;
+    static bool valid_new_order(const hft::fix::NewOrderSingle& fields) {
+        return fields.cl_ord_id != 0 && !fields.symbol.empty() && fields.order_qty != 0;
     }
-    static uint64_t fast_parse_uint64(const char* str, size_t len) {
-        uint64_t result = 0;
-        for (size_t i = 0; i < len && str[i] >= '0' && str[i] <= '9'; ++i) {
-            result = result * 10 + (str[i] - '0');
-        }
-        return result;
+    static void build_order(const hft::fix::NewOrderSingle& fields, hft::core::OrderID order_id,
+                            hft::order::Order* order) {
+        new (order) hft::order::Order(order_id, hft::core::Symbol(fields.symbol),
+                                      fields.side == '1' ? hft::core::Side::BUY : hft::core::Side::SELL,
+                                      hft::core::OrderType::LIMIT, fields.price, fields.order_qty);
     }
     void update_p99_latency_tracking(double latency_us) {
         std::lock_guard<std::mutex> lock(p99_latency_mutex_);
@@ -321,68 +316,244 @@ private:
             current_p99_latency_us_.store(p99, std::memory_order_relaxed);
         }
     }
-    static double fast_parse_double(const char* str, size_t len) {
-        double result = 0.0;
-        double fraction = 0.0;
-        bool in_fraction = false;
-        double divisor = 10.0;
-        for (size_t i = 0; i < len; ++i) {
-            if (str[i] >= '0' && str[i] <= '9') {
-                if (in_fraction) {
-                    fraction += (str[i] - '0') / divisor;
-                    divisor *= 10.0;
-                } else {
-                    result = result * 10.0 + (str[i] - '0');
+    static size_t route_slot(uint32_t route) {
+        return route == hft::fix::FixGateway::INVALID_CONNECTION ? 0 : static_cast<size_t>(route) + 1;
+    }
+    hft::core::OrderID assign_order_id(uint32_t route, uint64_t cl_ord_id) {
+        const size_t slot = route_slot(route);
+        const hft::core::OrderID order_id =
+            (next_order_sequence_.fetch_add(1, std::memory_order_relaxed) << ROUTE_CONNECTION_BITS) | slot;
+        if (slot == 0) {
+            return order_id;
+        }
+        SessionOrders& orders = session_orders_[slot];
+        std::lock_guard<std::mutex> lock(orders.mutex);
+        if (!orders.order_ids.emplace(cl_ord_id, order_id).second) {
+            return 0;
+        }
+        orders.cl_ord_ids.emplace(order_id, cl_ord_id);
+        return order_id;
+    }
+    hft::core::OrderID find_session_order(uint32_t route, uint64_t cl_ord_id) {
+        SessionOrders& orders = session_orders_[route_slot(route)];
+        std::lock_guard<std::mutex> lock(orders.mutex);
+        auto it = orders.order_ids.find(cl_ord_id);
+        return it != orders.order_ids.end() ? it->second : 0;
+    }
+    hft::core::OrderID rename_session_order(uint32_t route, uint64_t orig_cl_ord_id, uint64_t cl_ord_id) {
+        SessionOrders& orders = session_orders_[route_slot(route)];
+        std::lock_guard<std::mutex> lock(orders.mutex);
+        auto it = orders.order_ids.find(orig_cl_ord_id);
+        if (it == orders.order_ids.end() || (cl_ord_id != orig_cl_ord_id && orders.order_ids.count(cl_ord_id) != 0)) {
+            return 0;
+        }
+        const hft::core::OrderID order_id = it->second;
+        orders.order_ids.erase(it);
+        orders.order_ids.emplace(cl_ord_id, order_id);
+        orders.cl_ord_ids[order_id] = cl_ord_id;
+        return order_id;
+    }
+    uint32_t find_order_route(hft::core::OrderID order_id, uint64_t& cl_ord_id, bool release) {
+        const size_t slot = order_id & ((uint64_t(1) << ROUTE_CONNECTION_BITS) - 1);
+        if (slot == 0 || slot >= ROUTE_SLOTS) {
+            return hft::fix::FixGateway::INVALID_CONNECTION;
+        }
+        SessionOrders& orders = session_orders_[slot];
+        std::lock_guard<std::mutex> lock(orders.mutex);
+        auto it = orders.cl_ord_ids.find(order_id);
+        if (it == orders.cl_ord_ids.end()) {
+            return hft::fix::FixGateway::INVALID_CONNECTION;
+        }
+        cl_ord_id = it->second;
+        if (release) {
+            orders.order_ids.erase(cl_ord_id);
+            orders.cl_ord_ids.erase(it);
+        }
+        return static_cast<uint32_t>(slot - 1);
+    }
+    void release_session_orders(uint32_t route) {
+        SessionOrders& orders = session_orders_[route_slot(route)];
+        std::lock_guard<std::mutex> lock(orders.mutex);
+        orders.order_ids.clear();
+        orders.cl_ord_ids.clear();
+    }
+    void handle_order_entry(hft::fix::FixSessionId session_id, const hft::fix::FixMessageView& message) {
+        if (stopped_.load(std::memory_order_relaxed)) {
+            return;
+        }
+        switch (hft::fix::classify_msg_type(message.msg_type())) {
+            case hft::fix::FixMsgType::NEW_ORDER_SINGLE: {
+                hft::fix::NewOrderSingle order;
+                if (hft::fix::decode_fix_message(message, order).ok()) {
+                    process_new_order_single_optimized(order, session_id);
+                }
+                break;
+            }
+            case hft::fix::FixMsgType::ORDER_CANCEL_REQUEST: {
+                hft::fix::OrderCancelRequest cancel;
+                if (hft::fix::decode_fix_message(message, cancel).ok()) {
+                    const hft::core::OrderID order_id = find_session_order(session_id, cancel.orig_cl_ord_id);
+                    if (order_id != 0) {
+                        matching_engine_->cancel_order(order_id);
+                    } else {
+                        reject_fix_cancel(session_id, cancel.cl_ord_id, cancel.orig_cl_ord_id, '1');
+                    }
+                }
+                break;
+            }
+            case hft::fix::FixMsgType::ORDER_CANCEL_REPLACE_REQUEST: {
+                hft::fix::OrderCancelReplaceRequest replace;
+                if (hft::fix::decode_fix_message(message, replace).ok()) {
+                    const hft::core::OrderID order_id =
+                        rename_session_order(session_id, replace.orig_cl_ord_id, replace.cl_ord_id);
+                    if (order_id != 0) {
+                        matching_engine_->modify_order(order_id, replace.price, replace.order_qty);
+                    } else {
+                        reject_fix_cancel(session_id, replace.cl_ord_id, replace.orig_cl_ord_id, '2');
+                    }
                 }
-            } else if (str[i] == '.') {
-                in_fraction = true;
+                break;
             }
+            default:
+                break;
         }
-        return result + fraction;
     }
-    void process_new_order_single_optimized(const hft::fix::FixMessage& msg) {
+    void process_new_order_single_optimized(const hft::fix::NewOrderSingle& msg,
+                                            uint32_t route = hft::fix::FixGateway::INVALID_CONNECTION) {
         try {
-            if (stopped_.load(std::memory_order_relaxed)) {
-                return;
-            }
-            hft::core::OrderID order_id = std::stoull(msg.get_field(hft::fix::Tags::CL_ORD_ID));
-            const std::string& symbol = msg.get_field(hft::fix::Tags::SYMBOL);
-            hft::core::Side side = (msg.get_field(hft::fix::Tags::SIDE) == "1") ?
-                                    hft::core::Side::BUY : hft::core::Side::SELL;
-            double price = msg.get_price(hft::fix::Tags::PRICE);
-            hft::core::Quantity quantity = msg.get_quantity(hft::fix::Tags::ORDER_QTY);
             size_t pool_idx = std::hash<std::thread::id>{}(std::this_thread::get_id()) % NUM_POOLS;
             auto* order_ptr = order_pools_[pool_idx].pool.allocate();
             if (!order_ptr) [[unlikely]] {
                 return;
             }
-            new (order_ptr) hft::order::Order(order_id, symbol, side,
-                hft::core::OrderType::LIMIT, price, quantity);
-            matching_engine_->submit_order(*order_ptr);
+            const hft::core::OrderID order_id = valid_new_order(msg) ? assign_order_id(route, msg.cl_ord_id) : 0;
+            if (order_id == 0) [[unlikely]] {
+                order_pools_[pool_idx].pool.deallocate(order_ptr);
+                return;
+            }
+            build_order(msg, order_id, order_ptr);
+            if (!matching_engine_->submit_order(*order_ptr)) {
+                uint64_t cl_ord_id = 0;
+                find_order_route(order_id, cl_ord_id, true);
+            }
             order_pools_[pool_idx].pool.deallocate(order_ptr);
             total_messages_processed_.value.fetch_add(1, std::memory_order_relaxed);
         } catch (...) {
         }
     }
-    void send_fix_execution_report_async(const hft::matching::ExecutionReport& report) {
+    static void execution_status_codes(hft::core::OrderStatus status, char& exec_type, char& ord_status) {
+        switch (status) {
+            case hft::core::OrderStatus::FILLED:
+                exec_type = 'F';
+                ord_status = '2';
+                break;
+            case hft::core::OrderStatus::PARTIALLY_FILLED:
+                exec_type = 'F';
+                ord_status = '1';
+                break;
+            case hft::core::OrderStatus::CANCELLED:
+                exec_type = '4';
+                ord_status = '4';
+                break;
+            default:
+                exec_type = '0';
+                ord_status = '0';
+                break;
+        }
+    }
+    void send_execution_report_async(const hft::matching::ExecutionReport& report) {
+        const bool terminal = report.status == hft::core::OrderStatus::FILLED ||
+                              report.status == hft::core::OrderStatus::CANCELLED;
+        uint64_t cl_ord_id = 0;
+        const uint32_t route = find_order_route(report.order_id, cl_ord_id, terminal);
+        const bool binary = route != hft::fix::FixGateway::INVALID_CONNECTION && (route & ROUTE_BINARY_FLAG) != 0;
+        if (route == hft::fix::FixGateway::INVALID_CONNECTION || !(binary ? binary_gateway_ : fix_gateway_)) {
+            unrouted_execution_reports_.value.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        if (binary) {
+            send_binary_execution_report(route & ~ROUTE_BINARY_FLAG, cl_ord_id, report);
+        } else {
+            send_fix_execution_report(route, cl_ord_id, report);
+        }
+    }
+    void send_binary_execution_report(hft::fix::FixConnectionId connection, uint64_t cl_ord_id,
+                                      const hft::matching::ExecutionReport& report) {
+        hft::binary::BinaryExecutionReport fields{};
+        fields.order_id = report.order_id;
+        fields.cl_ord_id = cl_ord_id;
+        fields.exec_id = execution_id_counter_.fetch_add(1, std::memory_order_relaxed);
+        fields.transact_time = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count());
+        fields.price = hft::binary::to_binary_price(report.price);
+        fields.order_qty = report.original_quantity;
+        fields.last_px = hft::binary::to_binary_price(report.fills.empty() ? 0.0 : report.fills.back().price);
+        fields.last_qty = report.fills.empty() ? 0 : report.fills.back().quantity;
+        fields.leaves_qty = report.remaining_quantity;
+        fields.cum_qty = report.executed_quantity;
+        fields.avg_px = hft::binary::to_binary_price(report.avg_executed_price);
+        hft::binary::set_binary_symbol(fields.symbol, report.symbol);
+        execution_status_codes(report.status, fields.exec_type, fields.ord_status);
+        fields.side = report.side == hft::core::Side::BUY ? '1' : '2';
+        char encoded[hft::binary::binary_message_size<hft::binary::BinaryExecutionReport>()];
+        const size_t length = hft::binary::encode_binary_message(fields, encoded, sizeof(encoded));
+        binary_gateway_->send(connection, encoded, length);
+    }
+    void reject_binary_cancel(hft::fix::FixConnectionId connection, uint64_t cl_ord_id,
+                              const char (&symbol)[hft::binary::BINARY_SYMBOL_LENGTH], char side) {
+        order_ownership_rejects_.value.fetch_add(1, std::memory_order_relaxed);
+        if (!binary_gateway_) {
+            return;
+        }
+        hft::binary::BinaryExecutionReport fields{};
+        fields.cl_ord_id = cl_ord_id;
+        fields.exec_id = execution_id_counter_.fetch_add(1, std::memory_order_relaxed);
+        fields.transact_time = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count());
+        std::memcpy(fields.symbol, symbol, sizeof(fields.symbol));
+        fields.exec_type = '8';
+        fields.ord_status = '8';
+        fields.side = side;
+        char encoded[hft::binary::binary_message_size<hft::binary::BinaryExecutionReport>()];
+        const size_t length = hft::binary::encode_binary_message(fields, encoded, sizeof(encoded));
+        binary_gateway_->send(connection, encoded, length);
+    }
+    void send_fix_execution_report(hft::fix::FixConnectionId connection, uint64_t cl_ord_id,
+                                   const hft::matching::ExecutionReport& report) {
         try {
-            static thread_local std::string exec_report;
-            exec_report.clear();
-            exec_report.reserve(512);
-            exec_report = "8=FIX.4.4\x01";
-            exec_report += "35=8\x01";
-            exec_report += "49=HFT_ENGINE\x01";
-            exec_report += "56=CLIENT\x01";
-            exec_report += "34=" + std::to_string(fix_seq_num_.fetch_add(1)) + "\x01";
-            exec_report += "52=" + std::to_string(std::chrono::system_clock::now().time_since_epoch().count()) + "\x01";
-            exec_report += "37=" + std::to_string(report.order_id) + "\x01";
-            exec_report += "11=" + std::to_string(report.order_id) + "\x01";
-            exec_report += "17=" + std::to_string(execution_id_counter_.fetch_add(1)) + "\x01";
-            exec_report += std::string("150=") + (report.status == hft::core::OrderStatus::FILLED ? "F" : "0") + "\x01";
-            exec_report += std::string("39=") + (report.status == hft::core::OrderStatus::FILLED ? "2" : "0") + "\x01";
-            exec_report += std::to_string(execution_id_counter_.fetch_add(1)) + "\x01";
-            exec_report += std::string("54=") + (report.side == hft::core::Side::BUY ? "1" : "2") + "\x01";
-            outbound_fix_queue_->enqueue(std::move(exec_report));
+            hft::fix::ExecutionReport fields{};
+            fields.order_id = report.order_id;
+            fields.cl_ord_id = cl_ord_id;
+            fields.exec_id = execution_id_counter_.fetch_add(1, std::memory_order_relaxed);
+            fields.symbol = report.symbol;
+            execution_status_codes(report.status, fields.exec_type, fields.ord_status);
+            fields.side = report.side == hft::core::Side::BUY ? '1' : '2';
+            fields.order_qty = report.original_quantity;
+            fields.price = report.price;
+            fields.last_qty = report.fills.empty() ? 0 : report.fills.back().quantity;
+            fields.last_px = report.fills.empty() ? 0.0 : report.fills.back().price;
+            fields.leaves_qty = report.remaining_quantity;
+            fields.cum_qty = report.executed_quantity;
+            fields.avg_px = report.avg_executed_price;
+            fix_session_codec_->send(connection, fields);
+        } catch (...) {
+        }
+    }
+    void reject_fix_cancel(hft::fix::FixConnectionId connection, uint64_t cl_ord_id, uint64_t orig_cl_ord_id,
+                           char response_to) {
+        order_ownership_rejects_.value.fetch_add(1, std::memory_order_relaxed);
+        if (!fix_gateway_) {
+            return;
+        }
+        try {
+            hft::fix::OrderCancelReject fields{};
+            fields.order_id = "NONE";
+            fields.cl_ord_id = cl_ord_id;
+            fields.orig_cl_ord_id = orig_cl_ord_id;
+            fields.ord_status = '8';
+            fields.cxl_rej_response_to = response_to;
+            fields.cxl_rej_reason = 1;
+            fix_session_codec_->send(connection, fields);
         } catch (...) {
         }
     }
@@ -416,7 +587,24 @@ public:
         std::filesystem::create_directories("logs");
         matching_engine_ = std::make_unique<hft::matching::MatchingEngine>(
             hft::matching::MatchingAlgorithm::PRICE_TIME_PRIORITY, "logs/engine_logs.log", true);
+        matching_engine_->enable_top_of_book();
+        hft::core::WaitStrategyConfig wait_config;
+        wait_config.type = hft::core::WaitStrategyType::SPIN_FUTEX;
+        wait_config.spin_iterations = 4096;
+        wait_config.enqueue_timeout_ns = 200000;
+        matching_engine_->set_wait_strategy(wait_config);
+        matching_engine_->set_backpressure_callback([this](size_t, bool engaged) {
+            if (!engaged) {
+                backpressure_releases_.value.fetch_add(1, std::memory_order_relaxed);
+            }
+        }, 48000, 16000);
+        top_of_book_sampler_ = std::make_unique<hft::matching::TopOfBookSampler>(
+            matching_engine_->create_top_of_book_sampler());
         fix_parser_ = std::make_unique<hft::fix::FixParser>(8);
+        drop_copy_ = std::make_unique<hft::fix::FixDropCopyLog>();
+        if (!drop_copy_->open()) {
+            std::cout << "[ERROR] Failed to open FIX drop-copy log" << std::endl;
+        }
         redis_client_ = std::make_unique<hft::core::HighPerformanceRedisClient>();
         admission_controller_ = std::make_unique<hft::core::AdmissionControlEngine>();
         pnl_calculator_ = std::make_unique<hft::analytics::PnLCalculator>();
@@ -424,16 +612,21 @@ public:
         cpu_count_ = get_cpu_count();
         numa_thread_pool_ = std::make_unique<hft::core::NumaThreadPool<std::function<void()>>>(cpu_count_);
         inbound_fix_queue_ = std::make_unique<MessageQueue>(0);
-        outbound_fix_queue_ = std::make_unique<MessageQueue>(0);
+        session_orders_ = std::make_unique<SessionOrders[]>(ROUTE_SLOTS);
         for (size_t i = 0; i < NUM_MESSAGE_QUEUES; ++i) {
             parallel_fix_queues_[i] = std::make_unique<MessageQueue>(i % 2);
         }
         fix_builder_ = std::make_unique<hft::fix::FixMessageBuilder>("HFT_ENGINE", "CLIENT");
-        fix_parser_->set_message_callback([this](const hft::fix::FixMessage& msg) {
-            if (msg.msg_type == "D") {
-                this->process_new_order_single_optimized(msg);
-            }
-        });
+        order_entry_handler_ = std::make_unique<OrderEntryHandler>(*this);
+        hft::fix::FixSessionConfig session_config;
+        session_config.sender_comp_id = "HFT_ENGINE";
+        session_config.target_comp_id = "CLIENT";
+        session_config.store_path = "logs/fix_session";
+        session_config.store_capacity = 4 * 1024 * 1024;
+        session_config.store_index_slots = 16384;
+        fix_session_codec_ = std::make_unique<hft::fix::FixSessionCodec>(*fix_parser_, session_config,
+                                                                         *order_entry_handler_, drop_copy_.get());
+        fix_parser_->set_inline_handler(fix_session_codec_.get());
         fix_parser_->set_error_callback([](const std::string&, const std::string&) {
         });
         matching_engine_->set_execution_callback([this](const hft::matching::ExecutionReport& report) {
@@ -442,7 +635,7 @@ public:
             }
             total_executions_.value.fetch_add(1, std::memory_order_relaxed);
             numa_thread_pool_->enqueue([this, report]() {
-                this->send_fix_execution_report_async(report);
+                this->send_execution_report_async(report);
                 if (redis_client_) {
                     redis_client_->cache_order_state_async(report.order_id, report.symbol, "FILLED");
                 }
@@ -506,10 +699,42 @@ public:
             }
         }
     }
+    bool start_fix_gateway(uint16_t port) {
+        hft::fix::FixGatewayConfig config;
+        config.port = port;
+        fix_gateway_ = std::make_unique<hft::fix::FixGateway>(*fix_session_codec_, config);
+        fix_session_codec_->attach(fix_gateway_.get());
+        if (!fix_gateway_->start()) {
+            fix_session_codec_->attach(nullptr);
+            fix_gateway_.reset();
+            return false;
+        }
+        std::cout << "[LOG] FIX gateway listening on port " << fix_gateway_->port() << std::endl;
+        return true;
+    }
+    bool start_binary_gateway(uint16_t port) {
+        hft::fix::FixGatewayConfig config;
+        config.port = port;
+        binary_order_entry_handler_ = std::make_unique<BinaryOrderEntryHandler>(*this);
+        binary_codec_ = std::make_unique<hft::binary::BinaryGatewayCodec>(*binary_order_entry_handler_);
+        binary_gateway_ = std::make_unique<hft::fix::FixGateway>(*binary_codec_, config);
+        if (!binary_gateway_->start()) {
+            binary_gateway_.reset();
+            return false;
+        }
+        std::cout << "[LOG] Binary order entry gateway listening on port " << binary_gateway_->port() << std::endl;
+        return true;
+    }
     void stop() {
         if (stopped_.exchange(true)) {
             return;
         }
+        if (fix_gateway_) {
+            fix_gateway_->stop();
+        }
+        if (binary_gateway_) {
+            binary_gateway_->stop();
+        }
         if (matching_engine_) {
             matching_engine_->stop();
         }
@@ -526,12 +751,15 @@ public:
             if (t.joinable()) t.join();
         }
         if (fix_parser_) {
-            fix_parser_->set_message_callback(nullptr);
+            fix_parser_->set_inline_handler(nullptr);
             fix_parser_->set_error_callback(nullptr);
         }
         if (matching_engine_) {
             matching_engine_->set_execution_callback(nullptr);
         }
+        if (drop_copy_) {
+            drop_copy_->close();
+        }
     }
     void run_ultra_high_performance_stress_test() {
         std::cout << "[LOG] Starting ULTRA HIGH-PERFORMANCE stress test targeting 100K+ msg/s with P99 latency control..." << std::endl;
@@ -675,7 +903,35 @@ public:
                  << redis_stats.avg_redis_latency_us << std::endl;
         std::cout << "orders_created = " << total_orders_created_.value.load() << std::endl;
         std::cout << "orders_submitted = " << total_orders_submitted_.value.load() << std::endl;
+        std::cout << "queue_full_events = " << stats.queue_full_events << std::endl;
+        std::cout << "backpressure_events = " << stats.backpressure_events << std::endl;
+        std::cout << "backpressure_releases = " << backpressure_releases_.value.load() << std::endl;
+        std::cout << "unrouted_execution_reports = " << unrouted_execution_reports_.value.load() << std::endl;
+        std::cout << "fix_decode_rejects = " << fix_decode_rejects_.value.load() << std::endl;
+        std::cout << "order_ownership_rejects = " << order_ownership_rejects_.value.load() << std::endl;
+        if (fix_gateway_) {
+            const auto& session_stats = fix_session_codec_->get_stats();
+            std::cout << "fix_sessions_opened = " << session_stats.sessions_opened.load() << std::endl;
+            std::cout << "fix_sessions_rejected = " << session_stats.sessions_rejected.load() << std::endl;
+            std::cout << "fix_messages_dropped = " << session_stats.messages_dropped.load() << std::endl;
+        }
+        if (binary_codec_) {
+            const auto& binary_stats = binary_codec_->get_stats();
+            std::cout << "binary_messages_received = " << binary_stats.messages_received.load() << std::endl;
+            std::cout << "binary_messages_rejected = " << binary_stats.messages_rejected.load() << std::endl;
+            std::cout << "binary_invalid_frames = " << binary_stats.invalid_frames.load() << std::endl;
+        }
+        std::cout << "peak_queue_depth = " << stats.peak_queue_depth << std::endl;
+        std::cout << "rejects_validation = " << stats.rejects_by_reason[static_cast<size_t>(hft::matching::RejectReason::VALIDATION)] << std::endl;
+        std::cout << "rejects_risk = " << stats.rejects_by_reason[static_cast<size_t>(hft::matching::RejectReason::RISK_CHECK)] << std::endl;
+        for (const auto& symbol_stats : stats.symbols) {
+            std::cout << "symbol_" << symbol_stats.symbol << " = orders " << symbol_stats.orders_processed
+                      << ", fills " << symbol_stats.fills << ", volume " << symbol_stats.volume
+                      << ", notional " << std::fixed << std::setprecision(2) << symbol_stats.notional << std::endl;
+        }
+        size_t marked_symbols = pnl_calculator_->update_market_prices(*top_of_book_sampler_);
         std::cout << "\n=== INSTRUMENTED P&L METRICS ===" << std::endl;
+        std::cout << "marked_symbols = " << marked_symbols << std::endl;
         std::cout << "realized_pnl = " << std::fixed << std::setprecision(2) << pnl_calculator_->get_realized_pnl() << std::endl;
         std::cout << "unrealized_pnl = " << std::fixed << std::setprecision(2) << pnl_calculator_->get_unrealized_pnl() << std::endl;
         std::cout << "total_pnl = " << std::fixed << std::setprecision(2) << pnl_calculator_->get_total_pnl() << std::endl;
@@ -718,7 +974,7 @@ public:
 };
 thread_local std::vector<hft::order::Order> UltraHighPerformanceHFTEngine::batch_buffer_;
 thread_local std::vector<std::string> UltraHighPerformanceHFTEngine::fix_batch_buffer_;
-int main() {
+int main(int argc, char* argv[]) {
     UltraHighPerformanceHFTEngine* hft_engine = nullptr;
     try {
         std::filesystem::create_directories("logs");
@@ -726,6 +982,12 @@ int main() {
         hft_engine = new UltraHighPerformanceHFTEngine();
         std::cout << "[LOG] Starting HFT Engine components..." << std::endl;
         hft_engine->start();
+        if (argc > 1 && !hft_engine->start_fix_gateway(static_cast<uint16_t>(std::strtoul(argv[1], nullptr, 10)))) {
+            std::cout << "[ERROR] Failed to start FIX gateway on port " << argv[1] << std::endl;
+        }
+        if (argc > 2 && !hft_engine->start_binary_gateway(static_cast<uint16_t>(std::strtoul(argv[2], nullptr, 10)))) {
+            std::cout << "[ERROR] Failed to start binary order entry gateway on port " << argv[2] << std::endl;
+        }
         std::cout << "\n" << std::string(80, '=') << std::endl;
         std::cout << "🚀 ULTRA HIGH-PERFORMANCE HFT ENGINE - 100K+ MSG/S TARGET" << std::endl;
         std::cout << std::string(80, '=') << std::endl;
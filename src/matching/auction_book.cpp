@@ -0,0 +1,192 @@
+#include "hft/matching/auction_book.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+namespace hft {
+namespace matching {
+AuctionBook::AuctionBook(const core::Symbol& symbol)
+    : symbol_(symbol), market_bid_quantity_(0), market_ask_quantity_(0) {}
+void AuctionBook::reserve(size_t order_capacity) {
+    orders_.reserve(order_capacity);
+    order_index_.reserve(order_capacity);
+}
+void AuctionBook::add_order(const order::Order& order) {
+    const core::Quantity quantity = order.remaining_quantity();
+    if (quantity == 0 || order_index_.count(order.id) != 0) {
+        return;
+    }
+    AuctionOrder entry{order.id, order.price, quantity, 0, order.side, order.type == core::OrderType::MARKET};
+    if (entry.is_market) {
+        (order.side == core::Side::BUY ? market_bid_quantity_ : market_ask_quantity_) += quantity;
+    } else {
+        auto [it, inserted] = level_index_.try_emplace(order.price, static_cast<uint32_t>(levels_.size()));
+        if (inserted) {
+            levels_.push_back(Level{order.price, 0, 0});
+        }
+        entry.level = it->second;
+        Level& level = levels_[entry.level];
+        (order.side == core::Side::BUY ? level.bid_quantity : level.ask_quantity) += quantity;
+    }
+    order_index_.emplace(order.id, static_cast<uint32_t>(orders_.size()));
+    orders_.push_back(entry);
+}
+bool AuctionBook::cancel_order(core::OrderID order_id) {
+    auto it = order_index_.find(order_id);
+    if (it == order_index_.end()) {
+        return false;
+    }
+    AuctionOrder& entry = orders_[it->second];
+    if (entry.is_market) {
+        (entry.side == core::Side::BUY ? market_bid_quantity_ : market_ask_quantity_) -= entry.quantity;
+    } else {
+        Level& level = levels_[entry.level];
+        (entry.side == core::Side::BUY ? level.bid_quantity : level.ask_quantity) -= entry.quantity;
+    }
+    entry.quantity = 0;
+    order_index_.erase(it);
+    return true;
+}
+void AuctionBook::sort_levels() const {
+    const size_t level_count = levels_.size();
+    sorted_levels_.resize(level_count);
+    std::iota(sorted_levels_.begin(), sorted_levels_.end(), 0u);
+    std::sort(sorted_levels_.begin(), sorted_levels_.end(), [this](uint32_t a, uint32_t b) {
+        return levels_[a].price < levels_[b].price;
+    });
+}
+AuctionEquilibrium AuctionBook::compute_equilibrium(core::Price reference_price) const {
+    AuctionEquilibrium result;
+    const size_t level_count = levels_.size();
+    result.price_levels = level_count;
+    if (level_count == 0) {
+        return result;
+    }
+    sort_levels();
+    sorted_prices_.resize(level_count);
+    cumulative_demand_.resize(level_count);
+    cumulative_supply_.resize(level_count);
+    executable_.resize(level_count);
+    imbalance_.resize(level_count);
+    core::Quantity supply = market_ask_quantity_;
+    for (size_t i = 0; i < level_count; ++i) {
+        const Level& level = levels_[sorted_levels_[i]];
+        sorted_prices_[i] = level.price;
+        supply += level.ask_quantity;
+        cumulative_supply_[i] = supply;
+    }
+    core::Quantity demand = market_bid_quantity_;
+    for (size_t i = level_count; i-- > 0;) {
+        demand += levels_[sorted_levels_[i]].bid_quantity;
+        cumulative_demand_[i] = demand;
+    }
+    const core::Quantity* demand_data = cumulative_demand_.data();
+    const core::Quantity* supply_data = cumulative_supply_.data();
+    core::Quantity* executable_data = executable_.data();
+    core::Quantity* imbalance_data = imbalance_.data();
+    core::Quantity max_executable = 0;
+    for (size_t i = 0; i < level_count; ++i) {
+        const core::Quantity d = demand_data[i];
+        const core::Quantity s = supply_data[i];
+        const core::Quantity executable = d < s ? d : s;
+        executable_data[i] = executable;
+        imbalance_data[i] = d > s ? d - s : s - d;
+        max_executable = executable > max_executable ? executable : max_executable;
+    }
+    if (max_executable == 0) {
+        return result;
+    }
+    size_t best = level_count;
+    core::Quantity best_imbalance = std::numeric_limits<core::Quantity>::max();
+    double best_distance = std::numeric_limits<double>::max();
+    for (size_t i = 0; i < level_count; ++i) {
+        if (executable_data[i] != max_executable) continue;
+        const double distance = std::abs(sorted_prices_[i] - reference_price);
+        if (imbalance_data[i] < best_imbalance ||
+            (imbalance_data[i] == best_imbalance && distance < best_distance)) {
+            best = i;
+            best_imbalance = imbalance_data[i];
+            best_distance = distance;
+        }
+    }
+    result.price = sorted_prices_[best];
+    result.executable_quantity = max_executable;
+    result.bid_surplus = demand_data[best] - max_executable;
+    result.ask_surplus = supply_data[best] - max_executable;
+    result.valid = true;
+    return result;
+}
+std::vector<AuctionMatch> AuctionBook::execute(const AuctionEquilibrium& equilibrium) {
+    std::vector<AuctionMatch> matches;
+    executed_.assign(orders_.size(), 0);
+    if (!equilibrium.valid || equilibrium.executable_quantity == 0) {
+        return matches;
+    }
+    const size_t level_count = levels_.size();
+    if (sorted_levels_.size() != level_count) {
+        sort_levels();
+    }
+    std::vector<core::Quantity> bid_allocation(level_count, 0);
+    std::vector<core::Quantity> ask_allocation(level_count, 0);
+    core::Quantity bid_remaining = equilibrium.executable_quantity;
+    core::Quantity market_bid_allocation = std::min(market_bid_quantity_, bid_remaining);
+    bid_remaining -= market_bid_allocation;
+    for (size_t i = level_count; i-- > 0 && bid_remaining > 0;) {
+        const Level& level = levels_[sorted_levels_[i]];
+        if (level.price < equilibrium.price) break;
+        core::Quantity allocation = std::min(level.bid_quantity, bid_remaining);
+        bid_allocation[sorted_levels_[i]] = allocation;
+        bid_remaining -= allocation;
+    }
+    core::Quantity ask_remaining = equilibrium.executable_quantity;
+    core::Quantity market_ask_allocation = std::min(market_ask_quantity_, ask_remaining);
+    ask_remaining -= market_ask_allocation;
+    for (size_t i = 0; i < level_count && ask_remaining > 0; ++i) {
+        const Level& level = levels_[sorted_levels_[i]];
+        if (level.price > equilibrium.price) break;
+        core::Quantity allocation = std::min(level.ask_quantity, ask_remaining);
+        ask_allocation[sorted_levels_[i]] = allocation;
+        ask_remaining -= allocation;
+    }
+    std::vector<std::pair<uint32_t, core::Quantity>> bid_executions;
+    std::vector<std::pair<uint32_t, core::Quantity>> ask_executions;
+    for (uint32_t index = 0; index < orders_.size(); ++index) {
+        const AuctionOrder& entry = orders_[index];
+        if (entry.quantity == 0) continue;
+        const bool is_buy = entry.side == core::Side::BUY;
+        core::Quantity& pool = entry.is_market
+            ? (is_buy ? market_bid_allocation : market_ask_allocation)
+            : (is_buy ? bid_allocation[entry.level] : ask_allocation[entry.level]);
+        if (pool == 0) continue;
+        const core::Quantity take = std::min(pool, entry.quantity);
+        pool -= take;
+        executed_[index] = take;
+        (is_buy ? bid_executions : ask_executions).emplace_back(index, take);
+    }
+    matches.reserve(bid_executions.size() + ask_executions.size());
+    size_t bid_cursor = 0;
+    size_t ask_cursor = 0;
+    while (bid_cursor < bid_executions.size() && ask_cursor < ask_executions.size()) {
+        auto& bid = bid_executions[bid_cursor];
+        auto& ask = ask_executions[ask_cursor];
+        const core::Quantity quantity = std::min(bid.second, ask.second);
+        matches.push_back(AuctionMatch{bid.first, ask.first, quantity});
+        bid.second -= quantity;
+        ask.second -= quantity;
+        if (bid.second == 0) ++bid_cursor;
+        if (ask.second == 0) ++ask_cursor;
+    }
+    return matches;
+}
+void AuctionBook::clear() {
+    orders_.clear();
+    order_index_.clear();
+    levels_.clear();
+    level_index_.clear();
+    executed_.clear();
+    sorted_levels_.clear();
+    market_bid_quantity_ = 0;
+    market_ask_quantity_ = 0;
+}
+}
+}
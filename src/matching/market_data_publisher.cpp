@@ -0,0 +1,172 @@
+#include "hft/matching/market_data_publisher.hpp"
+#include <algorithm>
+#include <chrono>
+#include <stdexcept>
+namespace hft {
+namespace matching {
+MarketDataRing::MarketDataRing(size_t capacity) {
+    if (capacity < 2 || (capacity & (capacity - 1)) != 0) {
+        throw std::invalid_argument("MarketDataRing capacity must be a power of two");
+    }
+    capacity_ = capacity;
+    mask_ = capacity - 1;
+    slots_ = std::make_unique<MarketDataSlot[]>(capacity);
+}
+uint32_t SymbolDirectory::get_or_assign(const core::Symbol& symbol) {
+    uint32_t id = find(symbol);
+    if (id != INVALID_SYMBOL_ID) {
+        return id;
+    }
+    std::lock_guard<std::mutex> lock(assign_mutex_);
+    id = find(symbol);
+    if (id != INVALID_SYMBOL_ID) {
+        return id;
+    }
+    id = count_.load(std::memory_order_relaxed);
+    if (id >= MAX_SYMBOLS) {
+        return INVALID_SYMBOL_ID;
+    }
+    names_[id] = symbol;
+    size_t slot = std::hash<core::Symbol>{}(symbol) & (SLOT_COUNT - 1);
+    while (slots_[slot].load(std::memory_order_relaxed) != 0) {
+        slot = (slot + 1) & (SLOT_COUNT - 1);
+    }
+    slots_[slot].store(id + 1, std::memory_order_release);
+    count_.store(id + 1, std::memory_order_release);
+    return id;
+}
+uint32_t SymbolDirectory::find(const core::Symbol& symbol) const {
+    size_t slot = std::hash<core::Symbol>{}(symbol) & (SLOT_COUNT - 1);
+    while (true) {
+        const uint32_t entry = slots_[slot].load(std::memory_order_acquire);
+        if (entry == 0) {
+            return INVALID_SYMBOL_ID;
+        }
+        if (names_[entry - 1] == symbol) {
+            return entry - 1;
+        }
+        slot = (slot + 1) & (SLOT_COUNT - 1);
+    }
+}
+std::string_view SymbolDirectory::name(uint32_t symbol_id) const {
+    if (symbol_id >= size()) {
+        return {};
+    }
+    return names_[symbol_id];
+}
+void MarketDataBookBuilder::apply(const MarketDataUpdate& update) {
+    if (update.symbol_id >= SymbolDirectory::MAX_SYMBOLS) {
+        return;
+    }
+    if (update.symbol_id >= books_.size()) {
+        books_.resize(update.symbol_id + 1);
+    }
+    LocalBook& book = books_[update.symbol_id];
+    if (book.last_sequence != 0 && update.symbol_sequence != book.last_sequence + 1) {
+        book.stale = true;
+        ++gaps_detected_;
+    }
+    book.last_sequence = update.symbol_sequence;
+    switch (update.type) {
+        case MarketDataUpdateType::ADD_LEVEL:
+        case MarketDataUpdateType::MODIFY_LEVEL:
+            if (update.side == core::Side::BUY) {
+                book.bids[update.price] = update.quantity;
+            } else {
+                book.asks[update.price] = update.quantity;
+            }
+            break;
+        case MarketDataUpdateType::DELETE_LEVEL:
+            if (update.side == core::Side::BUY) {
+                book.bids.erase(update.price);
+            } else {
+                book.asks.erase(update.price);
+            }
+            break;
+        case MarketDataUpdateType::TRADE:
+        case MarketDataUpdateType::AUCTION_TRADE:
+            book.last_trade_price = update.price;
+            book.last_trade_quantity = update.quantity;
+            break;
+    }
+}
+void MarketDataBookBuilder::reset(uint32_t symbol_id) {
+    if (symbol_id < books_.size()) {
+        books_[symbol_id] = LocalBook{};
+    }
+}
+const MarketDataBookBuilder::LocalBook* MarketDataBookBuilder::get_book(uint32_t symbol_id) const {
+    return symbol_id < books_.size() ? &books_[symbol_id] : nullptr;
+}
+MarketDataPublisher::MarketDataPublisher(SymbolDirectory& symbols, size_t ring_capacity)
+    : ring_(ring_capacity), symbols_(symbols), symbol_states_(SymbolDirectory::MAX_SYMBOLS) {}
+void MarketDataPublisher::publish_level_delta(uint32_t symbol_id, core::Side side, core::Price price,
+                                              int64_t quantity_delta, core::OrderID order_id,
+                                              core::TimePoint timestamp) {
+    if (symbol_id >= SymbolDirectory::MAX_SYMBOLS || quantity_delta == 0) {
+        return;
+    }
+    auto& levels = (side == core::Side::BUY) ? symbol_states_[symbol_id].bid_levels
+                                             : symbol_states_[symbol_id].ask_levels;
+    auto [it, inserted] = levels.try_emplace(price, 0);
+    int64_t new_quantity = static_cast<int64_t>(it->second) + quantity_delta;
+    MarketDataUpdate update{};
+    update.timestamp_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        timestamp.time_since_epoch()).count();
+    update.order_id = order_id;
+    update.price = price;
+    update.side = side;
+    if (new_quantity <= 0) {
+        levels.erase(it);
+        if (inserted) {
+            return;
+        }
+        update.type = MarketDataUpdateType::DELETE_LEVEL;
+        update.quantity = 0;
+    } else {
+        it->second = static_cast<core::Quantity>(new_quantity);
+        update.type = inserted ? MarketDataUpdateType::ADD_LEVEL : MarketDataUpdateType::MODIFY_LEVEL;
+        update.quantity = it->second;
+    }
+    publish(symbol_id, update);
+}
+void MarketDataPublisher::publish_trade(uint32_t symbol_id, core::Side aggressor_side, core::Price price,
+                                        core::Quantity quantity, core::OrderID aggressive_order_id,
+                                        core::OrderID passive_order_id, core::TimePoint timestamp) {
+    if (symbol_id >= SymbolDirectory::MAX_SYMBOLS) {
+        return;
+    }
+    MarketDataUpdate update{};
+    update.timestamp_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        timestamp.time_since_epoch()).count();
+    update.type = MarketDataUpdateType::TRADE;
+    update.side = aggressor_side;
+    update.price = price;
+    update.quantity = quantity;
+    update.order_id = aggressive_order_id;
+    update.contra_order_id = passive_order_id;
+    publish(symbol_id, update);
+}
+void MarketDataPublisher::publish_auction_trade(uint32_t symbol_id, core::Price price, core::Quantity quantity,
+                                                core::OrderID buy_order_id, core::OrderID sell_order_id,
+                                                core::TimePoint timestamp) {
+    if (symbol_id >= SymbolDirectory::MAX_SYMBOLS) {
+        return;
+    }
+    MarketDataUpdate update{};
+    update.timestamp_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        timestamp.time_since_epoch()).count();
+    update.type = MarketDataUpdateType::AUCTION_TRADE;
+    update.price = price;
+    update.quantity = quantity;
+    update.order_id = buy_order_id;
+    update.contra_order_id = sell_order_id;
+    publish(symbol_id, update);
+}
+void MarketDataPublisher::publish(uint32_t symbol_id, MarketDataUpdate& update) {
+    update.symbol_id = symbol_id;
+    update.symbol_sequence = ++symbol_states_[symbol_id].sequence;
+    ring_.publish(update);
+}
+}
+}
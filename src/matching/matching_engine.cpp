@@ -3,12 +3,16 @@
 #include <algorithm>
 #include <sstream>
 #include <filesystem>
+#include <limits>
+#include <stdexcept>
 namespace hft {
 namespace matching {
 MatchingEngine::MatchingEngine(MatchingAlgorithm algorithm, const std::string& log_path, bool use_segment_tree)
-    : algorithm_(algorithm), use_segment_tree_(use_segment_tree)
+    : algorithm_(algorithm), use_segment_tree_(use_segment_tree),
+      high_watermark_(ORDER_QUEUE_SIZE * 3 / 4), low_watermark_(ORDER_QUEUE_SIZE / 4)
 {
     incoming_orders_ = std::make_unique<core::LockFreeQueue<order::Order, ORDER_QUEUE_SIZE>>();
+    auction_books_.resize(SymbolDirectory::MAX_SYMBOLS);
     logger_ = std::make_unique<core::AsyncLogger>(log_path, core::LogLevel::INFO);
     logger_->start();
     std::string implementation_type = use_segment_tree_ ? "Segment Tree" : "Legacy";
@@ -35,6 +39,260 @@ void MatchingEngine::set_error_callback(ErrorCallback callback) {
 void MatchingEngine::set_matching_algorithm(MatchingAlgorithm algorithm) {
     algorithm_ = algorithm;
 }
+void MatchingEngine::set_wait_strategy(const core::WaitStrategyConfig& config) {
+    if (running_.load()) {
+        if (logger_) {
+            logger_->warn("Wait strategy must be configured before the MatchingEngine is started", "ENGINE");
+        }
+        return;
+    }
+    wait_config_ = config;
+    if (logger_) {
+        logger_->info(std::string("Matching queue wait strategy: ") + core::wait_strategy_name(config.type) +
+                      ", spin iterations " + std::to_string(config.spin_iterations) +
+                      ", enqueue timeout " + std::to_string(config.enqueue_timeout_ns) + "ns", "ENGINE");
+    }
+}
+void MatchingEngine::set_backpressure_callback(BackpressureCallback callback, size_t high_watermark,
+                                               size_t low_watermark) {
+    backpressure_callback_ = std::move(callback);
+    high_watermark_ = std::min(high_watermark, ORDER_QUEUE_SIZE);
+    low_watermark_ = std::min(low_watermark, high_watermark_);
+}
+size_t MatchingEngine::get_queue_depth() const {
+    const uint64_t dequeued = orders_dequeued_.load(std::memory_order_acquire);
+    const uint64_t enqueued = orders_enqueued_.load(std::memory_order_acquire);
+    return enqueued > dequeued ? static_cast<size_t>(enqueued - dequeued) : 0;
+}
+void MatchingEngine::enable_market_data(size_t ring_capacity) {
+    if (running_.load()) {
+        if (logger_) {
+            logger_->warn("Market data must be enabled before the MatchingEngine is started", "ENGINE");
+        }
+        return;
+    }
+    market_data_publisher_ = std::make_unique<MarketDataPublisher>(symbol_directory_, ring_capacity);
+    if (logger_) {
+        logger_->info("Market data publisher enabled with ring capacity " + std::to_string(ring_capacity), "ENGINE");
+    }
+}
+void MatchingEngine::enable_top_of_book() {
+    if (running_.load()) {
+        if (logger_) {
+            logger_->warn("Top-of-book cache must be enabled before the MatchingEngine is started", "ENGINE");
+        }
+        return;
+    }
+    top_of_book_ = std::make_unique<TopOfBookCache>();
+    if (use_segment_tree_) {
+        segment_tree_levels_.resize(SymbolDirectory::MAX_SYMBOLS);
+    }
+}
+TopOfBookSampler MatchingEngine::create_top_of_book_sampler() const {
+    if (!top_of_book_) {
+        throw std::logic_error("Top-of-book cache is not enabled");
+    }
+    return TopOfBookSampler(*top_of_book_, symbol_directory_);
+}
+bool MatchingEngine::set_trading_phase(const core::Symbol& symbol, TradingPhase phase) {
+    if (phase == TradingPhase::CONTINUOUS) {
+        if (logger_) {
+            logger_->warn("Leaving the auction call phase for " + symbol +
+                          " requires uncross_auction with a reference price", "ENGINE");
+        }
+        return false;
+    }
+    EngineCommand command;
+    command.type = CommandType::OPEN_AUCTION;
+    command.symbol = symbol;
+    post_command(std::move(command));
+    return true;
+}
+TradingPhase MatchingEngine::get_trading_phase(const core::Symbol& symbol) const {
+    const uint32_t symbol_id = symbol_directory_.find(symbol);
+    return symbol_id < SymbolDirectory::MAX_SYMBOLS ? trading_phases_[symbol_id].load(std::memory_order_acquire)
+                                                    : TradingPhase::CONTINUOUS;
+}
+std::future<AuctionResult> MatchingEngine::uncross_auction(const core::Symbol& symbol, core::Price reference_price) {
+    EngineCommand command;
+    command.type = CommandType::UNCROSS_AUCTION;
+    command.symbol = symbol;
+    command.reference_price = reference_price;
+    std::future<AuctionResult> result = command.result.get_future();
+    if (!(reference_price > 0.0)) {
+        if (logger_) {
+            logger_->warn("Auction uncross for " + symbol + " rejected: reference price must be positive", "ENGINE");
+        }
+        AuctionResult rejected;
+        rejected.symbol = symbol;
+        command.result.set_value(std::move(rejected));
+        return result;
+    }
+    post_command(std::move(command));
+    return result;
+}
+void MatchingEngine::post_command(EngineCommand command) {
+    if (!running_.load()) {
+        execute_command(command);
+        return;
+    }
+    command.order_barrier = orders_enqueued_.load(std::memory_order_acquire);
+    {
+        std::lock_guard<std::mutex> lock(command_mutex_);
+        pending_commands_.push_back(std::move(command));
+    }
+    commands_pending_.store(true, std::memory_order_release);
+    order_doorbell_.ring();
+}
+void MatchingEngine::run_pending_commands(uint64_t orders_processed) {
+    std::deque<EngineCommand> ready;
+    {
+        std::lock_guard<std::mutex> lock(command_mutex_);
+        while (!pending_commands_.empty() && pending_commands_.front().order_barrier <= orders_processed) {
+            ready.push_back(std::move(pending_commands_.front()));
+            pending_commands_.pop_front();
+        }
+        commands_pending_.store(!pending_commands_.empty(), std::memory_order_release);
+    }
+    for (auto& command : ready) {
+        execute_command(command);
+    }
+}
+void MatchingEngine::execute_command(EngineCommand& command) {
+    switch (command.type) {
+        case CommandType::OPEN_AUCTION:
+            open_auction(command.symbol);
+            break;
+        case CommandType::UNCROSS_AUCTION:
+            command.result.set_value(execute_uncross(command.symbol, command.reference_price));
+            break;
+        case CommandType::CANCEL_ORDER:
+            execute_cancel(command.order_id);
+            break;
+        case CommandType::MODIFY_ORDER:
+            execute_modify(command.order_id, command.price, command.quantity);
+            break;
+    }
+}
+void MatchingEngine::open_auction(const core::Symbol& symbol) {
+    const uint32_t symbol_id = symbol_directory_.get_or_assign(symbol);
+    if (symbol_id == SymbolDirectory::INVALID_SYMBOL_ID) {
+        if (logger_) {
+            logger_->error("Cannot open auction for " + symbol + ": symbol directory is full", "ENGINE");
+        }
+        return;
+    }
+    if (trading_phases_[symbol_id].load(std::memory_order_relaxed) == TradingPhase::AUCTION) {
+        return;
+    }
+    auto& auction = auction_books_[symbol_id];
+    if (!auction) {
+        auction = std::make_unique<AuctionBook>(symbol);
+    }
+    move_resting_orders_to_auction(symbol, *auction);
+    trading_phases_[symbol_id].store(TradingPhase::AUCTION, std::memory_order_release);
+    if (logger_) {
+        logger_->info("Auction call phase started for " + symbol + " with " +
+                      std::to_string(auction->order_count()) + " resting orders", "ENGINE");
+    }
+}
+AuctionResult MatchingEngine::execute_uncross(const core::Symbol& symbol, core::Price reference_price) {
+    AuctionResult result;
+    result.symbol = symbol;
+    const uint32_t symbol_id = symbol_directory_.find(symbol);
+    AuctionBook* auction = find_auction_book(symbol_id);
+    if (!auction) {
+        return result;
+    }
+    result.orders_accumulated = auction->order_count();
+    const auto discovery_start = core::HighResolutionClock::now();
+    result.equilibrium = auction->compute_equilibrium(reference_price);
+    const auto execution_start = core::HighResolutionClock::now();
+    std::vector<AuctionMatch> matches = auction->execute(result.equilibrium);
+    const core::Price uncross_price = result.equilibrium.price;
+    const core::TimePoint timestamp = core::HighResolutionClock::now();
+    const auto& entries = auction->get_orders();
+    const auto& executed = auction->get_executed_quantities();
+    std::vector<Fill> fills;
+    fills.reserve(matches.size());
+    for (const auto& match : matches) {
+        fills.emplace_back(entries[match.bid_index].id, entries[match.ask_index].id, uncross_price,
+                           match.quantity, symbol, timestamp);
+    }
+    if (market_data_publisher_) {
+        for (const auto& fill : fills) {
+            market_data_publisher_->publish_auction_trade(symbol_id, fill.price, fill.quantity,
+                                                          fill.aggressive_order_id, fill.passive_order_id,
+                                                          fill.timestamp);
+        }
+    }
+    auto& orders = use_segment_tree_ ? segment_tree_orders_ : active_orders_;
+    std::vector<ExecutionReport> reports;
+    for (size_t i = 0; i < entries.size(); ++i) {
+        const AuctionOrder& entry = entries[i];
+        if (entry.quantity == 0) continue;
+        auto it = orders.find(entry.id);
+        if (it == orders.end()) continue;
+        order::Order& order = it->second;
+        order.filled_quantity += executed[i];
+        const bool rests = order.remaining_quantity() > 0 && !entry.is_market;
+        if (executed[i] > 0) {
+            ++result.orders_executed;
+            order.status = order.remaining_quantity() == 0 ? core::OrderStatus::FILLED
+                                                           : core::OrderStatus::PARTIALLY_FILLED;
+        } else if (!rests) {
+            order.status = core::OrderStatus::CANCELLED;
+        }
+        if (executed[i] > 0 || !rests) {
+            ExecutionReport report(order);
+            report.execution_id = generate_execution_id();
+            report.avg_executed_price = executed[i] > 0 ? uncross_price : 0.0;
+            report.timestamp = timestamp;
+            reports.push_back(std::move(report));
+        }
+        if (rests) {
+            if (use_segment_tree_) {
+                get_or_create_segment_tree_book(symbol).add_order(order.price, order.remaining_quantity(), order.side);
+                track_segment_tree_level(symbol, order.side, order.price,
+                                         static_cast<int64_t>(order.remaining_quantity()));
+            } else {
+                get_or_create_order_book(symbol).add_order(order);
+            }
+            publish_book_delta(symbol, order.side, order.price,
+                               static_cast<int64_t>(order.remaining_quantity()), order.id);
+        } else {
+            orders.erase(it);
+        }
+    }
+    auction->clear();
+    trading_phases_[symbol_id].store(TradingPhase::CONTINUOUS, std::memory_order_release);
+    publish_top_of_book(symbol);
+    const auto execution_end = core::HighResolutionClock::now();
+    result.fills = fills.size();
+    result.price_discovery_ns = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        execution_start - discovery_start).count());
+    result.execution_ns = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        execution_end - execution_start).count());
+    counters_.local().record_matched(symbol_id, result.orders_executed);
+    record_fills(symbol_id, fills);
+    if (logger_) {
+        logger_->info("Auction uncross for " + symbol + ": price " + std::to_string(uncross_price) +
+                      ", volume " + std::to_string(result.equilibrium.executable_quantity) +
+                      ", fills " + std::to_string(result.fills) +
+                      ", orders " + std::to_string(result.orders_accumulated), "ENGINE");
+    }
+    if (execution_callback_) {
+        for (const auto& report : reports) {
+            execution_callback_(report);
+        }
+    }
+    if (fill_callback_) {
+        for (const auto& fill : fills) {
+            fill_callback_(fill);
+        }
+    }
+    return result;
+}
 void MatchingEngine::start() {
     if (running_.exchange(true)) {
         if (logger_) {
@@ -57,9 +315,11 @@ void MatchingEngine::stop() {
     if (logger_) {
         logger_->info("Stopping MatchingEngine", "ENGINE");
     }
+    order_doorbell_.ring();
     if (matching_thread_.joinable()) {
         matching_thread_.join();
     }
+    run_pending_commands(std::numeric_limits<uint64_t>::max());
     if (logger_) {
         logger_->info("MatchingEngine stopped successfully", "ENGINE");
     }
@@ -76,7 +336,7 @@ bool MatchingEngine::submit_order(const order::Order& order) {
         if (logger_) {
             logger_->error("Order " + std::to_string(order.id) + " failed validation", "ORDER_MGMT");
         }
-        stats_.orders_rejected.fetch_add(1);
+        counters_.local().record_reject(RejectReason::VALIDATION);
         return false;
     }
     if (!perform_risk_checks(order)) {
@@ -86,92 +346,124 @@ bool MatchingEngine::submit_order(const order::Order& order) {
         if (logger_) {
             logger_->error("Order " + std::to_string(order.id) + " failed risk checks", "ORDER_MGMT");
         }
-        stats_.orders_rejected.fetch_add(1);
+        counters_.local().record_reject(RejectReason::RISK_CHECK);
         return false;
     }
     order::Order order_copy = order;
     order_copy.timestamp = core::HighResolutionClock::now();
-    bool enqueued = incoming_orders_->enqueue(std::move(order_copy));
-    if (!enqueued && logger_) {
-        logger_->warn("Order queue full, order " + std::to_string(order.id) + " dropped", "ENGINE");
+    core::WaitStrategy producer_wait(wait_config_);
+    bool enqueued = producer_wait.retry_until([&]() {
+        return incoming_orders_->enqueue(order_copy);
+    }, wait_config_.enqueue_timeout_ns);
+    if (!enqueued) {
+        ThreadCounters& counters = counters_.local();
+        counters.record_reject(RejectReason::QUEUE_FULL);
+        if (backpressure_callback_ && !backpressure_active_.exchange(true)) {
+            counters.record_backpressure();
+            backpressure_callback_(ORDER_QUEUE_SIZE, true);
+        }
+        if (error_callback_) {
+            error_callback_("QUEUE_FULL", "Order queue full");
+        }
+        if (logger_) {
+            logger_->warn("Order queue full, order " + std::to_string(order.id) + " dropped", "ENGINE");
+        }
+        return false;
     }
-    return enqueued;
+    on_order_enqueued();
+    return true;
 }
 bool MatchingEngine::cancel_order(core::OrderID order_id) {
-    order::Order cancelled_order_copy;
-    bool found = false;
-    if (use_segment_tree_) {
-        auto it = segment_tree_orders_.find(order_id);
-        if (it == segment_tree_orders_.end()) {
-            if (logger_) {
-                logger_->warn("Attempted to cancel non-existent order " + std::to_string(order_id), "ORDER_MGMT");
-            }
-            return false;
+    if (!running_.load()) {
+        return execute_cancel(order_id);
+    }
+    EngineCommand command;
+    command.type = CommandType::CANCEL_ORDER;
+    command.order_id = order_id;
+    post_command(std::move(command));
+    return true;
+}
+bool MatchingEngine::modify_order(core::OrderID order_id, core::Price new_price, core::Quantity new_quantity) {
+    if (!running_.load()) {
+        return execute_modify(order_id, new_price, new_quantity);
+    }
+    EngineCommand command;
+    command.type = CommandType::MODIFY_ORDER;
+    command.order_id = order_id;
+    command.price = new_price;
+    command.quantity = new_quantity;
+    post_command(std::move(command));
+    return true;
+}
+bool MatchingEngine::remove_live_order(core::OrderID order_id, order::Order& removed) {
+    auto& orders = use_segment_tree_ ? segment_tree_orders_ : active_orders_;
+    auto it = orders.find(order_id);
+    if (it == orders.end()) {
+        if (logger_) {
+            logger_->warn("Attempted to cancel non-existent order " + std::to_string(order_id), "ORDER_MGMT");
         }
-        cancelled_order_copy = it->second;
-        cancelled_order_copy.status = core::OrderStatus::CANCELLED;
-        found = true;
-        auto book_it = segment_tree_books_.find(cancelled_order_copy.symbol);
+        return false;
+    }
+    removed = it->second;
+    orders.erase(it);
+    const int64_t quantity_delta = -static_cast<int64_t>(removed.remaining_quantity());
+    if (AuctionBook* auction = find_auction_book(removed.symbol)) {
+        auction->cancel_order(order_id);
+    } else if (use_segment_tree_) {
+        auto book_it = segment_tree_books_.find(removed.symbol);
         if (book_it != segment_tree_books_.end()) {
-            book_it->second->remove_order(cancelled_order_copy.price, cancelled_order_copy.remaining_quantity(), cancelled_order_copy.side);
+            book_it->second->remove_order(removed.price, removed.remaining_quantity(), removed.side);
+            track_segment_tree_level(removed.symbol, removed.side, removed.price, quantity_delta);
+            publish_book_delta(removed.symbol, removed.side, removed.price, quantity_delta, order_id);
         }
-        segment_tree_orders_.erase(it);
     } else {
-        auto it = active_orders_.find(order_id);
-        if (it == active_orders_.end()) {
-            if (logger_) {
-                logger_->warn("Attempted to cancel non-existent order " + std::to_string(order_id), "ORDER_MGMT");
-            }
-            return false;
-        }
-        cancelled_order_copy = it->second;
-        cancelled_order_copy.status = core::OrderStatus::CANCELLED;
-        found = true;
-        auto* book = get_order_book(cancelled_order_copy.symbol);
-        if (book) {
-            book->cancel_order(order_id);
+        auto* book = get_order_book(removed.symbol);
+        if (book && book->cancel_order(order_id)) {
+            publish_book_delta(removed.symbol, removed.side, removed.price, quantity_delta, order_id);
         }
-        active_orders_.erase(it);
+    }
+    publish_top_of_book(removed.symbol);
+    return true;
+}
+bool MatchingEngine::execute_cancel(core::OrderID order_id) {
+    order::Order cancelled_order;
+    if (!remove_live_order(order_id, cancelled_order)) {
+        return false;
     }
     if (logger_) {
         logger_->log_order_cancelled(order_id, "User requested");
     }
-    if (!found) {
-        return false;
-    }
-    ExecutionReport report(cancelled_order_copy);
-    report.status = core::OrderStatus::CANCELLED;
+    cancelled_order.status = core::OrderStatus::CANCELLED;
     if (execution_callback_) {
-        execution_callback_(report);
+        execution_callback_(ExecutionReport(cancelled_order));
     }
     return true;
 }
-bool MatchingEngine::modify_order(core::OrderID order_id, core::Price new_price, core::Quantity new_quantity) {
-    order::Order modified_order;
-    bool found = false;
-    if (use_segment_tree_) {
-        auto it = segment_tree_orders_.find(order_id);
-        if (it != segment_tree_orders_.end()) {
-            modified_order = it->second;
-            found = true;
-        }
-    } else {
-        auto it = active_orders_.find(order_id);
-        if (it != active_orders_.end()) {
-            modified_order = it->second;
-            found = true;
-        }
-    }
-    if (!found) {
+bool MatchingEngine::execute_modify(core::OrderID order_id, core::Price new_price, core::Quantity new_quantity) {
+    auto& orders = use_segment_tree_ ? segment_tree_orders_ : active_orders_;
+    auto it = orders.find(order_id);
+    if (it == orders.end()) {
         return false;
     }
-    cancel_order(order_id);
-    modified_order.id = next_execution_id_.fetch_add(1);
+    order::Order modified_order = it->second;
     modified_order.price = new_price;
     modified_order.quantity = new_quantity;
     modified_order.filled_quantity = 0;
+    modified_order.status = core::OrderStatus::PENDING;
+    const bool valid = validate_order(modified_order);
+    if (!valid || !perform_risk_checks(modified_order)) {
+        counters_.local().record_reject(valid ? RejectReason::RISK_CHECK : RejectReason::VALIDATION);
+        if (logger_) {
+            logger_->error("Replace of order " + std::to_string(order_id) + " failed " +
+                           (valid ? "risk checks" : "validation"), "ORDER_MGMT");
+        }
+        return false;
+    }
+    order::Order replaced_order;
+    remove_live_order(order_id, replaced_order);
     modified_order.timestamp = core::HighResolutionClock::now();
-    return submit_order(modified_order);
+    process_order(modified_order);
+    return true;
 }
 order::OrderBook* MatchingEngine::get_order_book(const core::Symbol& symbol) {
     auto it = order_books_.find(symbol);
@@ -237,26 +529,34 @@ std::vector<order::Order> MatchingEngine::get_orders_for_symbol(const core::Symb
 void MatchingEngine::matching_worker() {
     order::Order incoming_order;
     uint64_t processed_count = 0;
+    uint64_t total_processed = 0;
     auto last_throughput_log = core::HighResolutionClock::now();
     if (logger_) {
         logger_->info("Matching worker thread started", "ENGINE");
     }
+    core::WaitStrategy wait_strategy(wait_config_, &order_doorbell_);
     while (running_.load()) {
+        if (commands_pending_.load(std::memory_order_acquire)) {
+            run_pending_commands(orders_dequeued_.load(std::memory_order_relaxed));
+        }
         if (incoming_orders_->dequeue(incoming_order)) {
+            wait_strategy.reset();
+            on_order_dequeued();
             process_order(incoming_order);
             processed_count++;
+            total_processed++;
             auto now = core::HighResolutionClock::now();
             auto elapsed_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(now - last_throughput_log).count();
             if (processed_count >= 10000 || elapsed_ns >= 1000000000) {
                 uint64_t msgs_per_sec = processed_count * 1000000000ULL / elapsed_ns;
                 if (logger_) {
-                    logger_->log_throughput_measurement(msgs_per_sec, stats_.orders_processed.load());
+                    logger_->log_throughput_measurement(msgs_per_sec, total_processed);
                 }
                 processed_count = 0;
                 last_throughput_log = now;
             }
         } else {
-            std::this_thread::yield();
+            wait_strategy.idle();
         }
     }
     if (logger_) {
@@ -268,6 +568,11 @@ void MatchingEngine::process_order(const order::Order& order) {
     if (logger_) {
         logger_->debug("Processing order " + std::to_string(order.id) + " for symbol " + order.symbol, "ENGINE");
     }
+    const uint32_t symbol_id = symbol_directory_.get_or_assign(order.symbol);
+    if (AuctionBook* auction = find_auction_book(symbol_id)) {
+        accumulate_auction_order(*auction, order, symbol_id);
+        return;
+    }
     std::vector<Fill> fills;
     order::Order active_order = order;
     if (use_segment_tree_) {
@@ -275,9 +580,14 @@ void MatchingEngine::process_order(const order::Order& order) {
         segment_tree_orders_[order.id] = order;
         fills = match_order_segment_tree_price_time(active_order, segment_book);
         segment_tree_orders_[order.id] = active_order;
+        publish_fills(active_order, fills);
         if (active_order.remaining_quantity() > 0 &&
             active_order.status != core::OrderStatus::CANCELLED) {
             segment_book.add_order(active_order.price, active_order.remaining_quantity(), active_order.side);
+            track_segment_tree_level(active_order.symbol, active_order.side, active_order.price,
+                                     static_cast<int64_t>(active_order.remaining_quantity()));
+            publish_book_delta(active_order.symbol, active_order.side, active_order.price,
+                               static_cast<int64_t>(active_order.remaining_quantity()), active_order.id);
         } else {
             segment_tree_orders_.erase(order.id);
         }
@@ -300,24 +610,28 @@ void MatchingEngine::process_order(const order::Order& order) {
                 break;
         }
         active_orders_[order.id] = active_order;
+        publish_fills(active_order, fills);
         if (active_order.remaining_quantity() > 0 &&
             active_order.status != core::OrderStatus::CANCELLED) {
             book.add_order(active_order);
+            publish_book_delta(active_order.symbol, active_order.side, active_order.price,
+                               static_cast<int64_t>(active_order.remaining_quantity()), active_order.id);
         } else {
             active_orders_.erase(active_order.id);
         }
     }
+    publish_top_of_book(order.symbol);
     update_order_status(active_order, fills);
     ExecutionReport execution_report = create_execution_report(active_order, fills);
     const auto end_time = core::HighResolutionClock::rdtsc();
     double latency_ns = static_cast<double>(end_time - start_time) / 2.5;
-    update_matching_latency(latency_ns);
-    stats_.orders_processed.fetch_add(1);
+    ThreadCounters& counters = counters_.local();
+    counters.record_latency(latency_ns);
+    counters.record_order(symbol_id, !fills.empty());
     if (logger_) {
         logger_->log_latency_measurement("order_processing", latency_ns);
     }
     if (!fills.empty()) {
-        stats_.orders_matched.fetch_add(1);
         if (logger_) {
             for (const auto& fill : fills) {
                 logger_->log_order_matched(fill.aggressive_order_id, fill.quantity, fill.price);
@@ -327,9 +641,9 @@ void MatchingEngine::process_order(const order::Order& order) {
     if (execution_callback_) {
         execution_callback_(execution_report);
     }
-    for (const auto& fill : fills) {
-        record_fill(fill);
-        if (fill_callback_) {
+    record_fills(symbol_id, fills);
+    if (fill_callback_) {
+        for (const auto& fill : fills) {
             fill_callback_(fill);
         }
     }
@@ -351,7 +665,11 @@ std::vector<Fill> MatchingEngine::match_order_price_time_priority(const order::O
             auto passive_order_id = ask_orders[0].id;
             auto passive_order_it = active_orders_.find(passive_order_id);
             if (passive_order_it == active_orders_.end()) {
-                book.cancel_order(passive_order_id);
+                const order::Order& stale_order = ask_orders[0];
+                if (book.cancel_order(passive_order_id)) {
+                    publish_book_delta(stale_order.symbol, stale_order.side, stale_order.price,
+                                       -static_cast<int64_t>(stale_order.remaining_quantity()), passive_order_id);
+                }
                 continue;
             }
             order::Order& passive_order = passive_order_it->second;
@@ -383,7 +701,11 @@ std::vector<Fill> MatchingEngine::match_order_price_time_priority(const order::O
             auto passive_order_id = bid_orders[0].id;
             auto passive_order_it = active_orders_.find(passive_order_id);
             if (passive_order_it == active_orders_.end()) {
-                book.cancel_order(passive_order_id);
+                const order::Order& stale_order = bid_orders[0];
+                if (book.cancel_order(passive_order_id)) {
+                    publish_book_delta(stale_order.symbol, stale_order.side, stale_order.price,
+                                       -static_cast<int64_t>(stale_order.remaining_quantity()), passive_order_id);
+                }
                 continue;
             }
             order::Order& passive_order = passive_order_it->second;
@@ -486,6 +808,8 @@ std::vector<Fill> MatchingEngine::match_order_segment_tree_price_time(const orde
                 fills.push_back(fill);
                 mutable_incoming.filled_quantity += available_quantity;
                 segment_book.remove_order(best_ask, available_quantity, core::Side::SELL);
+                track_segment_tree_level(mutable_incoming.symbol, core::Side::SELL, best_ask,
+                                         -static_cast<int64_t>(available_quantity));
                 if (logger_) {
                     logger_->debug(
                         "Segment tree match: " + std::to_string(mutable_incoming.id) +
@@ -524,6 +848,8 @@ std::vector<Fill> MatchingEngine::match_order_segment_tree_price_time(const orde
                 fills.push_back(fill);
                 mutable_incoming.filled_quantity += available_quantity;
                 segment_book.remove_order(best_bid, available_quantity, core::Side::BUY);
+                track_segment_tree_level(mutable_incoming.symbol, core::Side::BUY, best_bid,
+                                         -static_cast<int64_t>(available_quantity));
                 if (logger_) {
                     logger_->debug(
                         "Segment tree match: " + std::to_string(mutable_incoming.id) +
@@ -583,6 +909,139 @@ void MatchingEngine::remove_segment_tree_order(core::OrderID order_id) {
         logger_->debug("Removed order " + std::to_string(order_id) + " from segment tree storage", "ENGINE");
     }
 }
+void MatchingEngine::publish_book_delta(const core::Symbol& symbol, core::Side side, core::Price price,
+                                        int64_t quantity_delta, core::OrderID order_id) {
+    if (!market_data_publisher_) {
+        return;
+    }
+    market_data_publisher_->publish_level_delta(symbol_directory_.get_or_assign(symbol), side, price,
+                                                quantity_delta, order_id, core::HighResolutionClock::now());
+}
+void MatchingEngine::publish_fills(const order::Order& aggressive_order, const std::vector<Fill>& fills) {
+    if (!market_data_publisher_ || fills.empty()) {
+        return;
+    }
+    const uint32_t symbol_id = symbol_directory_.get_or_assign(aggressive_order.symbol);
+    const core::Side passive_side = (aggressive_order.side == core::Side::BUY) ? core::Side::SELL : core::Side::BUY;
+    for (const auto& fill : fills) {
+        market_data_publisher_->publish_trade(symbol_id, aggressive_order.side, fill.price, fill.quantity,
+                                              fill.aggressive_order_id, fill.passive_order_id, fill.timestamp);
+        market_data_publisher_->publish_level_delta(symbol_id, passive_side, fill.price,
+                                                    -static_cast<int64_t>(fill.quantity),
+                                                    fill.passive_order_id, fill.timestamp);
+    }
+}
+void MatchingEngine::publish_top_of_book(const core::Symbol& symbol) {
+    if (!top_of_book_) {
+        return;
+    }
+    const uint32_t symbol_id = symbol_directory_.get_or_assign(symbol);
+    if (symbol_id == SymbolDirectory::INVALID_SYMBOL_ID) {
+        return;
+    }
+    TopOfBook top;
+    if (use_segment_tree_) {
+        auto it = segment_tree_books_.find(symbol);
+        if (it == segment_tree_books_.end()) {
+            return;
+        }
+        const SegmentTreeLevels& levels = segment_tree_levels_[symbol_id];
+        top.bid_price = it->second->get_best_bid();
+        top.ask_price = it->second->get_best_ask();
+        auto bid = levels.bids.find(top.bid_price);
+        auto ask = levels.asks.find(top.ask_price);
+        top.bid_quantity = bid != levels.bids.end() ? bid->second : 0;
+        top.ask_quantity = ask != levels.asks.end() ? ask->second : 0;
+    } else {
+        const order::OrderBook* book = get_order_book(symbol);
+        if (!book) {
+            return;
+        }
+        top.bid_price = book->get_best_bid();
+        top.ask_price = book->get_best_ask();
+        top.bid_quantity = book->get_bid_quantity(top.bid_price);
+        top.ask_quantity = book->get_ask_quantity(top.ask_price);
+    }
+    top.timestamp_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        core::HighResolutionClock::now().time_since_epoch()).count();
+    top_of_book_->update(symbol_id, top);
+}
+void MatchingEngine::track_segment_tree_level(const core::Symbol& symbol, core::Side side, core::Price price,
+                                              int64_t quantity_delta) {
+    if (segment_tree_levels_.empty()) {
+        return;
+    }
+    const uint32_t symbol_id = symbol_directory_.get_or_assign(symbol);
+    if (symbol_id == SymbolDirectory::INVALID_SYMBOL_ID) {
+        return;
+    }
+    auto& levels = (side == core::Side::BUY) ? segment_tree_levels_[symbol_id].bids
+                                             : segment_tree_levels_[symbol_id].asks;
+    auto [it, inserted] = levels.try_emplace(price, 0);
+    const int64_t quantity = static_cast<int64_t>(it->second) + quantity_delta;
+    if (quantity <= 0) {
+        levels.erase(it);
+    } else {
+        it->second = static_cast<core::Quantity>(quantity);
+    }
+}
+AuctionBook* MatchingEngine::find_auction_book(uint32_t symbol_id) const {
+    if (symbol_id >= SymbolDirectory::MAX_SYMBOLS ||
+        trading_phases_[symbol_id].load(std::memory_order_acquire) != TradingPhase::AUCTION) {
+        return nullptr;
+    }
+    return auction_books_[symbol_id].get();
+}
+AuctionBook* MatchingEngine::find_auction_book(const core::Symbol& symbol) const {
+    return find_auction_book(symbol_directory_.find(symbol));
+}
+void MatchingEngine::accumulate_auction_order(AuctionBook& auction, const order::Order& order, uint32_t symbol_id) {
+    if (use_segment_tree_) {
+        segment_tree_orders_[order.id] = order;
+    } else {
+        active_orders_[order.id] = order;
+    }
+    auction.add_order(order);
+    counters_.local().record_order(symbol_id, false);
+    if (execution_callback_) {
+        ExecutionReport report(order);
+        report.execution_id = generate_execution_id();
+        report.timestamp = core::HighResolutionClock::now();
+        execution_callback_(report);
+    }
+}
+void MatchingEngine::move_resting_orders_to_auction(const core::Symbol& symbol, AuctionBook& auction) {
+    const auto& orders = use_segment_tree_ ? segment_tree_orders_ : active_orders_;
+    std::vector<order::Order> resting;
+    for (const auto& pair : orders) {
+        if (pair.second.symbol == symbol && pair.second.remaining_quantity() > 0) {
+            resting.push_back(pair.second);
+        }
+    }
+    if (resting.empty()) {
+        return;
+    }
+    std::sort(resting.begin(), resting.end(), [](const order::Order& a, const order::Order& b) {
+        return a.timestamp < b.timestamp;
+    });
+    auction.reserve(resting.size());
+    for (const auto& order : resting) {
+        if (use_segment_tree_) {
+            auto it = segment_tree_books_.find(symbol);
+            if (it != segment_tree_books_.end()) {
+                it->second->remove_order(order.price, order.remaining_quantity(), order.side);
+                track_segment_tree_level(symbol, order.side, order.price,
+                                         -static_cast<int64_t>(order.remaining_quantity()));
+            }
+        } else if (auto* book = get_order_book(symbol)) {
+            book->cancel_order(order.id);
+        }
+        publish_book_delta(symbol, order.side, order.price,
+                           -static_cast<int64_t>(order.remaining_quantity()), order.id);
+        auction.add_order(order);
+    }
+    publish_top_of_book(symbol);
+}
 void MatchingEngine::update_order_status(order::Order& order, const std::vector<Fill>& fills) {
     if (!fills.empty()) {
         if (order.remaining_quantity() == 0) {
@@ -616,23 +1075,38 @@ bool MatchingEngine::validate_price(core::Price price) const {
 bool MatchingEngine::validate_quantity(core::Quantity quantity) const {
     return quantity > 0 && quantity <= 1000000;
 }
-void MatchingEngine::update_matching_latency(double latency_ns) {
-    uint64_t ops = stats_.matching_operations.fetch_add(1);
-    double current_avg = stats_.avg_matching_latency_ns.load();
-    double new_avg = (current_avg * ops + latency_ns) / (ops + 1);
-    stats_.avg_matching_latency_ns.store(new_avg);
-    double current_max = stats_.max_matching_latency_ns.load();
-    if (latency_ns > current_max) {
-        stats_.max_matching_latency_ns.store(latency_ns);
+void MatchingEngine::record_fills(uint32_t symbol_id, const std::vector<Fill>& fills) {
+    if (fills.empty()) {
+        return;
+    }
+    ThreadCounters& counters = counters_.local();
+    for (const auto& fill : fills) {
+        counters.record_fill(symbol_id, fill.price, fill.quantity);
     }
 }
-void MatchingEngine::record_fill(const Fill& fill) {
-    stats_.total_fills.fetch_add(1);
-    double current_volume = stats_.total_volume.load();
-    while (!stats_.total_volume.compare_exchange_weak(current_volume, current_volume + fill.quantity)) {}
-    double notional_value = fill.price * fill.quantity;
-    double current_notional = stats_.total_notional.load();
-    while (!stats_.total_notional.compare_exchange_weak(current_notional, current_notional + notional_value)) {}
+void MatchingEngine::on_order_enqueued() {
+    const uint64_t enqueued = orders_enqueued_.fetch_add(1, std::memory_order_acq_rel) + 1;
+    const uint64_t dequeued = orders_dequeued_.load(std::memory_order_acquire);
+    const uint64_t depth = enqueued > dequeued ? enqueued - dequeued : 0;
+    ThreadCounters& counters = counters_.local();
+    counters.record_queue_depth(depth);
+    if (core::WaitStrategy::uses_doorbell(wait_config_.type)) {
+        order_doorbell_.ring();
+    }
+    if (backpressure_callback_ && depth >= high_watermark_ &&
+        !backpressure_active_.load(std::memory_order_relaxed) && !backpressure_active_.exchange(true)) {
+        counters.record_backpressure();
+        backpressure_callback_(static_cast<size_t>(depth), true);
+    }
+}
+void MatchingEngine::on_order_dequeued() {
+    orders_dequeued_.store(orders_dequeued_.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    if (backpressure_active_.load(std::memory_order_relaxed)) {
+        const size_t depth = get_queue_depth();
+        if (depth <= low_watermark_ && backpressure_active_.exchange(false) && backpressure_callback_) {
+            backpressure_callback_(depth, false);
+        }
+    }
 }
 bool MatchingEngine::perform_risk_checks(const order::Order& order) const {
     return check_position_limits(order) && check_order_limits(order);
@@ -666,6 +1140,9 @@ MarketMakingEngine::MarketMakingEngine(double spread_bps, core::Quantity default
       max_position_size_(1000000.0), inventory_skew_factor_(0.1)
 {
     matching_engine_ = std::make_unique<MatchingEngine>();
+    matching_engine_->enable_market_data();
+    market_data_subscriber_ = std::make_unique<MarketDataSubscriber>(
+        matching_engine_->get_market_data_publisher()->subscribe());
     matching_engine_->set_execution_callback([this](const ExecutionReport& report) {
         on_trade_execution(report);
     });
@@ -746,6 +1223,21 @@ void MarketMakingEngine::on_trade_execution(const ExecutionReport& execution) {
         update_position(execution.symbol, fill);
     }
 }
+size_t MarketMakingEngine::poll_market_data(size_t max_updates) {
+    if (!market_data_subscriber_) {
+        return 0;
+    }
+    return market_data_subscriber_->poll_batch([this](const MarketDataUpdate& update) {
+        local_books_.apply(update);
+    }, max_updates);
+}
+const MarketDataBookBuilder::LocalBook* MarketMakingEngine::get_local_book(const core::Symbol& symbol) const {
+    const auto* publisher = matching_engine_->get_market_data_publisher();
+    if (!publisher) {
+        return nullptr;
+    }
+    return local_books_.get_book(publisher->symbols().find(symbol));
+}
 std::pair<core::Price, core::Price> MarketMakingEngine::calculate_quote_prices(const core::Symbol& symbol,
                                                                              core::Price reference_price) {
     double spread_fraction = spread_bps_ / 10000.0;
@@ -0,0 +1,120 @@
+#include "hft/matching/matching_stats.hpp"
+#include <algorithm>
+#include <iostream>
+namespace hft {
+namespace matching {
+namespace {
+std::atomic<uint64_t> next_counters_instance_id{1};
+}
+MatchingCounters::MatchingCounters()
+    : instance_id_(next_counters_instance_id.fetch_add(1, std::memory_order_relaxed)),
+      overflow_shard_(std::make_unique<ThreadCounters>(std::thread::id(), reset_generation_, true)) {}
+ThreadCounters& MatchingCounters::register_thread() {
+    const std::thread::id thread_id = std::this_thread::get_id();
+    std::lock_guard<std::mutex> lock(registration_mutex_);
+    const size_t count = shard_count_.load(std::memory_order_relaxed);
+    for (size_t i = 0; i < count; ++i) {
+        if (shards_[i]->owner == thread_id) {
+            return *shards_[i];
+        }
+    }
+    if (count == MAX_THREADS) {
+        if (!overflow_reported_.exchange(true)) {
+            std::cerr << "MatchingCounters: more than " << MAX_THREADS
+                      << " threads recording stats; extra threads share an atomic overflow shard" << std::endl;
+        }
+        return *overflow_shard_;
+    }
+    shards_[count] = std::make_unique<ThreadCounters>(thread_id, reset_generation_);
+    shard_count_.store(count + 1, std::memory_order_release);
+    return *shards_[count];
+}
+MatchingStats MatchingCounters::collect(const SymbolDirectory& symbols) const {
+    MatchingStats stats;
+    const uint32_t symbol_count = symbols.size();
+    stats.symbols.resize(symbol_count);
+    for (uint32_t symbol_id = 0; symbol_id < symbol_count; ++symbol_id) {
+        stats.symbols[symbol_id].symbol = core::Symbol(symbols.name(symbol_id));
+    }
+    double latency_sum_ns = 0.0;
+    const size_t count = shard_count_.load(std::memory_order_acquire);
+    for (size_t i = 0; i < count; ++i) {
+        collect_shard(*shards_[i], stats, latency_sum_ns);
+    }
+    collect_shard(*overflow_shard_, stats, latency_sum_ns);
+    stats.avg_matching_latency_ns = latency_sum_ns;
+    return stats;
+}
+void MatchingCounters::collect_shard(const ThreadCounters& shard, MatchingStats& stats, double& latency_sum_ns) const {
+    for (size_t reason = 0; reason < REJECT_REASON_COUNT; ++reason) {
+        stats.rejects_by_reason[reason] += shard.rejects[reason].load(std::memory_order_relaxed);
+    }
+    stats.backpressure_events += shard.backpressure_events.load(std::memory_order_relaxed);
+    stats.matching_operations += shard.matching_operations.load(std::memory_order_relaxed);
+    latency_sum_ns += shard.latency_sum_ns.load(std::memory_order_relaxed);
+    if (shard.applied_generation.load(std::memory_order_acquire) == reset_generation_.load(std::memory_order_acquire)) {
+        stats.peak_queue_depth = std::max(stats.peak_queue_depth, shard.peak_queue_depth.load(std::memory_order_relaxed));
+        stats.max_matching_latency_ns = std::max(stats.max_matching_latency_ns,
+                                                 shard.max_latency_ns.load(std::memory_order_relaxed));
+    }
+    for (uint32_t symbol_id = 0; symbol_id < stats.symbols.size(); ++symbol_id) {
+        const SymbolCounters& counters = shard.symbols[symbol_id];
+        SymbolStats& symbol_stats = stats.symbols[symbol_id];
+        symbol_stats.orders_processed += counters.orders_processed.load(std::memory_order_relaxed);
+        symbol_stats.orders_matched += counters.orders_matched.load(std::memory_order_relaxed);
+        symbol_stats.fills += counters.fills.load(std::memory_order_relaxed);
+        symbol_stats.volume += counters.volume.load(std::memory_order_relaxed);
+        symbol_stats.notional += counters.notional.load(std::memory_order_relaxed);
+    }
+}
+MatchingStats MatchingCounters::snapshot(const SymbolDirectory& symbols) const {
+    MatchingStats stats = collect(symbols);
+    {
+        std::lock_guard<std::mutex> lock(baseline_mutex_);
+        for (size_t reason = 0; reason < REJECT_REASON_COUNT; ++reason) {
+            stats.rejects_by_reason[reason] -= baseline_.rejects_by_reason[reason];
+        }
+        stats.backpressure_events -= baseline_.backpressure_events;
+        stats.matching_operations -= baseline_.matching_operations;
+        stats.avg_matching_latency_ns -= baseline_.avg_matching_latency_ns;
+        for (size_t symbol_id = 0; symbol_id < baseline_.symbols.size() && symbol_id < stats.symbols.size(); ++symbol_id) {
+            const SymbolStats& base = baseline_.symbols[symbol_id];
+            SymbolStats& symbol_stats = stats.symbols[symbol_id];
+            symbol_stats.orders_processed -= base.orders_processed;
+            symbol_stats.orders_matched -= base.orders_matched;
+            symbol_stats.fills -= base.fills;
+            symbol_stats.volume -= base.volume;
+            symbol_stats.notional -= base.notional;
+        }
+    }
+    stats.avg_matching_latency_ns = stats.matching_operations > 0
+        ? stats.avg_matching_latency_ns / static_cast<double>(stats.matching_operations) : 0.0;
+    stats.queue_full_events = stats.rejects_by_reason[static_cast<size_t>(RejectReason::QUEUE_FULL)];
+    for (uint64_t rejects : stats.rejects_by_reason) {
+        stats.orders_rejected += rejects;
+    }
+    for (const auto& symbol_stats : stats.symbols) {
+        stats.orders_processed += symbol_stats.orders_processed;
+        stats.orders_matched += symbol_stats.orders_matched;
+        stats.total_fills += symbol_stats.fills;
+        stats.total_volume += static_cast<double>(symbol_stats.volume);
+        stats.total_notional += symbol_stats.notional;
+    }
+    stats.symbols.erase(std::remove_if(stats.symbols.begin(), stats.symbols.end(), [](const SymbolStats& s) {
+        return s.orders_processed == 0 && s.fills == 0;
+    }), stats.symbols.end());
+    return stats;
+}
+void MatchingCounters::reset(const SymbolDirectory& symbols) {
+    MatchingStats current = collect(symbols);
+    {
+        std::lock_guard<std::mutex> lock(baseline_mutex_);
+        baseline_ = std::move(current);
+    }
+    const uint64_t generation = reset_generation_.fetch_add(1, std::memory_order_acq_rel) + 1;
+    overflow_shard_->peak_queue_depth.store(0, std::memory_order_relaxed);
+    overflow_shard_->max_latency_ns.store(0.0, std::memory_order_relaxed);
+    overflow_shard_->applied_generation.store(generation, std::memory_order_release);
+}
+}
+}
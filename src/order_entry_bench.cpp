@@ -0,0 +1,388 @@
+#include "hft/order/order.hpp"
+#include "hft/matching/matching_engine.hpp"
+#include "hft/fix/fix_dictionary.hpp"
+#include "hft/fix/fix_encoder.hpp"
+#include "hft/fix/fix_message_view.hpp"
+#include "hft/fix/fix_scanner.hpp"
+#include "hft/binary/binary_order_entry.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+class OrderEntryBenchmark {
+private:
+    struct FlowEntry {
+        hft::binary::BinaryTemplateId type;
+        uint64_t cl_ord_id;
+        uint64_t orig_cl_ord_id;
+        const char* symbol;
+        char side;
+        uint64_t order_qty;
+        double price;
+    };
+    struct DecodeResult {
+        std::string name;
+        double seconds;
+        uint64_t bytes;
+        uint64_t messages;
+        uint64_t sink;
+    };
+    struct MatchResult {
+        std::string name;
+        uint64_t submitted;
+        uint64_t rejected;
+        std::vector<uint32_t> latencies_ns;
+    };
+    static constexpr size_t REPLACE_INTERVAL = 8;
+    static constexpr size_t CANCEL_INTERVAL = 16;
+    static constexpr uint64_t RESPONSE_TIMEOUT_NS = 1000000000ull;
+    std::vector<FlowEntry> flow_;
+    std::string fix_stream_;
+    std::string binary_stream_;
+    size_t iterations_;
+public:
+    OrderEntryBenchmark(size_t order_count, size_t iterations) : iterations_(iterations) {
+        build_flow(order_count);
+        encode_streams();
+    }
+    bool run() {
+        std::cout << "ORDER ENTRY PROTOCOL BENCHMARK" << std::endl;
+        std::cout << "==============================" << std::endl;
+        std::cout << "Flow:       " << flow_.size() << " messages (new, replace, cancel)" << std::endl;
+        std::cout << "FIX:        " << fix_stream_.size() << " bytes" << std::endl;
+        std::cout << "Binary:     " << binary_stream_.size() << " bytes (schema " << hft::binary::BINARY_SCHEMA_ID
+                  << " v" << hft::binary::BINARY_SCHEMA_VERSION << ")" << std::endl;
+        std::cout << "Iterations: " << iterations_ << std::endl;
+        const DecodeResult fix_decode = run_fix_decode();
+        const DecodeResult binary_decode = run_binary_decode();
+        std::cout << "\nDecode (frame + typed decode)" << std::endl;
+        print_decode_result(fix_decode);
+        print_decode_result(binary_decode);
+        if (fix_decode.seconds > 0.0 && binary_decode.seconds > 0.0) {
+            std::cout << "  speedup: " << std::fixed << std::setprecision(2)
+                      << (binary_decode.messages / binary_decode.seconds) / (fix_decode.messages / fix_decode.seconds)
+                      << "x" << std::endl;
+        }
+        const MatchResult fix_match = run_match(false);
+        const MatchResult binary_match = run_match(true);
+        std::cout << "\nDecode + match (new orders, one in flight, wire bytes to execution report)" << std::endl;
+        print_match_result(fix_match);
+        print_match_result(binary_match);
+        const bool consistent = fix_decode.messages == binary_decode.messages && fix_decode.sink == binary_decode.sink &&
+                                fix_match.submitted == binary_match.submitted &&
+                                fix_match.latencies_ns.size() == binary_match.latencies_ns.size();
+        if (!consistent) {
+            std::cout << "\nWARNING: FIX and binary decoders disagree on the flow" << std::endl;
+        }
+        return consistent;
+    }
+private:
+    void build_flow(size_t order_count) {
+        static const char* symbols[] = {"AAPL", "MSFT", "GOOGL", "AMZN", "TSLA", "NVDA", "META", "JPM"};
+        uint64_t next_id = 1;
+        flow_.reserve(order_count + order_count / REPLACE_INTERVAL + order_count / CANCEL_INTERVAL);
+        for (size_t i = 0; i < order_count; ++i) {
+            const char side = i % 2 ? '2' : '1';
+            const double offset = static_cast<double>(i % 7) * 0.01;
+            const double price = 100.0 + (side == '1' ? offset : -offset);
+            const uint64_t id = next_id++;
+            flow_.push_back({hft::binary::BinaryTemplateId::NEW_ORDER, id, 0, symbols[i % 8], side,
+                             100 + i % 400, price});
+            if ((i + 1) % REPLACE_INTERVAL == 0) {
+                flow_.push_back({hft::binary::BinaryTemplateId::REPLACE, next_id++, id, symbols[i % 8], side,
+                                 200 + i % 400, price + (side == '1' ? -0.05 : 0.05)});
+            }
+            if ((i + 1) % CANCEL_INTERVAL == 0) {
+                flow_.push_back({hft::binary::BinaryTemplateId::CANCEL, next_id++, id, symbols[i % 8], side,
+                                 0, 0.0});
+            }
+        }
+    }
+    void encode_streams() {
+        hft::fix::FixMessageEncoder encoder("CLIENT01", "HFTENGINE");
+        char buffer[hft::binary::BINARY_MAX_MESSAGE_SIZE];
+        uint32_t seq_num = 1;
+        for (const FlowEntry& entry : flow_) {
+            std::string_view wire;
+            size_t length = 0;
+            switch (entry.type) {
+                case hft::binary::BinaryTemplateId::NEW_ORDER: {
+                    hft::fix::NewOrderSingle order{};
+                    order.cl_ord_id = entry.cl_ord_id;
+                    order.symbol = entry.symbol;
+                    order.side = entry.side;
+                    order.order_qty = entry.order_qty;
+                    order.ord_type = '2';
+                    order.price = entry.price;
+                    order.time_in_force = '0';
+                    wire = encoder.encode(order, seq_num++, 0);
+                    hft::binary::BinaryNewOrder binary{};
+                    binary.cl_ord_id = entry.cl_ord_id;
+                    binary.price = hft::binary::to_binary_price(entry.price);
+                    binary.order_qty = entry.order_qty;
+                    hft::binary::set_binary_symbol(binary.symbol, entry.symbol);
+                    binary.side = entry.side;
+                    binary.ord_type = '2';
+                    binary.time_in_force = '0';
+                    length = hft::binary::encode_binary_message(binary, buffer, sizeof(buffer));
+                    break;
+                }
+                case hft::binary::BinaryTemplateId::REPLACE: {
+                    hft::fix::OrderCancelReplaceRequest replace{};
+                    replace.orig_cl_ord_id = entry.orig_cl_ord_id;
+                    replace.cl_ord_id = entry.cl_ord_id;
+                    replace.symbol = entry.symbol;
+                    replace.side = entry.side;
+                    replace.order_qty = entry.order_qty;
+                    replace.ord_type = '2';
+                    replace.price = entry.price;
+                    wire = encoder.encode(replace, seq_num++, 0);
+                    hft::binary::BinaryReplace binary{};
+                    binary.orig_cl_ord_id = entry.orig_cl_ord_id;
+                    binary.cl_ord_id = entry.cl_ord_id;
+                    binary.price = hft::binary::to_binary_price(entry.price);
+                    binary.order_qty = entry.order_qty;
+                    hft::binary::set_binary_symbol(binary.symbol, entry.symbol);
+                    binary.side = entry.side;
+                    binary.ord_type = '2';
+                    length = hft::binary::encode_binary_message(binary, buffer, sizeof(buffer));
+                    break;
+                }
+                default: {
+                    hft::fix::OrderCancelRequest cancel{};
+                    cancel.orig_cl_ord_id = entry.orig_cl_ord_id;
+                    cancel.cl_ord_id = entry.cl_ord_id;
+                    cancel.symbol = entry.symbol;
+                    cancel.side = entry.side;
+                    wire = encoder.encode(cancel, seq_num++, 0);
+                    hft::binary::BinaryCancel binary{};
+                    binary.orig_cl_ord_id = entry.orig_cl_ord_id;
+                    binary.cl_ord_id = entry.cl_ord_id;
+                    hft::binary::set_binary_symbol(binary.symbol, entry.symbol);
+                    binary.side = entry.side;
+                    length = hft::binary::encode_binary_message(binary, buffer, sizeof(buffer));
+                    break;
+                }
+            }
+            fix_stream_.append(wire.data(), wire.size());
+            binary_stream_.append(buffer, length);
+        }
+    }
+    static uint64_t mix(uint64_t sink, uint64_t id, uint64_t quantity, double price) {
+        return sink * 31 + id + quantity * 7 + static_cast<uint64_t>(std::llround(price * 100.0));
+    }
+    static uint64_t steady_ns() {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+    static uint64_t decode_fix(const hft::fix::FixMessageView& view, uint64_t sink) {
+        switch (hft::fix::classify_msg_type(view.msg_type())) {
+            case hft::fix::FixMsgType::NEW_ORDER_SINGLE: {
+                hft::fix::NewOrderSingle order;
+                if (hft::fix::decode_fix_message(view, order).ok()) {
+                    sink = mix(sink, order.cl_ord_id, order.order_qty, order.price) + order.symbol.size();
+                }
+                break;
+            }
+            case hft::fix::FixMsgType::ORDER_CANCEL_REPLACE_REQUEST: {
+                hft::fix::OrderCancelReplaceRequest replace;
+                if (hft::fix::decode_fix_message(view, replace).ok()) {
+                    sink = mix(sink, replace.orig_cl_ord_id, replace.order_qty, replace.price) + replace.symbol.size();
+                }
+                break;
+            }
+            case hft::fix::FixMsgType::ORDER_CANCEL_REQUEST: {
+                hft::fix::OrderCancelRequest cancel;
+                if (hft::fix::decode_fix_message(view, cancel).ok()) {
+                    sink = mix(sink, cancel.orig_cl_ord_id, 0, 0.0) + cancel.symbol.size();
+                }
+                break;
+            }
+            default:
+                break;
+        }
+        return sink;
+    }
+    class BinaryDecodeSink final : public hft::binary::BinaryOrderHandler {
+    public:
+        uint64_t sink = 0;
+        void on_new_order(hft::binary::BinarySessionId, const hft::binary::BinaryNewOrder& order) override {
+            sink = mix(sink, order.cl_ord_id, order.order_qty, hft::binary::from_binary_price(order.price)) +
+                   hft::binary::binary_symbol(order.symbol).size();
+        }
+        void on_cancel(hft::binary::BinarySessionId, const hft::binary::BinaryCancel& cancel) override {
+            sink = mix(sink, cancel.orig_cl_ord_id, 0, 0.0) + hft::binary::binary_symbol(cancel.symbol).size();
+        }
+        void on_replace(hft::binary::BinarySessionId, const hft::binary::BinaryReplace& replace) override {
+            sink = mix(sink, replace.orig_cl_ord_id, replace.order_qty, hft::binary::from_binary_price(replace.price)) +
+                   hft::binary::binary_symbol(replace.symbol).size();
+        }
+    };
+    class BinaryOrderBuilder final : public hft::binary::BinaryOrderHandler {
+    public:
+        uint64_t order_id = 0;
+        hft::order::Order order;
+        void on_new_order(hft::binary::BinarySessionId, const hft::binary::BinaryNewOrder& fields) override {
+            order_id = fields.cl_ord_id;
+            order = hft::order::Order(fields.cl_ord_id, hft::core::Symbol(hft::binary::binary_symbol(fields.symbol)),
+                                      fields.side == '1' ? hft::core::Side::BUY : hft::core::Side::SELL,
+                                      hft::core::OrderType::LIMIT, hft::binary::from_binary_price(fields.price),
+                                      fields.order_qty);
+        }
+        void on_cancel(hft::binary::BinarySessionId, const hft::binary::BinaryCancel&) override {}
+        void on_replace(hft::binary::BinarySessionId, const hft::binary::BinaryReplace&) override {}
+    };
+    DecodeResult run_fix_decode() const {
+        hft::fix::FixMessageView view;
+        uint64_t sink = 0;
+        uint64_t messages = 0;
+        const auto start = std::chrono::steady_clock::now();
+        for (size_t iteration = 0; iteration < iterations_; ++iteration) {
+            size_t position = 0;
+            while (position < fix_stream_.size()) {
+                const hft::fix::FixFrame frame = hft::fix::frame_fix_message(fix_stream_.data() + position,
+                                                                             fix_stream_.size() - position);
+                if (frame.status != hft::fix::FixFrameStatus::COMPLETE) {
+                    break;
+                }
+                if (view.parse(fix_stream_.data() + position + frame.start, frame.length)) {
+                    sink = decode_fix(view, sink);
+                    ++messages;
+                }
+                position += frame.start + frame.length;
+            }
+        }
+        const auto end = std::chrono::steady_clock::now();
+        return DecodeResult{"FIX tag=value", std::chrono::duration<double>(end - start).count(),
+                            fix_stream_.size() * iterations_, messages, sink};
+    }
+    DecodeResult run_binary_decode() const {
+        BinaryDecodeSink decoder;
+        uint64_t messages = 0;
+        const auto start = std::chrono::steady_clock::now();
+        for (size_t iteration = 0; iteration < iterations_; ++iteration) {
+            messages += hft::binary::dispatch_binary_messages(0, binary_stream_.data(), binary_stream_.size(),
+                                                              decoder).messages;
+        }
+        const auto end = std::chrono::steady_clock::now();
+        return DecodeResult{"binary (SBE-style)", std::chrono::duration<double>(end - start).count(),
+                            binary_stream_.size() * iterations_, messages, decoder.sink};
+    }
+    MatchResult run_match(bool binary) const {
+        MatchResult result{binary ? "binary (SBE-style)" : "FIX tag=value", 0, 0, {}};
+        const std::string log_path = (std::filesystem::temp_directory_path() / "order_entry_bench.log").string();
+        hft::matching::MatchingEngine engine(hft::matching::MatchingAlgorithm::PRICE_TIME_PRIORITY, log_path);
+        std::atomic<uint64_t> awaited_id{0};
+        std::atomic<uint64_t> responded_id{0};
+        engine.set_execution_callback([&](const hft::matching::ExecutionReport& report) {
+            if (report.order_id == awaited_id.load(std::memory_order_acquire)) {
+                responded_id.store(report.order_id, std::memory_order_release);
+            }
+        });
+        engine.start();
+        const std::string& stream = binary ? binary_stream_ : fix_stream_;
+        hft::fix::FixMessageView view;
+        BinaryOrderBuilder builder;
+        result.latencies_ns.reserve(flow_.size());
+        size_t position = 0;
+        while (position < stream.size()) {
+            const uint64_t start = steady_ns();
+            uint64_t order_id = 0;
+            hft::order::Order order;
+            size_t consumed = 0;
+            if (binary) {
+                builder.order_id = 0;
+                const hft::binary::BinaryFrame frame = hft::binary::dispatch_binary_message(
+                    0, stream.data() + position, stream.size() - position, builder);
+                if (frame.status != hft::binary::BinaryFrameStatus::COMPLETE) {
+                    break;
+                }
+                consumed = frame.length;
+                order_id = builder.order_id;
+                order = builder.order;
+            } else {
+                const hft::fix::FixFrame frame = hft::fix::frame_fix_message(stream.data() + position,
+                                                                             stream.size() - position);
+                if (frame.status != hft::fix::FixFrameStatus::COMPLETE) {
+                    break;
+                }
+                consumed = frame.start + frame.length;
+                hft::fix::NewOrderSingle fields;
+                if (view.parse(stream.data() + position + frame.start, frame.length) &&
+                    hft::fix::decode_fix_message(view, fields).ok()) {
+                    order_id = fields.cl_ord_id;
+                    order = hft::order::Order(fields.cl_ord_id, hft::core::Symbol(fields.symbol),
+                                              fields.side == '1' ? hft::core::Side::BUY : hft::core::Side::SELL,
+                                              hft::core::OrderType::LIMIT, fields.price, fields.order_qty);
+                }
+            }
+            position += consumed;
+            if (order_id == 0) {
+                continue;
+            }
+            awaited_id.store(order_id, std::memory_order_release);
+            if (!engine.submit_order(order)) {
+                ++result.rejected;
+                continue;
+            }
+            ++result.submitted;
+            while (responded_id.load(std::memory_order_acquire) != order_id && steady_ns() - start < RESPONSE_TIMEOUT_NS) {
+                std::this_thread::yield();
+            }
+            if (responded_id.load(std::memory_order_acquire) == order_id) {
+                result.latencies_ns.push_back(static_cast<uint32_t>(std::min<uint64_t>(steady_ns() - start, UINT32_MAX)));
+            }
+        }
+        engine.stop();
+        engine.set_execution_callback(nullptr);
+        std::filesystem::remove(log_path);
+        std::sort(result.latencies_ns.begin(), result.latencies_ns.end());
+        return result;
+    }
+    static void print_decode_result(const DecodeResult& result) {
+        const double ns_per_message = result.messages ? result.seconds * 1e9 / result.messages : 0.0;
+        std::cout << "  " << std::left << std::setw(22) << result.name << std::right << std::fixed
+                  << std::setprecision(1) << std::setw(9) << ns_per_message << " ns/msg  " << std::setprecision(1)
+                  << std::setw(6) << (result.messages ? static_cast<double>(result.bytes) / result.messages : 0.0)
+                  << " bytes/msg" << std::endl;
+    }
+    static uint32_t percentile(const std::vector<uint32_t>& sorted, double quantile) {
+        if (sorted.empty()) {
+            return 0;
+        }
+        return sorted[std::min(sorted.size() - 1, static_cast<size_t>(sorted.size() * quantile))];
+    }
+    static void print_match_result(const MatchResult& result) {
+        std::cout << "  " << std::left << std::setw(22) << result.name << std::right << std::fixed
+                  << std::setprecision(2) << "  p50 " << std::setw(8) << percentile(result.latencies_ns, 0.50) / 1000.0
+                  << " us  p99 " << std::setw(8) << percentile(result.latencies_ns, 0.99) / 1000.0
+                  << " us  p99.9 " << std::setw(8) << percentile(result.latencies_ns, 0.999) / 1000.0 << " us  ("
+                  << result.latencies_ns.size() << " of " << result.submitted << " answered";
+        if (result.rejected != 0) {
+            std::cout << ", " << result.rejected << " rejected";
+        }
+        std::cout << ")" << std::endl;
+    }
+};
+int main(int argc, char* argv[]) {
+    try {
+        const size_t order_count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 100000;
+        const size_t iterations = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 20;
+        if (order_count == 0 || iterations == 0) {
+            std::cout << "Usage: " << argv[0] << " [orders] [decode_iterations]" << std::endl;
+            return 1;
+        }
+        OrderEntryBenchmark benchmark(order_count, iterations);
+        return benchmark.run() ? 0 : 1;
+    } catch (const std::exception& e) {
+        std::cout << "❌ Error: " << e.what() << std::endl;
+        return 1;
+    }
+}
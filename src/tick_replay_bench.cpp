@@ -0,0 +1,363 @@
+#include "hft/backtesting/tick_replay.hpp"
+#include "hft/backtesting/columnar_tick_store.hpp"
+#include "hft/backtesting/merged_market_data.hpp"
+#include "hft/core/numeric.hpp"
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+class TickReplayBenchmark {
+private:
+    struct ScanResult {
+        std::string name;
+        double seconds;
+        uint64_t ticks;
+        uint64_t timestamp_sum;
+        double notional;
+        uint64_t last_sequence;
+        bool in_order;
+    };
+    static constexpr uint64_t BASE_TIMESTAMP_NS = 1705329000000000000ull;
+    size_t tick_count_;
+    size_t symbol_count_;
+    size_t iterations_;
+    std::filesystem::path directory_;
+    std::string csv_file_;
+    std::string binary_file_;
+    std::string columnar_file_;
+    std::string per_symbol_binary_dir_;
+    std::string per_symbol_columnar_dir_;
+    uint64_t window_start_ns_;
+    uint64_t window_end_ns_;
+public:
+    TickReplayBenchmark(size_t tick_count, size_t symbol_count, size_t iterations)
+        : tick_count_(tick_count), symbol_count_(symbol_count), iterations_(iterations),
+          directory_(std::filesystem::temp_directory_path() / "hft_tick_replay_bench"),
+          window_start_ns_(0), window_end_ns_(0) {
+        std::filesystem::create_directories(directory_);
+        csv_file_ = (directory_ / "ticks.csv").string();
+        binary_file_ = (directory_ / "ticks.bin").string();
+        columnar_file_ = (directory_ / "ticks.tcol").string();
+        per_symbol_binary_dir_ = (directory_ / "per_symbol_bin").string();
+        per_symbol_columnar_dir_ = (directory_ / "per_symbol_tcol").string();
+    }
+    ~TickReplayBenchmark() {
+        std::error_code ignored;
+        std::filesystem::remove_all(directory_, ignored);
+    }
+    bool run() {
+        std::cout << "TICK REPLAY STORAGE BENCHMARK" << std::endl;
+        std::cout << "=============================" << std::endl;
+        write_csv();
+        if (!hft::backtesting::BinaryMarketDataParser::convert_csv_to_binary(csv_file_, binary_file_)) {
+            std::cerr << "Failed to convert " << csv_file_ << " to binary" << std::endl;
+            return false;
+        }
+        hft::backtesting::CSVMarketDataParser csv_parser;
+        if (!csv_parser.open(csv_file_) ||
+            !hft::backtesting::ColumnarMarketDataParser::convert(csv_parser, columnar_file_)) {
+            std::cerr << "Failed to convert " << csv_file_ << " to columnar" << std::endl;
+            return false;
+        }
+        if (!write_per_symbol_files()) {
+            std::cerr << "Failed to split " << columnar_file_ << " into per-symbol files" << std::endl;
+            return false;
+        }
+        std::cout << "Ticks:      " << tick_count_ << " across " << symbol_count_ << " symbols" << std::endl;
+        std::cout << "CSV:        " << std::filesystem::file_size(csv_file_) << " bytes" << std::endl;
+        std::cout << "Binary:     " << std::filesystem::file_size(binary_file_) << " bytes" << std::endl;
+        std::cout << "Columnar:   " << std::filesystem::file_size(columnar_file_) << " bytes" << std::endl;
+        std::cout << std::endl;
+        ScanResult legacy_csv = best_of([this] { return drain_legacy_csv(); });
+        ScanResult csv_scan = best_of([this] {
+            hft::backtesting::CSVMarketDataParser parser;
+            return drain(parser, csv_file_, "mmap CSV");
+        });
+        ScanResult binary_scan = best_of([this] {
+            hft::backtesting::BinaryMarketDataParser parser;
+            return drain(parser, binary_file_, "ifstream binary");
+        });
+        ScanResult columnar_scan = best_of([this] {
+            hft::backtesting::ColumnarMarketDataParser parser;
+            return drain(parser, columnar_file_, "mmap columnar");
+        });
+        ScanResult column_scan = best_of([this] { return scan_columns(); });
+        hft::backtesting::MergedReplayStats merged_stats;
+        ScanResult merged_binary = best_of([this, &merged_stats] {
+            hft::backtesting::MergedMarketDataParser parser;
+            ScanResult result = drain(parser, per_symbol_binary_dir_, "merged per-symbol binary");
+            merged_stats.replay_waits = parser.get_stats().replay_waits.load();
+            merged_stats.blocks_loaded = parser.get_stats().blocks_loaded.load();
+            return result;
+        });
+        ScanResult merged_columnar = best_of([this] {
+            hft::backtesting::MergedMarketDataParser parser;
+            return drain(parser, per_symbol_columnar_dir_, "merged per-symbol columnar");
+        });
+        ScanResult filter_window = best_of([this] { return filter_window_scan(); });
+        ScanResult seek_window = best_of([this] { return seek_window_scan(); });
+        std::cout << "CSV ingestion:" << std::endl;
+        print(legacy_csv, legacy_csv);
+        print(csv_scan, legacy_csv);
+        std::cout << std::endl;
+        std::cout << "Full replay (HistoricalTick per row):" << std::endl;
+        print(binary_scan, binary_scan);
+        print(columnar_scan, binary_scan);
+        print(column_scan, binary_scan);
+        std::cout << std::endl;
+        std::cout << "Merged replay (" << symbol_count_ << " files, 4-ary heap, background read-ahead):" << std::endl;
+        print(binary_scan, binary_scan);
+        print(merged_binary, binary_scan);
+        print(merged_columnar, binary_scan);
+        std::cout << "  replay waits " << merged_stats.replay_waits.load() << " of "
+                  << merged_stats.blocks_loaded.load() << " blocks" << std::endl;
+        std::cout << std::endl;
+        std::cout << "Window replay (middle 1% of the session):" << std::endl;
+        print(filter_window, filter_window);
+        print(seek_window, filter_window);
+        const bool full_ok = same(legacy_csv, csv_scan) && same(legacy_csv, binary_scan) &&
+                             same(binary_scan, columnar_scan) && same(binary_scan, column_scan) &&
+                             same(binary_scan, merged_binary) && same(binary_scan, merged_columnar);
+        const bool window_ok = same(filter_window, seek_window) && seek_window.ticks > 0;
+        if (!full_ok || !window_ok) {
+            std::cout << "WARNING: replay results diverge between storage formats" << std::endl;
+        }
+        return full_ok && window_ok;
+    }
+private:
+    void write_csv() {
+        std::ofstream file(csv_file_);
+        std::mt19937_64 rng(42);
+        std::uniform_int_distribution<int> step(-2, 2);
+        std::uniform_int_distribution<uint64_t> gap(1, 2000);
+        std::uniform_int_distribution<uint64_t> size(1, 50);
+        std::vector<double> mids(symbol_count_);
+        for (size_t i = 0; i < symbol_count_; ++i) {
+            mids[i] = 50.0 + 10.0 * static_cast<double>(i);
+        }
+        file << "timestamp,symbol,bid_price,ask_price,last_price,bid_size,ask_size,last_size\n";
+        file << std::fixed << std::setprecision(2);
+        uint64_t timestamp_ns = BASE_TIMESTAMP_NS;
+        for (size_t i = 0; i < tick_count_; ++i) {
+            const size_t symbol = rng() % symbol_count_;
+            mids[symbol] = std::max(1.0, mids[symbol] + 0.01 * step(rng));
+            const double bid = mids[symbol] - 0.01;
+            const double ask = mids[symbol] + 0.01;
+            const uint64_t last_size = rng() % 4 == 0 ? size(rng) : 0;
+            timestamp_ns += gap(rng);
+            file << timestamp_ns << ",SYM" << symbol << ',' << bid << ',' << ask << ','
+                 << (rng() % 2 ? ask : bid) << ',' << size(rng) * 100 << ',' << size(rng) * 100 << ','
+                 << last_size << '\n';
+        }
+        const uint64_t session_ns = timestamp_ns - BASE_TIMESTAMP_NS;
+        window_start_ns_ = BASE_TIMESTAMP_NS + session_ns / 2;
+        window_end_ns_ = window_start_ns_ + session_ns / 100;
+    }
+    bool write_per_symbol_files() {
+        hft::backtesting::ColumnarTickReader reader;
+        if (!reader.open(columnar_file_)) {
+            return false;
+        }
+        const std::vector<std::string>& symbols = reader.symbols();
+        std::vector<std::vector<hft::backtesting::ColumnarTickRow>> rows(symbols.size());
+        for (size_t b = 0; b < reader.block_count(); ++b) {
+            const hft::backtesting::ColumnarTickBlock block = reader.block(b);
+            for (size_t i = 0; i < block.count; ++i) {
+                rows[block.symbol_id[i]].push_back(hft::backtesting::ColumnarTickRow{
+                    block.timestamp_ns[i], block.bid_price[i], block.ask_price[i], block.last_price[i],
+                    block.bid_size[i], block.ask_size[i], block.last_size[i], block.sequence_number[i], 0});
+            }
+        }
+        std::filesystem::create_directories(per_symbol_binary_dir_);
+        std::filesystem::create_directories(per_symbol_columnar_dir_);
+        for (size_t s = 0; s < symbols.size(); ++s) {
+            const std::string name = symbols[s];
+            hft::backtesting::ColumnarTickWriter writer;
+            uint16_t symbol_id = 0;
+            if (!writer.open((std::filesystem::path(per_symbol_columnar_dir_) / (name + ".tcol")).string(), 1024) ||
+                !writer.intern_symbol(name, symbol_id)) {
+                return false;
+            }
+            hft::backtesting::BinaryMarketDataParser::BinaryHeader header;
+            header.record_count = rows[s].size();
+            header.start_time_ns = rows[s].empty() ? 0 : rows[s].front().timestamp_ns;
+            header.end_time_ns = rows[s].empty() ? 0 : rows[s].back().timestamp_ns;
+            std::memset(header.symbol, 0, sizeof(header.symbol));
+            std::memcpy(header.symbol, name.data(), std::min(name.size(), sizeof(header.symbol) - 1));
+            header.record_size = sizeof(hft::backtesting::BinaryMarketDataParser::BinaryTick);
+            std::ofstream file(std::filesystem::path(per_symbol_binary_dir_) / (name + ".bin"), std::ios::binary);
+            file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            for (const auto& row : rows[s]) {
+                const hft::backtesting::BinaryMarketDataParser::BinaryTick tick{
+                    row.timestamp_ns, row.bid_price, row.ask_price, row.last_price,
+                    row.bid_size, row.ask_size, row.last_size, row.sequence_number};
+                file.write(reinterpret_cast<const char*>(&tick), sizeof(tick));
+                if (!writer.append(hft::backtesting::ColumnarTickRow{row.timestamp_ns, row.bid_price, row.ask_price,
+                                                                     row.last_price, row.bid_size, row.ask_size,
+                                                                     row.last_size, row.sequence_number, symbol_id})) {
+                    return false;
+                }
+            }
+            if (!writer.close() || !file.good()) {
+                return false;
+            }
+        }
+        return true;
+    }
+    template<typename Scan>
+    ScanResult best_of(Scan scan) {
+        ScanResult best = scan();
+        for (size_t i = 1; i < iterations_; ++i) {
+            ScanResult result = scan();
+            if (result.seconds < best.seconds) {
+                best = result;
+            }
+        }
+        return best;
+    }
+    static void accumulate(ScanResult& result, const hft::backtesting::HistoricalTick& tick) {
+        result.in_order = result.in_order && tick.sequence_number > result.last_sequence;
+        result.last_sequence = tick.sequence_number;
+        ++result.ticks;
+        result.timestamp_sum += static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            tick.timestamp.time_since_epoch()).count());
+        result.notional += tick.last_price * static_cast<double>(tick.last_size);
+    }
+    ScanResult drain(hft::backtesting::MarketDataParser& parser, const std::string& file, const char* name) {
+        ScanResult result{name, 0.0, 0, 0, 0.0, 0, true};
+        const auto start = std::chrono::steady_clock::now();
+        if (parser.open(file)) {
+            hft::backtesting::HistoricalTick tick;
+            while (parser.read_next_tick(tick)) {
+                accumulate(result, tick);
+            }
+            parser.close();
+        }
+        result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        return result;
+    }
+    ScanResult drain_legacy_csv() {
+        ScanResult result{"getline + stringstream", 0.0, 0, 0, 0.0, 0, true};
+        const auto start = std::chrono::steady_clock::now();
+        std::ifstream file(csv_file_);
+        std::string line;
+        std::getline(file, line);
+        uint64_t line_number = 1;
+        while (std::getline(file, line)) {
+            std::vector<std::string> fields;
+            std::stringstream ss(line);
+            std::string field;
+            while (std::getline(ss, field, ',')) {
+                field.erase(field.find_last_not_of(" \t\r\n") + 1);
+                field.erase(0, field.find_first_not_of(" \t\r\n"));
+                fields.push_back(field);
+            }
+            if (fields.size() < 8) {
+                break;
+            }
+            hft::backtesting::HistoricalTick tick;
+            uint64_t timestamp_ns = 0;
+            hft::core::parse_uint(fields[0].data(), fields[0].size(), timestamp_ns);
+            tick.timestamp = hft::core::TimePoint(std::chrono::nanoseconds(timestamp_ns));
+            tick.symbol = fields[1];
+            tick.sequence_number = ++line_number;
+            hft::core::parse_price(fields[2].data(), fields[2].size(), tick.bid_price);
+            hft::core::parse_price(fields[3].data(), fields[3].size(), tick.ask_price);
+            hft::core::parse_price(fields[4].data(), fields[4].size(), tick.last_price);
+            hft::core::parse_uint(fields[5].data(), fields[5].size(), tick.bid_size);
+            hft::core::parse_uint(fields[6].data(), fields[6].size(), tick.ask_size);
+            hft::core::parse_uint(fields[7].data(), fields[7].size(), tick.last_size);
+            accumulate(result, tick);
+        }
+        result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        return result;
+    }
+    ScanResult scan_columns() {
+        ScanResult result{"mmap column scan", 0.0, 0, 0, 0.0, 0, true};
+        const auto start = std::chrono::steady_clock::now();
+        hft::backtesting::ColumnarTickReader reader;
+        if (reader.open(columnar_file_)) {
+            for (size_t b = 0; b < reader.block_count(); ++b) {
+                reader.prefetch_block(b + 1);
+                const hft::backtesting::ColumnarTickBlock block = reader.block(b);
+                for (size_t i = 0; i < block.count; ++i) {
+                    result.timestamp_sum += block.timestamp_ns[i];
+                    result.notional += block.last_price[i] * static_cast<double>(block.last_size[i]);
+                }
+                result.ticks += block.count;
+            }
+        }
+        result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        return result;
+    }
+    bool in_window(const hft::backtesting::HistoricalTick& tick) const {
+        const uint64_t timestamp_ns = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            tick.timestamp.time_since_epoch()).count());
+        return timestamp_ns >= window_start_ns_ && timestamp_ns <= window_end_ns_;
+    }
+    ScanResult filter_window_scan() {
+        ScanResult result{"ifstream binary filter", 0.0, 0, 0, 0.0, 0, true};
+        const auto start = std::chrono::steady_clock::now();
+        hft::backtesting::BinaryMarketDataParser parser;
+        if (parser.open(binary_file_)) {
+            hft::backtesting::HistoricalTick tick;
+            while (parser.read_next_tick(tick)) {
+                if (in_window(tick)) {
+                    accumulate(result, tick);
+                }
+            }
+        }
+        result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        return result;
+    }
+    ScanResult seek_window_scan() {
+        ScanResult result{"mmap columnar seek", 0.0, 0, 0, 0.0, 0, true};
+        const auto start = std::chrono::steady_clock::now();
+        hft::backtesting::ColumnarMarketDataParser parser;
+        if (parser.open(columnar_file_) &&
+            parser.seek(hft::core::TimePoint(std::chrono::nanoseconds(window_start_ns_)))) {
+            hft::backtesting::HistoricalTick tick;
+            while (parser.read_next_tick(tick) && in_window(tick)) {
+                accumulate(result, tick);
+            }
+        }
+        result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        return result;
+    }
+    static bool same(const ScanResult& a, const ScanResult& b) {
+        return a.in_order && b.in_order && a.ticks == b.ticks && a.timestamp_sum == b.timestamp_sum &&
+               std::abs(a.notional - b.notional) <= 1e-9 * std::max(1.0, std::abs(a.notional));
+    }
+    static void print(const ScanResult& result, const ScanResult& baseline) {
+        const double ticks_per_second = result.seconds > 0.0 ? result.ticks / result.seconds : 0.0;
+        std::cout << "  " << std::left << std::setw(26) << result.name << std::right << std::fixed
+                  << std::setprecision(2) << std::setw(9) << ticks_per_second / 1e6 << " M ticks/s  "
+                  << std::setw(9) << result.seconds * 1e3 << " ms  " << std::setw(6)
+                  << baseline.seconds / std::max(result.seconds, 1e-12) << "x  (" << result.ticks << " ticks)"
+                  << std::endl;
+    }
+};
+int main(int argc, char* argv[]) {
+    try {
+        const size_t tick_count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 2000000;
+        const size_t symbol_count = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 32;
+        const size_t iterations = argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 3;
+        if (tick_count == 0 || symbol_count == 0 || iterations == 0) {
+            std::cout << "Usage: " << argv[0] << " [ticks] [symbols] [iterations]" << std::endl;
+            return 1;
+        }
+        TickReplayBenchmark benchmark(tick_count, symbol_count, iterations);
+        return benchmark.run() ? 0 : 1;
+    } catch (const std::exception& e) {
+        std::cout << "❌ Error: " << e.what() << std::endl;
+        return 1;
+    }
+}